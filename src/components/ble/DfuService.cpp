@@ -385,17 +385,17 @@ void DfuService::DfuImage::Append(uint8_t* data, size_t size) {
   std::memcpy(tempBuffer + bufferWriteIndex, data, size);
   bufferWriteIndex += size;
 
-  if (bufferWriteIndex == bufferSize) {
+  if (bufferWriteIndex == bufferSize || totalWriteIndex + bufferWriteIndex == totalSize) {
     spiNorFlash.Write(writeOffset + totalWriteIndex, tempBuffer, bufferWriteIndex);
     totalWriteIndex += bufferWriteIndex;
     bufferWriteIndex = 0;
-  }
 
-  if (bufferWriteIndex > 0 && totalWriteIndex + bufferWriteIndex == totalSize) {
-    spiNorFlash.Write(writeOffset + totalWriteIndex, tempBuffer, bufferWriteIndex);
-    totalWriteIndex += bufferWriteIndex;
-    if (totalSize < maxSize)
-      WriteMagicNumber();
+    // Also when the size is a multiple of bufferSize: the last page would otherwise stay in the write buffer
+    if (totalWriteIndex == totalSize) {
+      if (totalSize < maxSize)
+        WriteMagicNumber();
+      spiNorFlash.Flush();
+    }
   }
 }
 
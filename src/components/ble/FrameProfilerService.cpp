@@ -0,0 +1,77 @@
+#include "components/ble/FrameProfilerService.h"
+#include "components/profiler/FrameProfiler.h"
+
+using namespace Pinetime::Controllers;
+
+namespace {
+  // 0006yyxx-78fc-48fe-8e23-433b3a1942d0
+  constexpr ble_uuid128_t CharUuid(uint8_t x, uint8_t y) {
+    return ble_uuid128_t {.u = {.type = BLE_UUID_TYPE_128},
+                          .value = {0xd0, 0x42, 0x19, 0x3a, 0x3b, 0x43, 0x23, 0x8e, 0xfe, 0x48, 0xfc, 0x78, x, y, 0x06, 0x00}};
+  }
+
+  // 00060000-78fc-48fe-8e23-433b3a1942d0
+  constexpr ble_uuid128_t BaseUuid() {
+    return CharUuid(0x00, 0x00);
+  }
+
+  constexpr ble_uuid128_t frameProfilerServiceUuid {BaseUuid()};
+  constexpr ble_uuid128_t reportCharUuid {CharUuid(0x01, 0x00)};
+  constexpr ble_uuid128_t overlayCharUuid {CharUuid(0x02, 0x00)};
+
+  int FrameProfilerServiceCallback(uint16_t /*conn_handle*/, uint16_t attr_handle, struct ble_gatt_access_ctxt* ctxt, void* arg) {
+    auto* frameProfilerService = static_cast<FrameProfilerService*>(arg);
+    return frameProfilerService->OnCommand(attr_handle, ctxt);
+  }
+}
+
+FrameProfilerService::FrameProfilerService(FrameProfiler& frameProfiler)
+  : frameProfiler {frameProfiler},
+    characteristicDefinition {{.uuid = &reportCharUuid.u,
+                               .access_cb = FrameProfilerServiceCallback,
+                               .arg = this,
+                               .flags = BLE_GATT_CHR_F_READ,
+                               .val_handle = &reportHandle},
+                              {.uuid = &overlayCharUuid.u,
+                               .access_cb = FrameProfilerServiceCallback,
+                               .arg = this,
+                               .flags = BLE_GATT_CHR_F_READ | BLE_GATT_CHR_F_WRITE,
+                               .val_handle = &overlayHandle},
+                              {0}},
+    serviceDefinition {
+      {.type = BLE_GATT_SVC_TYPE_PRIMARY, .uuid = &frameProfilerServiceUuid.u, .characteristics = characteristicDefinition},
+      {0},
+    } {
+}
+
+void FrameProfilerService::Init() {
+  int res = 0;
+  res = ble_gatts_count_cfg(serviceDefinition);
+  ASSERT(res == 0);
+
+  res = ble_gatts_add_svcs(serviceDefinition);
+  ASSERT(res == 0);
+}
+
+int FrameProfilerService::OnCommand(uint16_t attributeHandle, ble_gatt_access_ctxt* context) {
+  if (attributeHandle == reportHandle && context->op == BLE_GATT_ACCESS_OP_READ_CHR) {
+    const FrameProfiler::Report report = frameProfiler.GetReport();
+    int res = os_mbuf_append(context->om, &report, sizeof(report));
+    return (res == 0) ? 0 : BLE_ATT_ERR_INSUFFICIENT_RES;
+  }
+  if (attributeHandle == overlayHandle) {
+    if (context->op == BLE_GATT_ACCESS_OP_WRITE_CHR) {
+      if (OS_MBUF_PKTLEN(context->om) != 1) {
+        return BLE_ATT_ERR_INVALID_ATTR_VALUE_LEN;
+      }
+      uint8_t enabled = 0;
+      os_mbuf_copydata(context->om, 0, 1, &enabled);
+      frameProfiler.SetOverlayEnabled(enabled != 0);
+      return 0;
+    }
+    uint8_t enabled = frameProfiler.IsOverlayEnabled() ? 1 : 0;
+    int res = os_mbuf_append(context->om, &enabled, sizeof(enabled));
+    return (res == 0) ? 0 : BLE_ATT_ERR_INSUFFICIENT_RES;
+  }
+  return 0;
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstdint>
+#define min // workaround: nimble's min/max macros conflict with libstdc++
+#define max
+#include <host/ble_gap.h>
+#include <host/ble_uuid.h>
+#undef max
+#undef min
+
+namespace Pinetime {
+  namespace Controllers {
+    class FrameProfiler;
+
+    class FrameProfilerService {
+    public:
+      explicit FrameProfilerService(FrameProfiler& frameProfiler);
+      void Init();
+
+      int OnCommand(uint16_t attributeHandle, ble_gatt_access_ctxt* context);
+
+    private:
+      FrameProfiler& frameProfiler;
+
+      struct ble_gatt_chr_def characteristicDefinition[3];
+      struct ble_gatt_svc_def serviceDefinition[2];
+
+      uint16_t reportHandle;
+      uint16_t overlayHandle;
+    };
+  }
+}
@@ -7,6 +7,7 @@ using namespace Pinetime::Controllers;
 
 constexpr ble_uuid16_t HeartRateService::heartRateServiceUuid;
 constexpr ble_uuid16_t HeartRateService::heartRateMeasurementUuid;
+constexpr ble_uuid128_t HeartRateService::sensorTraceUuid;
 
 namespace {
   int HeartRateServiceCallback(uint16_t /*conn_handle*/, uint16_t attr_handle, struct ble_gatt_access_ctxt* ctxt, void* arg) {
@@ -24,6 +25,11 @@ HeartRateService::HeartRateService(NimbleController& nimble, Controllers::HeartR
                                .arg = this,
                                .flags = BLE_GATT_CHR_F_READ | BLE_GATT_CHR_F_NOTIFY,
                                .val_handle = &heartRateMeasurementHandle},
+                              {.uuid = &sensorTraceUuid.u,
+                               .access_cb = HeartRateServiceCallback,
+                               .arg = this,
+                               .flags = BLE_GATT_CHR_F_NOTIFY,
+                               .val_handle = &sensorTraceHandle},
                               {0}},
     serviceDefinition {
       {/* Device Information Service */
@@ -72,12 +78,53 @@ void HeartRateService::OnNewHeartRateValue(uint8_t heartRateValue) {
   ble_gattc_notify_custom(connectionHandle, heartRateMeasurementHandle, om);
 }
 
+void HeartRateService::OnNewSensorSample(uint16_t index, uint16_t hrs, uint16_t als, uint16_t acceleration) {
+  if (!sensorTraceNotificationEnable) {
+    nbTraceSamples = 0;
+    return;
+  }
+
+  // A new measurement started: the samples of the previous one are dropped, the host sees the index go back
+  if (nbTraceSamples > 0 && index != nextTraceIndex) {
+    nbTraceSamples = 0;
+  }
+  if (nbTraceSamples == 0) {
+    sensorTrace[0] = index & 0xff;
+    sensorTrace[1] = index >> 8;
+  }
+  uint8_t* sample = &sensorTrace[2 + (nbTraceSamples * bytesPerSample)];
+  sample[0] = hrs & 0xff;
+  sample[1] = hrs >> 8;
+  sample[2] = als & 0xff;
+  sample[3] = als >> 8;
+  sample[4] = acceleration & 0xff;
+  sample[5] = acceleration >> 8;
+  nextTraceIndex = index + 1;
+  if (++nbTraceSamples < samplesPerTrace) {
+    return;
+  }
+  nbTraceSamples = 0;
+
+  uint16_t connectionHandle = nimble.connHandle();
+
+  if (connectionHandle == 0 || connectionHandle == BLE_HS_CONN_HANDLE_NONE) {
+    return;
+  }
+
+  auto* om = ble_hs_mbuf_from_flat(sensorTrace, sizeof(sensorTrace));
+  ble_gattc_notify_custom(connectionHandle, sensorTraceHandle, om);
+}
+
 void HeartRateService::SubscribeNotification(uint16_t attributeHandle) {
   if (attributeHandle == heartRateMeasurementHandle)
     heartRateMeasurementNotificationEnable = true;
+  else if (attributeHandle == sensorTraceHandle)
+    sensorTraceNotificationEnable = true;
 }
 
 void HeartRateService::UnsubscribeNotification(uint16_t attributeHandle) {
   if (attributeHandle == heartRateMeasurementHandle)
     heartRateMeasurementNotificationEnable = false;
+  else if (attributeHandle == sensorTraceHandle)
+    sensorTraceNotificationEnable = false;
 }
@@ -5,6 +5,7 @@
 #undef max
 #undef min
 #include <atomic>
+#include <cstdint>
 
 namespace Pinetime {
   namespace Controllers {
@@ -17,6 +18,7 @@ namespace Pinetime {
       void Init();
       int OnHeartRateRequested(uint16_t attributeHandle, ble_gatt_access_ctxt* context);
       void OnNewHeartRateValue(uint8_t hearRateValue);
+      void OnNewSensorSample(uint16_t index, uint16_t hrs, uint16_t als, uint16_t acceleration);
 
       void SubscribeNotification(uint16_t attributeHandle);
       void UnsubscribeNotification(uint16_t attributeHandle);
@@ -31,11 +33,27 @@ namespace Pinetime {
 
       static constexpr ble_uuid16_t heartRateMeasurementUuid {.u {.type = BLE_UUID_TYPE_16}, .value = heartRateMeasurementId};
 
-      struct ble_gatt_chr_def characteristicDefinition[2];
+      // 00070001-78fc-48fe-8e23-433b3a1942d0
+      static constexpr ble_uuid128_t sensorTraceUuid {
+        .u {.type = BLE_UUID_TYPE_128},
+        .value = {0xd0, 0x42, 0x19, 0x3a, 0x3b, 0x43, 0x23, 0x8e, 0xfe, 0x48, 0xfc, 0x78, 0x01, 0x00, 0x07, 0x00}};
+
+      // Raw samples are sent in batches that fit in the default ATT MTU (20 bytes of payload): index of the first sample
+      // (uint16), then hrs, als and acceleration magnitude (uint16) of each sample
+      static constexpr uint8_t samplesPerTrace = 3;
+      static constexpr uint8_t bytesPerSample = 6;
+
+      struct ble_gatt_chr_def characteristicDefinition[3];
       struct ble_gatt_svc_def serviceDefinition[2];
 
       uint16_t heartRateMeasurementHandle;
       std::atomic_bool heartRateMeasurementNotificationEnable {false};
+
+      uint16_t sensorTraceHandle;
+      std::atomic_bool sensorTraceNotificationEnable {false};
+      uint8_t sensorTrace[2 + (samplesPerTrace * bytesPerSample)];
+      uint8_t nbTraceSamples = 0;
+      uint16_t nextTraceIndex = 0;
     };
   }
 }
@@ -21,6 +21,7 @@
 #include "components/ble/NavigationService.h"
 #include "components/ble/ServiceDiscovery.h"
 #include "components/ble/MotionService.h"
+#include "components/ble/FrameProfilerService.h"
 #include "components/ble/SimpleWeatherService.h"
 #include "components/fs/FS.h"
 
@@ -37,6 +38,7 @@ namespace Pinetime {
     class Ble;
     class DateTime;
     class NotificationManager;
+    class FrameProfiler;
 
     class NimbleController {
 
@@ -49,7 +51,8 @@ namespace Pinetime {
                        Pinetime::Drivers::SpiNorFlash& spiNorFlash,
                        HeartRateController& heartRateController,
                        MotionController& motionController,
-                       FS& fs);
+                       FS& fs,
+                       FrameProfiler& frameProfiler);
       void Init();
       void StartAdvertising();
       int OnGAPEvent(ble_gap_event* event);
@@ -106,6 +109,7 @@ namespace Pinetime {
       HeartRateService heartRateService;
       MotionService motionService;
       FSService fsService;
+      FrameProfilerService frameProfilerService;
       ServiceDiscovery serviceDiscovery;
 
       uint8_t addrType;
@@ -1,7 +1,6 @@
 #include "components/fs/FS.h"
 #include <cstring>
 #include <littlefs/lfs.h>
-#include <lvgl/lvgl.h>
 
 using namespace Pinetime::Controllers;
 
@@ -14,18 +13,26 @@ FS::FS(Pinetime::Drivers::SpiNorFlash& driver)
       .erase = SectorErase,
       .sync = SectorSync,
 
-      .read_size = 16,
-      .prog_size = 8,
+      .read_size = readSize,
+      .prog_size = progSize,
       .block_size = blockSize,
       .block_count = size / blockSize,
       .block_cycles = 1000u,
 
-      .cache_size = 16,
-      .lookahead_size = 16,
+      .cache_size = cacheSize,
+      .lookahead_size = lookaheadSize,
+
+      .read_buffer = readBuffer.data(),
+      .prog_buffer = progBuffer.data(),
+      .lookahead_buffer = lookaheadBuffer.data(),
 
       .name_max = 50,
       .attr_max = 50,
     } {
+  for (auto& arenaFile : arenaFiles) {
+    arenaFile.config = {};
+    arenaFile.config.buffer = arenaFile.cache.data();
+  }
 }
 
 void FS::Init() {
@@ -54,11 +61,31 @@ void FS::VerifyResource() {
 }
 
 int FS::FileOpen(lfs_file_t* file_p, const char* fileName, const int flags) {
+  if ((flags & LFS_O_WRONLY) != 0) {
+    modificationCount++;
+  }
+  // Use a cache from the static arena if one is available, fall back on the heap otherwise
+  for (auto& arenaFile : arenaFiles) {
+    if (arenaFile.owner == nullptr) {
+      int res = lfs_file_opencfg(&lfs, file_p, fileName, flags, &arenaFile.config);
+      if (res == LFS_ERR_OK) {
+        arenaFile.owner = file_p;
+      }
+      return res;
+    }
+  }
   return lfs_file_open(&lfs, file_p, fileName, flags);
 }
 
 int FS::FileClose(lfs_file_t* file_p) {
-  return lfs_file_close(&lfs, file_p);
+  int res = lfs_file_close(&lfs, file_p);
+  for (auto& arenaFile : arenaFiles) {
+    if (arenaFile.owner == file_p) {
+      arenaFile.owner = nullptr;
+      break;
+    }
+  }
+  return res;
 }
 
 int FS::FileRead(lfs_file_t* file_p, uint8_t* buff, uint32_t size) {
@@ -66,6 +93,7 @@ int FS::FileRead(lfs_file_t* file_p, uint8_t* buff, uint32_t size) {
 }
 
 int FS::FileWrite(lfs_file_t* file_p, const uint8_t* buff, uint32_t size) {
+  modificationCount++;
   return lfs_file_write(&lfs, file_p, buff, size);
 }
 
@@ -73,7 +101,12 @@ int FS::FileSeek(lfs_file_t* file_p, uint32_t pos) {
   return lfs_file_seek(&lfs, file_p, pos, LFS_SEEK_SET);
 }
 
+int FS::FileSize(lfs_file_t* file_p) {
+  return lfs_file_size(&lfs, file_p);
+}
+
 int FS::FileDelete(const char* fileName) {
+  modificationCount++;
   return lfs_remove(&lfs, fileName);
 }
 
@@ -94,10 +127,12 @@ int FS::DirRewind(lfs_dir_t* dir) {
 }
 
 int FS::DirCreate(const char* path) {
+  modificationCount++;
   return lfs_mkdir(&lfs, path);
 }
 
 int FS::Rename(const char* oldPath, const char* newPath) {
+  modificationCount++;
   return lfs_rename(&lfs, oldPath, newPath);
 }
 
@@ -114,8 +149,10 @@ lfs_ssize_t FS::GetFSSize() {
     ----------- Interface between littlefs and SpiNorFlash -----------
 
 */
-int FS::SectorSync(const struct lfs_config* /*c*/) {
-  return 0;
+int FS::SectorSync(const struct lfs_config* c) {
+  Pinetime::Controllers::FS& lfs = *(static_cast<Pinetime::Controllers::FS*>(c->context));
+  lfs.flashDriver.Flush();
+  return lfs.flashDriver.ProgramFailed() ? -1 : 0;
 }
 
 int FS::SectorErase(const struct lfs_config* c, lfs_block_t block) {
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <array>
 #include <cstdint>
 #include "drivers/SpiNorFlash.h"
 #include <littlefs/lfs.h>
@@ -17,6 +18,7 @@ namespace Pinetime {
       int FileRead(lfs_file_t* file_p, uint8_t* buff, uint32_t size);
       int FileWrite(lfs_file_t* file_p, const uint8_t* buff, uint32_t size);
       int FileSeek(lfs_file_t* file_p, uint32_t pos);
+      int FileSize(lfs_file_t* file_p);
 
       int FileDelete(const char* fileName);
 
@@ -31,6 +33,11 @@ namespace Pinetime {
       int Stat(const char* path, lfs_info* info);
       void VerifyResource();
 
+      // Incremented whenever a file or directory may have been created, written, renamed or deleted
+      uint32_t GetModificationCount() const {
+        return modificationCount;
+      }
+
       static size_t getSize() {
         return size;
       }
@@ -39,6 +46,11 @@ namespace Pinetime {
         return blockSize;
       }
 
+      // Files that may stay open while the watch runs: the open entries of the F: drive (FileCache), and either the
+      // static layer of the analog face (StaticLayer) or the font file of a face using LazyFont that the F: drive
+      // doesn't keep open itself (the third font of the Casio face). Their file caches are always taken from the arena.
+      static constexpr size_t longLivedFiles = 3;
+
     private:
       Pinetime::Drivers::SpiNorFlash& flashDriver;
 
@@ -68,7 +80,53 @@ namespace Pinetime {
       static constexpr size_t size = 0x34C000;
       static constexpr size_t blockSize = 4096;
 
+      /*
+       * Cache profiles (selected with the FS_PROFILE CMake option).
+       * Read and program sizes match the flash geometry and must not change, otherwise existing
+       * file systems may not mount. Cache and lookahead sizes only cost RAM:
+       *  - MINIMAL     : 16 B caches, legacy behaviour (default)
+       *  - BALANCED    : 256 B caches, one page per flash read/program
+       *  - PERFORMANCE : 512 B caches, larger lookahead for faster block allocation
+       * The cache and lookahead buffers, as well as the caches of the first maxArenaFiles open files,
+       * are statically allocated, so opening a file does not touch the heap. An arena file costs
+       * 16 B (owner and lfs_file_config) plus its cache, so the static RAM of each profile is:
+       *  - MINIMAL     :   48 B + 5 x  32 B =  208 B
+       *  - BALANCED    :  576 B + 5 x 272 B = 1936 B
+       *  - PERFORMANCE : 1152 B + 5 x 528 B = 3792 B
+       */
+      static constexpr size_t readSize = 16;
+      static constexpr size_t progSize = 8;
+#if defined(FS_PROFILE_BALANCED)
+      static constexpr size_t cacheSize = 256;
+      static constexpr size_t lookaheadSize = 64;
+#elif defined(FS_PROFILE_PERFORMANCE)
+      static constexpr size_t cacheSize = 512;
+      static constexpr size_t lookaheadSize = 128;
+#else
+      static constexpr size_t cacheSize = 16;
+      static constexpr size_t lookaheadSize = 16;
+#endif
+      // Files opened and closed right away (settings, alarm, bonds, BLE transfers, files of the F: drive that are
+      // not cached). More of them at the same time take their cache from the heap.
+      static constexpr size_t transientFiles = 2;
+      static constexpr size_t maxArenaFiles = longLivedFiles + transientFiles;
+      static_assert(cacheSize % readSize == 0 && cacheSize % progSize == 0 && blockSize % cacheSize == 0,
+                    "cache size must be a multiple of read/prog size and a factor of the block size");
+      static_assert(lookaheadSize % 8 == 0, "lookahead size must be a multiple of 8");
+
+      struct ArenaFile {
+        lfs_file_t* owner = nullptr;
+        lfs_file_config config;
+        alignas(4) std::array<uint8_t, cacheSize> cache;
+      };
+
+      alignas(4) std::array<uint8_t, cacheSize> readBuffer;
+      alignas(4) std::array<uint8_t, cacheSize> progBuffer;
+      alignas(4) std::array<uint8_t, lookaheadSize> lookaheadBuffer;
+      std::array<ArenaFile, maxArenaFiles> arenaFiles;
+
       bool resourcesValid = false;
+      uint32_t modificationCount = 0;
       const struct lfs_config lfsConfig;
 
       lfs_t lfs;
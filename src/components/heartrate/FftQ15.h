@@ -0,0 +1,112 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdlib>
+#include <cstdint>
+#include <numbers>
+#include <utility>
+#include "utility/Trigonometry.h"
+
+namespace Pinetime {
+  namespace Controllers {
+    namespace Detail {
+      // sin(2 * pi * i / N + phase) in Q15, for the first half of the circle
+      template <size_t N>
+      constexpr std::array<int16_t, N / 2> MakeTwiddleTableQ15(double phase) {
+        std::array<int16_t, N / 2> table {};
+        for (size_t i = 0; i < table.size(); i++) {
+          const double value = Utility::SineRadians((2 * std::numbers::pi * static_cast<double>(i) / N) + phase) * Utility::Q15One;
+          table[i] = static_cast<int16_t>((value < 0) ? value - 0.5 : value + 0.5);
+        }
+        return table;
+      }
+    }
+
+    /* In place radix 2 FFT of N complex values in Q15, after arm_cfft_q15() of CMSIS-DSP. A stage can double the
+     * values: instead of halving them at every stage, they are only halved when they could overflow, which keeps
+     * the precision of small signals. The magnitude of the complex values must not exceed 1.
+     */
+    template <size_t N>
+    class FftQ15 {
+    public:
+      static_assert(N >= 2 && (N & (N - 1)) == 0, "N must be a power of 2");
+
+      // Returns the number of stages that halved the values: the result is the DFT divided by 2^scale
+      static int Compute(int16_t* real, int16_t* imag) {
+        // Bit reversed order
+        for (size_t i = 1, j = 0; i < N; i++) {
+          size_t bit = N >> 1;
+          for (; (j & bit) != 0; bit >>= 1) {
+            j ^= bit;
+          }
+          j ^= bit;
+          if (i < j) {
+            std::swap(real[i], real[j]);
+            std::swap(imag[i], imag[j]);
+          }
+        }
+
+        int scale = 0;
+        for (size_t length = 2; length <= N; length <<= 1) {
+          int32_t largest = 0;
+          for (size_t i = 0; i < N; i++) {
+            largest = std::max({largest, std::abs(real[i]), std::abs(imag[i])});
+          }
+          // Below this, the magnitudes are less than 1/2 and can be doubled
+          const bool halve = largest >= (1 << 13);
+          scale += halve ? 1 : 0;
+
+          const size_t half = length / 2;
+          const size_t step = N / length;
+          for (size_t start = 0; start < N; start += length) {
+            for (size_t k = 0; k < half; k++) {
+              const int32_t cos = cosTable[k * step];
+              const int32_t sin = sinTable[k * step];
+              const size_t a = start + k;
+              const size_t b = a + half;
+              // b * exp(-2i * pi * k / length), shifts are rounded
+              const int32_t productReal = ((real[b] * cos) + (imag[b] * sin) + (1 << 14)) >> 15;
+              const int32_t productImag = ((imag[b] * cos) - (real[b] * sin) + (1 << 14)) >> 15;
+              const int32_t aReal = real[a];
+              const int32_t aImag = imag[a];
+              real[a] = Scale(aReal + productReal, halve);
+              imag[a] = Scale(aImag + productImag, halve);
+              real[b] = Scale(aReal - productReal, halve);
+              imag[b] = Scale(aImag - productImag, halve);
+            }
+          }
+        }
+        return scale;
+      }
+
+      // |real + i * imag|, rounded down
+      static uint16_t Magnitude(int16_t real, int16_t imag) {
+        uint32_t value = static_cast<uint32_t>((real * real) + (imag * imag));
+        uint32_t root = 0;
+        for (uint32_t bit = 1U << 30; bit != 0; bit >>= 2) {
+          if (value >= root + bit) {
+            value -= root + bit;
+            root = (root >> 1) + bit;
+          } else {
+            root >>= 1;
+          }
+        }
+        return static_cast<uint16_t>(root);
+      }
+
+    private:
+      // value / 2 if halve, rounded half to even: always rounding halves up would offset the DC bin
+      static int16_t Scale(int32_t value, bool halve) {
+        if (!halve) {
+          return static_cast<int16_t>(value);
+        }
+        return static_cast<int16_t>((value >> 1) + (value & (value >> 1) & 1));
+      }
+
+      static constexpr std::array<int16_t, N / 2> cosTable = Detail::MakeTwiddleTableQ15<N>(std::numbers::pi / 2);
+      static constexpr std::array<int16_t, N / 2> sinTable = Detail::MakeTwiddleTableQ15<N>(0);
+    };
+  }
+}
@@ -12,6 +12,10 @@ void HeartRateController::Update(HeartRateController::States newState, uint8_t h
   }
 }
 
+void HeartRateController::UpdateSample(uint16_t index, uint16_t hrs, uint16_t als, uint16_t acceleration) {
+  service->OnNewSensorSample(index, hrs, als, acceleration);
+}
+
 void HeartRateController::Enable() {
   if (task != nullptr) {
     state = States::NotEnoughData;
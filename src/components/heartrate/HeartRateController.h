@@ -21,6 +21,9 @@ namespace Pinetime {
       void Enable();
       void Disable();
       void Update(States newState, uint8_t heartRate);
+      // Raw sensor values and magnitude of the acceleration (1g = 1024), index is the number of the sample since the start
+      // of the measurement
+      void UpdateSample(uint16_t index, uint16_t hrs, uint16_t als, uint16_t acceleration);
 
       void SetHeartRateTask(Applications::HeartRateTask* task);
 
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <numbers>
+#include "utility/Trigonometry.h"
+
+namespace Pinetime {
+  namespace Controllers {
+    namespace Detail {
+      // 2 * cos(2 * pi * k / N)
+      template <size_t N>
+      constexpr std::array<float, N / 2> MakeGoertzelCoefficients() {
+        std::array<float, N / 2> table {};
+        for (size_t k = 0; k < table.size(); k++) {
+          const double angle = (2 * std::numbers::pi * static_cast<double>(k) / N) + (std::numbers::pi / 2);
+          table[k] = static_cast<float>(2 * Utility::SineRadians(angle));
+        }
+        return table;
+      }
+    }
+
+    /* Magnitude of the acceleration during the last N samples of the PPG signal. Moving the arm moves the blood
+     * under the sensor: when walking or running, the spectrum of the PPG signal has peaks at the frequency of the
+     * movements that can be stronger than the heart rate. They are found in the spectrum of the acceleration.
+     */
+    template <size_t N>
+    class MotionReference {
+    public:
+      void Reset() {
+        history.fill(0);
+        index = 0;
+        count = 0;
+      }
+
+      void Push(uint16_t acceleration) {
+        history[index] = acceleration;
+        index = (index + 1) % N;
+        if (count < N) {
+          count++;
+        }
+      }
+
+      // Bin in [start, end) where the variations of the acceleration are the strongest, or 0 if their amplitude
+      // is below minAmplitude or if less than N samples were pushed. amplitude is set to the amplitude of the
+      // variations in that bin.
+      size_t DominantBin(size_t start, size_t end, float minAmplitude, float& amplitude) const {
+        amplitude = 0.0f;
+        if (count < N) {
+          return 0;
+        }
+        float mean = 0.0f;
+        for (uint16_t value : history) {
+          mean += static_cast<float>(value);
+        }
+        mean /= N;
+
+        size_t dominant = 0;
+        float largest = 0.0f;
+        for (size_t k = start; k < end && k < N / 2; k++) {
+          // Goertzel algorithm: the magnitude doesn't depend on where the circular buffer starts
+          const float coefficient = coefficients[k];
+          float previous = 0.0f;
+          float beforePrevious = 0.0f;
+          for (uint16_t value : history) {
+            const float current = (static_cast<float>(value) - mean) + (coefficient * previous) - beforePrevious;
+            beforePrevious = previous;
+            previous = current;
+          }
+          const float power = (previous * previous) + (beforePrevious * beforePrevious) - (coefficient * previous * beforePrevious);
+          if (power > largest) {
+            largest = power;
+            dominant = k;
+          }
+        }
+        // A sinusoid of amplitude A gives a bin of magnitude A * N / 2
+        amplitude = 2.0f * std::sqrt(largest) / N;
+        if (amplitude < minAmplitude) {
+          return 0;
+        }
+        return dominant;
+      }
+
+    private:
+      static constexpr std::array<float, N / 2> coefficients = Detail::MakeGoertzelCoefficients<N>();
+
+      std::array<uint16_t, N> history {};
+      size_t index = 0;
+      size_t count = 0;
+    };
+  }
+}
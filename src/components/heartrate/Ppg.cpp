@@ -1,69 +1,91 @@
 #include "components/heartrate/Ppg.h"
 #include <nrf_log.h>
+#include <algorithm>
+#include <cmath>
+#include <numbers>
 #include <vector>
+#include "utility/Trigonometry.h"
+#if defined(PPG_ENGINE_FIXED_POINT)
+  #include <bit>
+  #include <cstdlib>
+  #include "utility/Math.h"
+#endif
 
 using namespace Pinetime::Controllers;
 
 namespace {
-  float LinearInterpolation(const float* xValues, const float* yValues, int length, float pointX) {
-    if (pointX > xValues[length - 1]) {
-      return yValues[length - 1];
-    } else if (pointX <= xValues[0]) {
-      return yValues[0];
-    }
-    int index = 0;
-    while (pointX > xValues[index] && index < length - 1) {
-      index++;
-    }
-    float pointX0 = xValues[index - 1];
-    float pointX1 = xValues[index];
-    float pointY0 = yValues[index - 1];
-    float pointY1 = yValues[index];
-    float mu = (pointX - pointX0) / (pointX1 - pointX0);
+  // Position between bins index and index + 1 where the linear interpolation of the spectrum crosses threshold
+  float ThresholdCrossing(int index, float current, float next, float threshold) {
+    return static_cast<float>(index) + ((threshold - current) / (next - current));
+  }
 
-    return (pointY0 * (1 - mu) + pointY1 * mu);
+  // Position of the vertex of the parabola going through the bin and its neighbours
+  template <typename T>
+  float ParabolicPeak(const T* values, int index) {
+    float previous = static_cast<float>(values[index - 1]);
+    float current = static_cast<float>(values[index]);
+    float next = static_cast<float>(values[index + 1]);
+    float curvature = previous - (2.0f * current) + next;
+    if (curvature >= 0.0f) {
+      return static_cast<float>(index);
+    }
+    float offset = 0.5f * (previous - next) / curvature;
+    return static_cast<float>(index) + std::clamp(offset, -0.5f, 0.5f);
   }
 
-  float PeakSearch(float* xVals, float* yVals, float threshold, float& width, float start, float end, int length) {
+  // Location (bins) of the only peak of values above threshold between start and end, or 0 if there are none or several.
+  // Peaks already above threshold at start or still above it at end are ignored. width is the distance between the
+  // threshold crossings of the peak.
+  // A second, weaker peak at twice the frequency of the first one is its harmonic: slow pulses have a strong one,
+  // which the filters amplify above threshold. The first peak is returned then.
+  template <typename T>
+  float PeakSearch(const T* values, float threshold, float& width, int start, int end, int length) {
     int peaks = 0;
     bool enabled = false;
-    float minBin = 0.0f;
-    float maxBin = 0.0f;
-    float peakCenter = 0.0f;
-    float prevValue = LinearInterpolation(xVals, yVals, length, start - 0.01f);
-    float currValue = LinearInterpolation(xVals, yVals, length, start);
-    float idx = start;
-    while (idx < end) {
-      float nextValue = LinearInterpolation(xVals, yVals, length, idx + 0.01f);
-      if (currValue < threshold) {
+    float rising = 0.0f;
+    int maxBin = 0;
+    std::array<float, 2> centers {};
+    std::array<float, 2> widths {};
+    std::array<T, 2> maxima {};
+    for (int idx = start; idx < end && idx + 1 < length; idx++) {
+      float current = static_cast<float>(values[idx]);
+      float next = static_cast<float>(values[idx + 1]);
+      if (current < threshold) {
         enabled = true;
-      }
-      if (currValue >= threshold and enabled) {
-        if (prevValue < threshold) {
-          minBin = idx;
-        } else if (nextValue <= threshold) {
+        if (next >= threshold) {
+          rising = ThresholdCrossing(idx, current, next, threshold);
+          maxBin = idx + 1;
+        }
+      } else if (enabled) {
+        if (values[idx] > values[maxBin]) {
           maxBin = idx;
+        }
+        if (next < threshold) {
+          if (peaks < 2) {
+            widths[peaks] = ThresholdCrossing(idx, current, next, threshold) - rising;
+            centers[peaks] = ParabolicPeak(values, maxBin);
+            maxima[peaks] = values[maxBin];
+          }
           peaks++;
-          width = maxBin - minBin;
-          peakCenter = width / 2.0f + minBin;
         }
       }
-      prevValue = currValue;
-      currValue = nextValue;
-      idx += 0.01f;
+    }
+    if (peaks == 2 && maxima[1] < maxima[0] && std::abs(centers[1] - (2.0f * centers[0])) <= 1.0f) {
+      peaks = 1;
     }
     if (peaks != 1) {
       width = 0.0f;
-      peakCenter = 0.0f;
+      return 0.0f;
     }
-    return peakCenter;
+    width = widths[0];
+    return centers[0];
   }
 
-  float SpectrumMean(const std::array<float, Ppg::spectrumLength>& signal, int start, int end) {
+  float SpectrumMean(const std::array<Ppg::SpectrumValue, Ppg::spectrumLength>& signal, int start, int end) {
     int total = 0;
     float mean = 0.0f;
     for (int idx = start; idx < end; idx++) {
-      mean += signal.at(idx);
+      mean += static_cast<float>(signal.at(idx));
       total++;
     }
     if (total > 0) {
@@ -72,11 +94,111 @@ namespace {
     return mean;
   }
 
-  float SignalToNoise(const std::array<float, Ppg::spectrumLength>& signal, int start, int end, float max) {
+  float SignalToNoise(const std::array<Ppg::SpectrumValue, Ppg::spectrumLength>& signal, int start, int end, float max) {
     float mean = SpectrumMean(signal, start, end);
     return max / mean;
   }
 
+  // Squared gain of the first difference of Detrend() and of the moving averages of Filter30to240() for a sinusoid
+  // centered on each bin. Its magnitude in the spectrum is its amplitude * sqrt(gain) * dataLength / 4 (Hann window).
+  constexpr std::array<float, Ppg::spectrumLength> MakeFilterGains() {
+    constexpr double lowPassAlpha = 0.816;
+    constexpr double highPassAlpha = 0.268;
+    std::array<float, Ppg::spectrumLength> gains {};
+    for (size_t idx = 0; idx < gains.size(); idx++) {
+      const double angle = 2 * std::numbers::pi * static_cast<double>(idx) / Ppg::dataLength;
+      const double cosine = Pinetime::Utility::SineRadians(angle + (std::numbers::pi / 2));
+      const double difference = 2 - (2 * cosine);
+      // |1 - (1 - alpha) * e^-jw|^2, the denominator of both moving averages
+      auto denominator = [cosine](double alpha) {
+        return 1 - (2 * (1 - alpha) * cosine) + ((1 - alpha) * (1 - alpha));
+      };
+      const double lowPass = lowPassAlpha * lowPassAlpha / denominator(lowPassAlpha);
+      const double highPass = (1 - highPassAlpha) * (1 - highPassAlpha) * difference / denominator(highPassAlpha);
+      double gain = difference;
+      for (int loop = 0; loop < 4; loop++) {
+        gain *= lowPass * highPass;
+      }
+      gains[idx] = static_cast<float>(gain);
+    }
+    return gains;
+  }
+
+  constexpr std::array<float, Ppg::spectrumLength> filterGains = MakeFilterGains();
+
+#if defined(PPG_ENGINE_SLIDING_DFT)
+  // Cutoff frequencies of the exponential moving averages of Filter30to240()
+  constexpr float lowPassAlpha = 0.816f;
+  constexpr float highPassAlpha = 0.268f;
+#elif defined(PPG_ENGINE_FIXED_POINT)
+  // Cutoff frequencies of the exponential moving averages, in Q15: 0.816 and 0.268
+  constexpr int16_t lowPassAlpha = 26739;
+  constexpr int16_t highPassAlpha = 8782;
+  // Largest value of the detrended signal passed to Filter30to240(), the filters may amplify it
+  constexpr int signalBits = 13;
+
+  // Detrend() in fixed point, from the raw samples to signal in Q15.
+  // Returns the shift applied to the signal: signal = detrended value / 2^shift
+  int Detrend(const std::array<uint16_t, Ppg::dataLength>& data, std::array<int16_t, Ppg::dataLength>& signal) {
+    int size = data.size();
+    // Differences of the samples, minus the slope of the line through the first and last ones, in Q8
+    int32_t slope = Pinetime::Utility::RoundedDiv<int32_t>((data.back() - data.front()) * 256, size - 1);
+    auto difference = [&](int idx) {
+      return ((data[idx + 1] - data[idx]) * 256) - slope;
+    };
+    int32_t largest = 0;
+    for (int idx = 0; idx < size - 1; idx++) {
+      largest = std::max(largest, std::abs(difference(idx)));
+    }
+    // Use the whole range available whatever the amplitude of the signal
+    int shift = (largest > 0) ? static_cast<int>(std::bit_width(static_cast<uint32_t>(largest))) - signalBits : 0;
+    for (int idx = 0; idx < size - 1; idx++) {
+      if (shift >= 0) {
+        signal[idx] = static_cast<int16_t>(Pinetime::Utility::RoundedDiv<int32_t>(difference(idx), 1 << shift));
+      } else {
+        signal[idx] = static_cast<int16_t>(difference(idx) * (1 << -shift));
+      }
+    }
+    signal[size - 1] = 0;
+    return shift - 8;
+  }
+
+  int16_t Saturate(int32_t value) {
+    return static_cast<int16_t>(std::clamp<int32_t>(value, INT16_MIN, INT16_MAX));
+  }
+
+  // Filter30to240() in fixed point. The averages start from 0, the mean of the detrended signal, instead of its first
+  // sample: at high heart rates the first sample is far from the mean and its transient reached the DC bin, which then
+  // exceeded dcThreshold.
+  void Filter30to240(std::array<int16_t, Ppg::dataLength>& signal) {
+    for (int loop = 0; loop < 4; loop++) {
+      int32_t expAvg = 0;
+      for (int16_t& value : signal) {
+        expAvg += Pinetime::Utility::MultiplyQ15(value - expAvg, lowPassAlpha);
+        value = Saturate(expAvg);
+      }
+    }
+    for (int loop = 0; loop < 4; loop++) {
+      int32_t expAvg = 0;
+      for (int16_t& value : signal) {
+        expAvg += Pinetime::Utility::MultiplyQ15(value - expAvg, highPassAlpha);
+        value = Saturate(value - expAvg);
+      }
+    }
+  }
+
+  // Coefficients of numpy.hanning(dataLength) in Q15, first half
+  constexpr std::array<int16_t, Ppg::dataLength / 2> MakeHanningTable() {
+    std::array<int16_t, Ppg::dataLength / 2> table {};
+    for (size_t idx = 0; idx < table.size(); idx++) {
+      double sine = Pinetime::Utility::SineRadians(std::numbers::pi * static_cast<double>(idx) / (Ppg::dataLength - 1));
+      table[idx] = static_cast<int16_t>((sine * sine * Pinetime::Utility::Q15One) + 0.5);
+    }
+    return table;
+  }
+
+  constexpr std::array<int16_t, Ppg::dataLength / 2> hanning = MakeHanningTable();
+#else
   // Simple bandpass filter using exponential moving average
   void Filter30to240(std::array<float, Ppg::dataLength>& signal) {
     // From:
@@ -102,17 +224,19 @@ namespace {
       }
     }
   }
+#endif
 
-  float SpectrumMax(const std::array<float, Ppg::spectrumLength>& data, int start, int end) {
-    float max = 0.0f;
+  float SpectrumMax(const std::array<Ppg::SpectrumValue, Ppg::spectrumLength>& data, int start, int end) {
+    Ppg::SpectrumValue max = 0;
     for (int idx = start; idx < end; idx++) {
       if (data.at(idx) > max) {
         max = data.at(idx);
       }
     }
-    return max;
+    return static_cast<float>(max);
   }
 
+#if !defined(PPG_ENGINE_SLIDING_DFT) && !defined(PPG_ENGINE_FIXED_POINT)
   void Detrend(std::array<float, Ppg::dataLength>& signal) {
     int size = signal.size();
     float offset = signal.front();
@@ -135,17 +259,29 @@ namespace {
     0.15088159f, 0.1882551f,  0.22872687f, 0.27189467f, 0.31732949f, 0.36457977f, 0.41317591f, 0.46263495f,
     0.51246535f, 0.56217185f, 0.61126047f, 0.65924333f, 0.70564355f, 0.75f,       0.79187184f, 0.83084292f,
     0.86652594f, 0.89856625f, 0.92664544f, 0.95048443f, 0.96984631f, 0.98453864f, 0.99441541f, 0.99937846f};
+#endif
 }
 
 Ppg::Ppg() {
   dataAverage.fill(0.0f);
-  spectrum.fill(0.0f);
+  spectrum.fill(0);
+#if defined(PPG_ENGINE_SLIDING_DFT)
+  ResetFilter();
+#endif
 }
 
-int8_t Ppg::Preprocess(uint16_t hrs, uint16_t als) {
+int8_t Ppg::Preprocess(uint16_t hrs, uint16_t als, uint16_t acceleration) {
+  motion.Push(acceleration);
+#if defined(PPG_ENGINE_SLIDING_DFT)
+  dft.Push(FilterSample(hrs));
+  if (dataIndex < dataLength) {
+    dataIndex++;
+  }
+#else
   if (dataIndex < dataLength) {
     dataHRS[dataIndex++] = hrs;
   }
+#endif
   alsValue = als;
   if (alsValue > alsThreshold) {
     return 1;
@@ -164,10 +300,13 @@ int Ppg::HeartRate() {
   int hr = 0;
   hr = ProcessHeartRate(resetSpectralAvg);
   resetSpectralAvg = false;
+#if !defined(PPG_ENGINE_SLIDING_DFT)
   // Make room for overlapWindow number of new samples
   for (int idx = 0; idx < dataLength - overlapWindow; idx++) {
     dataHRS[idx] = dataHRS[idx + overlapWindow];
   }
+#endif
+  // Wait for overlapWindow number of new samples
   dataIndex = dataLength - overlapWindow;
   return hr;
 }
@@ -176,6 +315,11 @@ void Ppg::Reset(bool resetDaqBuffer) {
   if (resetDaqBuffer) {
     dataIndex = 0;
     enoughData = false;
+    motion.Reset();
+#if defined(PPG_ENGINE_SLIDING_DFT)
+    dft.Reset();
+    ResetFilter();
+#endif
   }
   avgIndex = 0;
   dataAverage.fill(0.0f);
@@ -183,12 +327,36 @@ void Ppg::Reset(bool resetDaqBuffer) {
   alsThreshold = UINT16_MAX;
   alsValue = 0;
   resetSpectralAvg = true;
-  spectrum.fill(0.0f);
+  spectrum.fill(0);
 }
 
 // Pass init == true to reset spectral averaging.
 // Returns -1 (Reset Acquisition), 0 (Unable to obtain HR) or HR (BPM).
 int Ppg::ProcessHeartRate(bool init) {
+#if defined(PPG_ENGINE_SLIDING_DFT)
+  // The spectrum is kept up to date by Preprocess(), bins past the ROI are not tracked
+  std::array<float, spectrumLength> magnitudes {};
+  dft.HannMagnitudes(magnitudes.data());
+  SpectrumAverage(magnitudes.data(), spectrum.data(), spectrum.size(), init);
+#elif defined(PPG_ENGINE_FIXED_POINT)
+  int shift = Detrend(dataHRS, vReal);
+  Filter30to240(vReal);
+  vImag.fill(0);
+  // Apply Hanning Window
+  for (int idx = 0; idx < dataLength; idx++) {
+    int16_t factor = hanning[(idx < dataLength / 2) ? idx : dataLength - 1 - idx];
+    vReal[idx] = static_cast<int16_t>(Utility::MultiplyQ15(vReal[idx], factor));
+  }
+  // Magnitudes are scaled back to the unit of the samples, in Q8
+  shift += FftQ15<dataLength>::Compute(vReal.data(), vImag.data()) + 8;
+  std::array<SpectrumValue, spectrumLength> magnitudes;
+  for (int idx = 0; idx < spectrumLength; idx++) {
+    uint64_t magnitude = FftQ15<dataLength>::Magnitude(vReal[idx], vImag[idx]);
+    magnitude = (shift >= 0) ? magnitude << shift : magnitude >> -shift;
+    magnitudes[idx] = static_cast<SpectrumValue>(std::min<uint64_t>(magnitude, UINT32_MAX));
+  }
+  SpectrumAverage(magnitudes.data(), spectrum.data(), spectrum.size(), init);
+#else
   std::copy(dataHRS.begin(), dataHRS.end(), vReal.begin());
   Detrend(vReal);
   Filter30to240(vReal);
@@ -210,25 +378,17 @@ int Ppg::ProcessHeartRate(bool init) {
   FFT.complexToMagnitude();
   FFT.~ArduinoFFT();
   SpectrumAverage(vReal.data(), spectrum.data(), spectrum.size(), init);
+#endif
+  SuppressMotion();
   peakLocation = 0.0f;
   float threshold = peakDetectionThreshold;
   float peakWidth = 0.0f;
   int specLen = spectrum.size();
   float max = SpectrumMax(spectrum, hrROIbegin, hrROIend);
   float signalToNoiseRatio = SignalToNoise(spectrum, hrROIbegin, hrROIend, max);
-  if (signalToNoiseRatio > signalToNoiseThreshold && spectrum.at(0) < dcThreshold) {
+  if (signalToNoiseRatio > signalToNoiseThreshold && spectrum.at(0) < dcThreshold * spectrumOne) {
     threshold *= max;
-    // Reuse VImag for interpolation x values passed to PeakSearch
-    for (int idx = 0; idx < dataLength; idx++) {
-      vImag[idx] = idx;
-    }
-    peakLocation = PeakSearch(vImag.data(),
-                              spectrum.data(),
-                              threshold,
-                              peakWidth,
-                              static_cast<float>(hrROIbegin),
-                              static_cast<float>(hrROIend),
-                              specLen);
+    peakLocation = PeakSearch(spectrum.data(), threshold, peakWidth, hrROIbegin, hrROIend, specLen);
     peakLocation *= freqResolution;
   }
   // Peak too wide? (broad spectrum noise or large, rapid HR change)
@@ -257,19 +417,53 @@ int Ppg::ProcessHeartRate(bool init) {
   return rtn;
 }
 
-void Ppg::SpectrumAverage(const float* data, float* spectrum, int length, bool reset) {
+void Ppg::SpectrumAverage(const SpectrumValue* data, SpectrumValue* spectrum, int length, bool reset) {
   if (reset) {
     spectralAvgCount = 0;
   }
+#if defined(PPG_ENGINE_FIXED_POINT)
+  uint64_t count = spectralAvgCount;
+  for (int idx = 0; idx < length; idx++) {
+    spectrum[idx] = static_cast<SpectrumValue>(Utility::RoundedDiv<uint64_t>((spectrum[idx] * count) + data[idx], count + 1));
+  }
+#else
   float count = static_cast<float>(spectralAvgCount);
   for (int idx = 0; idx < length; idx++) {
     spectrum[idx] = (spectrum[idx] * count + data[idx]) / (count + 1);
   }
+#endif
   if (spectralAvgCount < spectralAvgMax) {
     spectralAvgCount++;
   }
 }
 
+// Clears the bins around the frequency of the movements of the arm and its harmonic. The spectrum is averaged,
+// they come back gradually when the arm stops moving.
+// Bins where the PPG signal is much stronger than the artifact predicted from the acceleration are kept: the heart
+// rate is then at the cadence of the movements or at twice the cadence.
+void Ppg::SuppressMotion() {
+  float amplitude = 0.0f;
+  size_t motionBin = motion.DominantBin(hrROIbegin, hrROIend, motionAmplitudeThreshold, amplitude);
+  if (motionBin == 0) {
+    return;
+  }
+  for (size_t harmonic : {motionBin, 2 * motionBin}) {
+    const size_t first = harmonic - 1;
+    const size_t last = std::min<size_t>(harmonic + 1, spectrum.size() - 1);
+    if (first > last) {
+      continue;
+    }
+    // The harmonic of the artifact is at most as strong as the fundamental
+    const float gain = std::sqrt(filterGains[std::min<size_t>(harmonic, spectrum.size() - 1)]);
+    const float artifact = motionArtifactGain * amplitude * gain * (dataLength / 4) * spectrumOne;
+    SpectrumValue peak = *std::max_element(spectrum.begin() + first, spectrum.begin() + last + 1);
+    if (static_cast<float>(peak) > motionPeakFactor * artifact) {
+      continue;
+    }
+    std::fill(spectrum.begin() + first, spectrum.begin() + last + 1, 0);
+  }
+}
+
 float Ppg::HeartRateAverage(float hr) {
   avgIndex++;
   avgIndex %= dataAverage.size();
@@ -295,3 +489,28 @@ float Ppg::HeartRateAverage(float hr) {
   }
   return avg;
 }
+
+#if defined(PPG_ENGINE_SLIDING_DFT)
+// Streaming version of Detrend() and Filter30to240(): first difference, then 4 low pass and 4 high pass
+// exponential moving averages, applied to each sample as it arrives
+float Ppg::FilterSample(uint16_t hrs) {
+  const float sample = static_cast<float>(hrs);
+  float value = (dataIndex > 0) ? sample - previousSample : 0.0f;
+  previousSample = sample;
+  for (float& average : lowPassAverages) {
+    average = (lowPassAlpha * value) + ((1 - lowPassAlpha) * average);
+    value = average;
+  }
+  for (float& average : highPassAverages) {
+    average = (highPassAlpha * value) + ((1 - highPassAlpha) * average);
+    value -= average;
+  }
+  return value;
+}
+
+void Ppg::ResetFilter() {
+  previousSample = 0.0f;
+  lowPassAverages.fill(0.0f);
+  highPassAverages.fill(0.0f);
+}
+#endif
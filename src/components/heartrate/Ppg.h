@@ -3,24 +3,47 @@
 #include <array>
 #include <cstddef>
 #include <cstdint>
-// Note: Change internal define 'sqrt_internal sqrt' to
-// 'sqrt_internal sqrtf' to save ~3KB of flash.
-#define sqrt_internal sqrtf
-#define FFT_SPEED_OVER_PRECISION
-#include "libs/arduinoFFT/src/arduinoFFT.h"
+#include "components/heartrate/MotionReference.h"
+// Spectrum computation, selected with the PPG_ENGINE CMake option:
+//  - FFT         : filter the whole window and compute its FFT every overlapWindow samples
+//  - SLIDING_DFT : filter each sample and update the bins up to the end of the ROI as it arrives,
+//                  the cost per sample is constant and there is no burst of computation
+//  - FIXED_POINT : same as FFT with the filters and the FFT in Q15, the buffers are half the size
+//                  and the computation time doesn't depend on the values. The filters start from 0,
+//                  the mean of the detrended window: heart rates above ~180 bpm stay out of the DC bin.
+#if defined(PPG_ENGINE_SLIDING_DFT)
+  #include "components/heartrate/SlidingDft.h"
+#elif defined(PPG_ENGINE_FIXED_POINT)
+  #include "components/heartrate/FftQ15.h"
+#else
+  // Note: Change internal define 'sqrt_internal sqrt' to
+  // 'sqrt_internal sqrtf' to save ~3KB of flash.
+  #define sqrt_internal sqrtf
+  #define FFT_SPEED_OVER_PRECISION
+  #include "libs/arduinoFFT/src/arduinoFFT.h"
+#endif
 
 namespace Pinetime {
   namespace Controllers {
     class Ppg {
     public:
       Ppg();
-      int8_t Preprocess(uint16_t hrs, uint16_t als);
+      // acceleration is the magnitude of the acceleration when the sample was taken, 1g = 1024
+      int8_t Preprocess(uint16_t hrs, uint16_t als, uint16_t acceleration);
       int HeartRate();
       void Reset(bool resetDaqBuffer);
       static constexpr int deltaTms = 100;
       // Daq dataLength: Must be power of 2
       static constexpr uint16_t dataLength = 64;
       static constexpr uint16_t spectrumLength = dataLength >> 1;
+#if defined(PPG_ENGINE_FIXED_POINT)
+      // Magnitudes in Q8
+      using SpectrumValue = uint32_t;
+      static constexpr float spectrumOne = 256.0f;
+#else
+      using SpectrumValue = float;
+      static constexpr float spectrumOne = 1.0f;
+#endif
 
     private:
       // The sampling frequency (Hz) based on sampling time in milliseconds (DeltaTms)
@@ -51,15 +74,42 @@ namespace Pinetime {
       static constexpr float dcThreshold = 0.5f;
       // ALS detection factor
       static constexpr float alsFactor = 2.0f;
+      // Movements of the arm with a smaller amplitude (1g = 1024) don't show in the PPG signal
+      static constexpr float motionAmplitudeThreshold = 64.0f;
+      // Amplitude of the artifact of the movements of the arm in the PPG signal, per unit of amplitude of the
+      // acceleration. From the synthetic traces of the host tests, to be refined with recorded traces.
+      static constexpr float motionArtifactGain = 0.1f;
+      // The spectrum around the movements is kept when the PPG signal there is this many times stronger than their artifact
+      static constexpr float motionPeakFactor = 2.0f;
 
+#if defined(PPG_ENGINE_SLIDING_DFT)
+      // Bins tracked by the sliding DFT: DC, the ROI and one more bin for the Hann window
+      static constexpr uint16_t nbTrackedBins = hrROIend + 2;
+      // Spectrum of the filtered samples, updated by Preprocess()
+      SlidingDft<dataLength, nbTrackedBins> dft;
+      // State of FilterSample(): previous sample and the exponential moving averages
+      float previousSample = 0.0f;
+      std::array<float, 4> lowPassAverages;
+      std::array<float, 4> highPassAverages;
+#elif defined(PPG_ENGINE_FIXED_POINT)
+      // Raw ADC data
+      std::array<uint16_t, dataLength> dataHRS;
+      // Filtered signal, then real part of the FFT, in Q15
+      std::array<int16_t, dataLength> vReal;
+      // Imaginary part of the FFT, in Q15
+      std::array<int16_t, dataLength> vImag;
+#else
       // Raw ADC data
       std::array<uint16_t, dataLength> dataHRS;
       // Stores Real numbers from FFT
       std::array<float, dataLength> vReal;
       // Stores Imaginary numbers from FFT
       std::array<float, dataLength> vImag;
+#endif
       // Stores power spectrum calculated from FFT real and imag values
-      std::array<float, (spectrumLength)> spectrum;
+      std::array<SpectrumValue, (spectrumLength)> spectrum;
+      // Acceleration during the window, to remove the motion artifacts from the spectrum
+      MotionReference<dataLength> motion;
       // Stores each new HR value (Hz). Non zero values are averaged for HR output
       std::array<float, 20> dataAverage;
 
@@ -74,8 +124,13 @@ namespace Pinetime {
       bool enoughData = false;
 
       int ProcessHeartRate(bool init);
+#if defined(PPG_ENGINE_SLIDING_DFT)
+      float FilterSample(uint16_t hrs);
+      void ResetFilter();
+#endif
+      void SuppressMotion();
       float HeartRateAverage(float hr);
-      void SpectrumAverage(const float* data, float* spectrum, int length, bool reset);
+      void SpectrumAverage(const SpectrumValue* data, SpectrumValue* spectrum, int length, bool reset);
     };
   }
 }
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <numbers>
+#include "utility/Trigonometry.h"
+
+namespace Pinetime {
+  namespace Controllers {
+    namespace Detail {
+      // sin(2 * pi * i / N + phase)
+      template <size_t N>
+      constexpr std::array<float, N> MakeTwiddleTable(double phase) {
+        std::array<float, N> table {};
+        for (size_t i = 0; i < N; i++) {
+          table[i] = static_cast<float>(Utility::SineRadians((2 * std::numbers::pi * static_cast<double>(i) / N) + phase));
+        }
+        return table;
+      }
+    }
+
+    /* Spectrum of the last N samples, updated at every sample for a constant cost instead of computing an FFT
+     * of the whole window for every analysis. Only bins [0, nbBins) are tracked.
+     * Bins are sums of the samples multiplied by twiddle factors referenced to the absolute sample index, so
+     * adding the newest sample and removing the oldest one is an addition per bin: rounding errors are not
+     * multiplied over time like in the recursive form of the sliding DFT.
+     */
+    template <size_t N, size_t nbBins>
+    class SlidingDft {
+    public:
+      static_assert(nbBins >= 2 && nbBins <= N / 2, "Bins past N / 2 mirror the lower ones");
+
+      void Reset() {
+        history.fill(0.0f);
+        bins.fill({});
+        index = 0;
+      }
+
+      void Push(float sample) {
+        const float delta = sample - history[index];
+        history[index] = sample;
+        for (size_t k = 0; k < nbBins; k++) {
+          const size_t twiddle = (k * index) % N;
+          bins[k].real += delta * cosTable[twiddle];
+          bins[k].imag -= delta * sinTable[twiddle];
+        }
+        index = (index + 1) % N;
+      }
+
+      // Magnitude of bins [0, nbBins - 1) of the spectrum of the window multiplied by a Hann window,
+      // which is the convolution of the spectrum with {-1/4, 1/2, -1/4}
+      void HannMagnitudes(float* magnitudes) const {
+        // Phase of the bins relative to the start of the window, the oldest sample
+        std::array<Complex, nbBins> aligned;
+        for (size_t k = 0; k < nbBins; k++) {
+          const size_t twiddle = (k * index) % N;
+          aligned[k].real = (bins[k].real * cosTable[twiddle]) - (bins[k].imag * sinTable[twiddle]);
+          aligned[k].imag = (bins[k].real * sinTable[twiddle]) + (bins[k].imag * cosTable[twiddle]);
+        }
+        for (size_t k = 0; k < nbBins - 1; k++) {
+          // The spectrum of a real signal is symmetric: bin -1 is the conjugate of bin 1
+          const Complex& previous = (k == 0) ? Complex {aligned[1].real, -aligned[1].imag} : aligned[k - 1];
+          const Complex& next = aligned[k + 1];
+          const float real = (0.5f * aligned[k].real) - (0.25f * (previous.real + next.real));
+          const float imag = (0.5f * aligned[k].imag) - (0.25f * (previous.imag + next.imag));
+          magnitudes[k] = std::sqrt((real * real) + (imag * imag));
+        }
+      }
+
+    private:
+      struct Complex {
+        float real = 0.0f;
+        float imag = 0.0f;
+      };
+
+      static constexpr std::array<float, N> cosTable = Detail::MakeTwiddleTable<N>(std::numbers::pi / 2);
+      static constexpr std::array<float, N> sinTable = Detail::MakeTwiddleTable<N>(0);
+
+      std::array<float, N> history {};
+      std::array<Complex, nbBins> bins {};
+      size_t index = 0;
+    };
+  }
+}
@@ -1,5 +1,6 @@
 #include "components/motion/MotionController.h"
 
+#include <cmath>
 #include <task.h>
 
 #include "utility/Math.h"
@@ -73,6 +74,21 @@ void MotionController::Update(int16_t x, int16_t y, int16_t z, uint32_t nbSteps)
 
   stats = GetAccelStats();
 
+  motionVariance = 0;
+  for (const auto* history : {&xHistory, &yHistory, &zHistory}) {
+    int32_t mean = 0;
+    for (uint8_t i = 0; i < histSize; i++) {
+      mean += (*history)[i];
+    }
+    mean /= histSize;
+    uint32_t variance = 0;
+    for (uint8_t i = 0; i < histSize; i++) {
+      int32_t deviation = (*history)[i] - mean;
+      variance += deviation * deviation;
+    }
+    motionVariance += variance / histSize;
+  }
+
   int32_t deltaSteps = nbSteps - oldSteps;
   if (deltaSteps > 0) {
     currentTripSteps += deltaSteps;
@@ -80,6 +96,13 @@ void MotionController::Update(int16_t x, int16_t y, int16_t z, uint32_t nbSteps)
   SetSteps(Days::Today, nbSteps);
 }
 
+uint16_t MotionController::AccelerationMagnitude() const {
+  int32_t x = xHistory[0];
+  int32_t y = yHistory[0];
+  int32_t z = zHistory[0];
+  return static_cast<uint16_t>(std::sqrt(static_cast<float>((x * x) + (y * y) + (z * z))));
+}
+
 MotionController::AccelStats MotionController::GetAccelStats() const {
   AccelStats stats;
 
@@ -41,6 +41,14 @@ namespace Pinetime {
         return zHistory[0];
       }
 
+      // Magnitude of the last acceleration, 1g = 1024
+      uint16_t AccelerationMagnitude() const;
+
+      // Sum of the variances of the axes over the history, 0 when the watch doesn't move
+      uint32_t MotionVariance() const {
+        return motionVariance;
+      }
+
       uint32_t NbSteps(Days day = Days::Today) const {
         return nbSteps[static_cast<std::underlying_type_t<Days>>(day)];
       }
@@ -109,6 +117,7 @@ namespace Pinetime {
       Utility::CircularBuffer<int16_t, histSize> yHistory = {};
       Utility::CircularBuffer<int16_t, histSize> zHistory = {};
       int32_t accumulatedSpeed = 0;
+      uint32_t motionVariance = 0;
 
       DeviceTypes deviceType = DeviceTypes::Unknown;
       Pinetime::Controllers::MotionService* service = nullptr;
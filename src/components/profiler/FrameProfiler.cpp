@@ -0,0 +1,58 @@
+#include "components/profiler/FrameProfiler.h"
+#include <task.h>
+#include <algorithm>
+
+using namespace Pinetime::Controllers;
+
+void FrameProfiler::Record(Phases phase, uint32_t cycles) {
+  const uint32_t us = cycles / cyclesPerUs;
+  auto& stats = report.phases[static_cast<size_t>(phase)];
+
+  const auto limit = std::upper_bound(bucketLimitsUs.begin(), bucketLimitsUs.end(), us);
+  auto& bucket = stats.histogram[limit - bucketLimitsUs.begin()];
+  if (bucket == UINT16_MAX) {
+    for (auto& count : stats.histogram) {
+      count /= 2;
+    }
+  }
+  bucket++;
+  stats.maxUs = std::max(stats.maxUs, us);
+}
+
+void FrameProfiler::FrameDone(uint32_t cycles) {
+  windowFrames++;
+  windowWorstFrameUs = std::max(windowWorstFrameUs, cycles / cyclesPerUs);
+}
+
+bool FrameProfiler::Update() {
+  const TickType_t now = xTaskGetTickCount();
+  const TickType_t elapsed = now - windowStart;
+  if (elapsed < configTICK_RATE_HZ) {
+    return false;
+  }
+
+  report.framesPerSecond = (windowFrames * configTICK_RATE_HZ) / elapsed;
+  report.worstFrameUs = windowWorstFrameUs;
+  windowFrames = 0;
+  windowWorstFrameUs = 0;
+  windowStart = now;
+
+  if (++windowCount >= histogramHalfLife) {
+    windowCount = 0;
+    for (auto& stats : report.phases) {
+      for (auto& count : stats.histogram) {
+        count /= 2;
+      }
+      stats.maxUs /= 2;
+    }
+  }
+  return true;
+}
+
+FrameProfiler::Report FrameProfiler::GetReport() const {
+  // Read from the BLE task while DisplayApp updates it
+  taskENTER_CRITICAL();
+  Report copy = report;
+  taskEXIT_CRITICAL();
+  return copy;
+}
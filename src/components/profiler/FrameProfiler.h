@@ -0,0 +1,70 @@
+#pragma once
+
+#include <FreeRTOS.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace Pinetime {
+  namespace Controllers {
+    // Timing of the display loop. DisplayApp and LittleVgl measure the phases with the DWT cycle counter,
+    // this class keeps rolling histograms of them along with the frame rate and the worst frame of the last second.
+    class FrameProfiler {
+    public:
+      enum class Phases : uint8_t { TaskHandler, Render, Flush, Messages };
+      static constexpr size_t nbPhases = 4;
+
+      // Upper bounds of the histogram buckets in microseconds, the last bucket collects everything above
+      static constexpr std::array<uint32_t, 7> bucketLimitsUs {500, 1000, 2000, 4000, 8000, 16000, 33000};
+      static constexpr size_t nbBuckets = bucketLimitsUs.size() + 1;
+
+      struct __attribute__((packed)) PhaseStats {
+        uint16_t histogram[nbBuckets];
+        uint32_t maxUs;
+      };
+
+      // Exported as is over BLE (FrameProfilerService)
+      struct __attribute__((packed)) Report {
+        uint16_t framesPerSecond;
+        uint32_t worstFrameUs;
+        PhaseStats phases[nbPhases];
+      };
+
+      void Record(Phases phase, uint32_t cycles);
+      void FrameDone(uint32_t cycles);
+
+      // Called once per display loop iteration. Returns true when a new one second window has been closed.
+      bool Update();
+
+      Report GetReport() const;
+
+      uint16_t FramesPerSecond() const {
+        return report.framesPerSecond;
+      }
+
+      uint32_t WorstFrameUs() const {
+        return report.worstFrameUs;
+      }
+
+      bool IsOverlayEnabled() const {
+        return overlayEnabled;
+      }
+
+      void SetOverlayEnabled(bool enabled) {
+        overlayEnabled = enabled;
+      }
+
+    private:
+      static constexpr uint32_t cyclesPerUs = 64;
+      // The histograms are halved every histogramHalfLife windows, so they reflect the last few seconds
+      static constexpr uint8_t histogramHalfLife = 10;
+
+      Report report {};
+      TickType_t windowStart = 0;
+      uint16_t windowFrames = 0;
+      uint32_t windowWorstFrameUs = 0;
+      uint8_t windowCount = 0;
+      volatile bool overlayEnabled = false;
+    };
+  }
+}
@@ -91,7 +91,8 @@ DisplayApp::DisplayApp(Drivers::St7789& lcd,
                        Pinetime::Controllers::BrightnessController& brightnessController,
                        Pinetime::Controllers::TouchHandler& touchHandler,
                        Pinetime::Controllers::FS& filesystem,
-                       Pinetime::Drivers::SpiNorFlash& spiNorFlash)
+                       Pinetime::Drivers::SpiNorFlash& spiNorFlash,
+                       Pinetime::Controllers::FrameProfiler& frameProfiler)
   : lcd {lcd},
     touchPanel {touchPanel},
     batteryController {batteryController},
@@ -109,7 +110,8 @@ DisplayApp::DisplayApp(Drivers::St7789& lcd,
     touchHandler {touchHandler},
     filesystem {filesystem},
     spiNorFlash {spiNorFlash},
-    lvgl {lcd, filesystem},
+    frameProfiler {frameProfiler},
+    lvgl {lcd, filesystem, frameProfiler},
     timer(this, TimerCallback),
     controllers {batteryController,
                  bleController,
@@ -202,6 +204,22 @@ TickType_t DisplayApp::CalculateSleepTime() {
   }
 }
 
+uint32_t DisplayApp::CurrentMinute() {
+  const auto now = dateTimeController.CurrentDateTime().time_since_epoch();
+  return std::chrono::floor<std::chrono::minutes>(now).count();
+}
+
+TickType_t DisplayApp::CalculateMinuteSleepTime() {
+  const auto now = dateTimeController.CurrentDateTime().time_since_epoch();
+  const auto minute = std::chrono::floor<std::chrono::minutes>(now);
+  if (static_cast<uint32_t>(minute.count()) != alwaysOnMinute) {
+    return 0;
+  }
+  const auto untilNextMinute = std::chrono::ceil<std::chrono::milliseconds>(minute + std::chrono::minutes(1) - now);
+  // One more tick so that the minute has changed when we wake up
+  return pdMS_TO_TICKS(untilNextMinute.count()) + 1;
+}
+
 void DisplayApp::Refresh() {
   auto LoadPreviousScreen = [this]() {
     FullRefreshDirections returnDirection;
@@ -242,6 +260,20 @@ void DisplayApp::Refresh() {
       if (!currentScreen->IsRunning()) {
         LoadPreviousScreen();
       }
+      if (currentScreen->OnlyChangesEachMinute()) {
+        // Watch faces without seconds only change when the minute does: sleep until then instead of drawing
+        // every alwaysOnRefreshPeriod. Faces that show the seconds keep the periodic refresh below.
+        queueTimeout = CalculateMinuteSleepTime();
+        if (queueTimeout == 0) {
+          RunTaskHandler();
+          // The watch face refresh task may have run after the display refresh task,
+          // draw what it changed now rather than a minute later
+          lv_refr_now(nullptr);
+          alwaysOnMinute = CurrentMinute();
+          queueTimeout = CalculateMinuteSleepTime();
+        }
+        break;
+      }
       // Check we've slept long enough
       // Might not be true if the loop received an event
       // If not true, then wait that amount of time
@@ -250,7 +282,7 @@ void DisplayApp::Refresh() {
         // Only advance the tick count when LVGL is done
         // Otherwise keep running the task handler while it still has things to draw
         // Note: under high graphics load, LVGL will always have more work to do
-        if (lv_task_handler() > 0) {
+        if (RunTaskHandler() > 0) {
           // Drop frames that we've missed if drawing/event handling took way longer than expected
           while (queueTimeout == 0) {
             alwaysOnFrameCount += 1;
@@ -263,7 +295,7 @@ void DisplayApp::Refresh() {
       if (!currentScreen->IsRunning()) {
         LoadPreviousScreen();
       }
-      queueTimeout = lv_task_handler();
+      queueTimeout = RunTaskHandler();
 
       if (!systemTask->IsSleepDisabled() && IsPastDimTime()) {
         if (!isDimmed) {
@@ -297,6 +329,7 @@ void DisplayApp::Refresh() {
 
   Messages msg;
   if (xQueueReceive(msgQueue, &msg, queueTimeout) == pdTRUE) {
+    const uint32_t messageStartCycles = DWT->CYCCNT;
     switch (msg) {
       case Messages::GoToSleep:
       case Messages::GoToAOD:
@@ -332,10 +365,11 @@ void DisplayApp::Refresh() {
         // display activity timer causing the screen to never sleep after timeout
         lvgl.ClearTouchState();
         if (msg == Messages::GoToAOD) {
-          lcd.LowPowerOn();
+          lvgl.SetLowPower(true);
           // Record idle entry time
           alwaysOnFrameCount = 0;
           alwaysOnStartTime = xTaskGetTickCount();
+          alwaysOnMinute = CurrentMinute() - 1;
           PushMessageToSystemTask(Pinetime::System::Messages::OnDisplayTaskAOD);
           state = States::AOD;
         } else {
@@ -355,7 +389,7 @@ void DisplayApp::Refresh() {
           break;
         }
         if (state == States::AOD) {
-          lcd.LowPowerOff();
+          lvgl.SetLowPower(false);
         } else {
           lcd.Wakeup();
         }
@@ -486,6 +520,7 @@ void DisplayApp::Refresh() {
         motorController.RunForDuration(35);
         break;
     }
+    frameProfiler.Record(Controllers::FrameProfiler::Phases::Messages, DWT->CYCCNT - messageStartCycles);
   }
 
   if (state == States::Running && touchHandler.IsTouching()) {
@@ -498,6 +533,48 @@ void DisplayApp::Refresh() {
   }
 }
 
+uint32_t DisplayApp::RunTaskHandler() {
+  const uint32_t framesBefore = lvgl.GetFrameCount();
+  lvgl.StartFrame();
+  const uint32_t startCycles = DWT->CYCCNT;
+  const uint32_t timeUntilNextTask = lv_task_handler();
+  const uint32_t cycles = DWT->CYCCNT - startCycles;
+
+  frameProfiler.Record(Controllers::FrameProfiler::Phases::TaskHandler, cycles);
+  if (lvgl.GetFrameCount() != framesBefore) {
+    frameProfiler.FrameDone(cycles);
+  }
+  UpdateProfilerOverlay(frameProfiler.Update());
+  return timeUntilNextTask;
+}
+
+void DisplayApp::UpdateProfilerOverlay(bool newStats) {
+  if (!frameProfiler.IsOverlayEnabled()) {
+    if (profilerOverlay != nullptr) {
+      lv_obj_del(profilerOverlay);
+      profilerOverlay = nullptr;
+    }
+    return;
+  }
+
+  if (profilerOverlay == nullptr) {
+    // On the top layer so that it stays visible across screen changes
+    profilerOverlay = lv_label_create(lv_layer_top(), nullptr);
+    lv_obj_set_style_local_bg_opa(profilerOverlay, LV_LABEL_PART_MAIN, LV_STATE_DEFAULT, LV_OPA_COVER);
+    lv_obj_set_style_local_bg_color(profilerOverlay, LV_LABEL_PART_MAIN, LV_STATE_DEFAULT, LV_COLOR_BLACK);
+    lv_obj_set_style_local_text_color(profilerOverlay, LV_LABEL_PART_MAIN, LV_STATE_DEFAULT, LV_COLOR_YELLOW);
+    lv_obj_align(profilerOverlay, nullptr, LV_ALIGN_IN_TOP_LEFT, 0, 0);
+  } else if (!newStats) {
+    return;
+  }
+  const uint32_t worstFrameUs = frameProfiler.WorstFrameUs();
+  lv_label_set_text_fmt(profilerOverlay,
+                        "%u fps %lu.%lu ms",
+                        frameProfiler.FramesPerSecond(),
+                        worstFrameUs / 1000,
+                        (worstFrameUs % 1000) / 100);
+}
+
 void DisplayApp::StartApp(Apps app, DisplayApp::FullRefreshDirections direction) {
   nextApp = app;
   nextDirection = direction;
@@ -646,7 +723,9 @@ void DisplayApp::LoadScreen(Apps app, DisplayApp::FullRefreshDirections directio
                                                             watchdog,
                                                             motionController,
                                                             touchPanel,
-                                                            spiNorFlash);
+                                                            spiNorFlash,
+                                                            lcd,
+                                                            lvgl);
       break;
     case Apps::FlashLight:
       currentScreen = std::make_unique<Screens::FlashLight>(*systemTask, brightnessController);
@@ -15,6 +15,7 @@
 #include "components/timer/Timer.h"
 #include "components/stopwatch/StopWatchController.h"
 #include "components/alarm/AlarmController.h"
+#include "components/profiler/FrameProfiler.h"
 #include "touchhandler/TouchHandler.h"
 
 #include "displayapp/Messages.h"
@@ -69,7 +70,8 @@ namespace Pinetime {
                  Pinetime::Controllers::BrightnessController& brightnessController,
                  Pinetime::Controllers::TouchHandler& touchHandler,
                  Pinetime::Controllers::FS& filesystem,
-                 Pinetime::Drivers::SpiNorFlash& spiNorFlash);
+                 Pinetime::Drivers::SpiNorFlash& spiNorFlash,
+                 Pinetime::Controllers::FrameProfiler& frameProfiler);
       void Start(System::BootErrors error);
       void PushMessage(Display::Messages msg);
 
@@ -101,6 +103,7 @@ namespace Pinetime {
       Pinetime::Controllers::TouchHandler& touchHandler;
       Pinetime::Controllers::FS& filesystem;
       Pinetime::Drivers::SpiNorFlash& spiNorFlash;
+      Pinetime::Controllers::FrameProfiler& frameProfiler;
 
       Pinetime::Controllers::FirmwareValidator validator;
       Pinetime::Components::LittleVgl lvgl;
@@ -116,6 +119,7 @@ namespace Pinetime {
       static constexpr uint8_t itemSize = 1;
 
       std::unique_ptr<Screens::Screen> currentScreen;
+      lv_obj_t* profilerOverlay = nullptr;
 
       Apps currentApp = Apps::None;
       Apps returnToApp = Apps::None;
@@ -126,6 +130,8 @@ namespace Pinetime {
       static void Process(void* instance);
       void Init();
       void Refresh();
+      uint32_t RunTaskHandler();
+      void UpdateProfilerOverlay(bool newStats);
       void LoadNewScreen(Apps app, DisplayApp::FullRefreshDirections direction);
       void LoadScreen(Apps app, DisplayApp::FullRefreshDirections direction);
       void PushMessageToSystemTask(Pinetime::System::Messages message);
@@ -142,11 +148,15 @@ namespace Pinetime {
       bool isDimmed = false;
 
       TickType_t CalculateSleepTime();
+      TickType_t CalculateMinuteSleepTime();
+      uint32_t CurrentMinute();
       TickType_t alwaysOnFrameCount;
       TickType_t alwaysOnStartTime;
       // If this is to be changed, make sure the actual always on refresh rate is changed
       // by configuring the LCD refresh timings
       static constexpr uint32_t alwaysOnRefreshPeriod = 500;
+      // Watch faces are only drawn when the minute changes in always on mode
+      uint32_t alwaysOnMinute = 0;
     };
   }
 }
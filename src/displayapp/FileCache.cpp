@@ -0,0 +1,354 @@
+#include "displayapp/FileCache.h"
+#include <algorithm>
+#include <cstring>
+
+using namespace Pinetime::Components;
+
+FileCache::FileCache(Pinetime::Controllers::FS& filesystem) : filesystem {filesystem} {
+}
+
+void FileCache::Register() {
+  lv_fs_drv_t fs_drv;
+  lv_fs_drv_init(&fs_drv);
+
+  fs_drv.file_size = sizeof(File);
+  fs_drv.letter = 'F';
+  fs_drv.open_cb = Open;
+  fs_drv.close_cb = Close;
+  fs_drv.read_cb = Read;
+  fs_drv.seek_cb = Seek;
+  fs_drv.tell_cb = Tell;
+  fs_drv.size_cb = Size;
+
+  fs_drv.rddir_size = sizeof(lfs_dir_t);
+  fs_drv.dir_open_cb = DirOpen;
+  fs_drv.dir_read_cb = DirRead;
+  fs_drv.dir_close_cb = DirClose;
+
+  fs_drv.user_data = this;
+
+  lv_fs_drv_register(&fs_drv);
+}
+
+lv_fs_res_t FileCache::Open(lv_fs_drv_t* drv, void* file_p, const char* path, lv_fs_mode_t /*mode*/) {
+  auto* cache = static_cast<FileCache*>(drv->user_data);
+  return cache->OpenFile(*static_cast<File*>(file_p), path);
+}
+
+lv_fs_res_t FileCache::Close(lv_fs_drv_t* drv, void* file_p) {
+  auto* cache = static_cast<FileCache*>(drv->user_data);
+  cache->CloseFile(*static_cast<File*>(file_p));
+  return LV_FS_RES_OK;
+}
+
+lv_fs_res_t FileCache::Read(lv_fs_drv_t* drv, void* file_p, void* buf, uint32_t btr, uint32_t* br) {
+  auto* cache = static_cast<FileCache*>(drv->user_data);
+  return cache->ReadFile(*static_cast<File*>(file_p), static_cast<uint8_t*>(buf), btr, br);
+}
+
+lv_fs_res_t FileCache::Seek(lv_fs_drv_t* /*drv*/, void* file_p, uint32_t pos) {
+  static_cast<File*>(file_p)->position = pos;
+  return LV_FS_RES_OK;
+}
+
+lv_fs_res_t FileCache::Tell(lv_fs_drv_t* /*drv*/, void* file_p, uint32_t* pos_p) {
+  *pos_p = static_cast<File*>(file_p)->position;
+  return LV_FS_RES_OK;
+}
+
+lv_fs_res_t FileCache::Size(lv_fs_drv_t* drv, void* file_p, uint32_t* size_p) {
+  auto* cache = static_cast<FileCache*>(drv->user_data);
+  auto& file = *static_cast<File*>(file_p);
+  if (file.entry != nullptr) {
+    *size_p = file.entry->size;
+    return LV_FS_RES_OK;
+  }
+  const int size = cache->filesystem.FileSize(&file.file);
+  if (size < 0) {
+    return LV_FS_RES_FS_ERR;
+  }
+  *size_p = size;
+  return LV_FS_RES_OK;
+}
+
+lv_fs_res_t FileCache::DirOpen(lv_fs_drv_t* drv, void* rddir_p, const char* path) {
+  auto* cache = static_cast<FileCache*>(drv->user_data);
+  if (cache->filesystem.DirOpen(path, static_cast<lfs_dir_t*>(rddir_p)) != LFS_ERR_OK) {
+    return LV_FS_RES_NOT_EX;
+  }
+  return LV_FS_RES_OK;
+}
+
+// fn must hold a name of the file system (50 characters) and 2 more bytes. Directory names start with a '/',
+// like with LVGL's other drivers, and an empty name marks the end of the directory.
+lv_fs_res_t FileCache::DirRead(lv_fs_drv_t* drv, void* rddir_p, char* fn) {
+  auto* cache = static_cast<FileCache*>(drv->user_data);
+  auto* dir = static_cast<lfs_dir_t*>(rddir_p);
+  lfs_info info;
+  int res;
+  do {
+    res = cache->filesystem.DirRead(dir, &info);
+  } while (res > 0 && (std::strcmp(info.name, ".") == 0 || std::strcmp(info.name, "..") == 0));
+
+  fn[0] = '\0';
+  if (res < 0) {
+    return LV_FS_RES_FS_ERR;
+  }
+  if (res > 0) {
+    if (info.type == LFS_TYPE_DIR) {
+      fn[0] = '/';
+      fn++;
+    }
+    std::strcpy(fn, info.name);
+  }
+  return LV_FS_RES_OK;
+}
+
+lv_fs_res_t FileCache::DirClose(lv_fs_drv_t* drv, void* rddir_p) {
+  auto* cache = static_cast<FileCache*>(drv->user_data);
+  cache->filesystem.DirClose(static_cast<lfs_dir_t*>(rddir_p));
+  return LV_FS_RES_OK;
+}
+
+lv_fs_res_t FileCache::OpenFile(File& file, const char* path) {
+  if (filesystem.GetModificationCount() != modificationCount) {
+    Invalidate();
+    modificationCount = filesystem.GetModificationCount();
+  }
+  clock++;
+  file.entry = nullptr;
+  file.position = 0;
+  file.handlePosition = 0;
+  file.bufferStart = 0;
+  file.bufferSize = 0;
+
+  Entry* entry = Find(path);
+  if (entry != nullptr && !entry->inUse) {
+    // Open files are shared with the previous user, rewind them
+    if (entry->state != States::Open || filesystem.FileSeek(&entry->file, 0) >= 0) {
+      entry->lastUse = clock;
+      if (entry->state == States::Missing) {
+        return LV_FS_RES_NOT_EX;
+      }
+      entry->inUse = true;
+      file.entry = entry;
+      return LV_FS_RES_OK;
+    }
+    Release(*entry);
+  } else if (entry != nullptr) {
+    // Already open through the cache: the second user gets a file of its own
+    return OpenUncached(file, path);
+  }
+
+  if (std::strlen(path) >= maxPathLength) {
+    return OpenUncached(file, path);
+  }
+  entry = Allocate();
+  if (entry == nullptr) {
+    return OpenUncached(file, path);
+  }
+  const lv_fs_res_t res = OpenEntry(*entry, path);
+  if (res == LV_FS_RES_OK) {
+    entry->inUse = true;
+    file.entry = entry;
+  }
+  return res;
+}
+
+lv_fs_res_t FileCache::OpenEntry(Entry& entry, const char* path) {
+  std::strcpy(entry.path, path);
+  entry.lastUse = clock;
+  const int res = filesystem.FileOpen(&entry.file, path, LFS_O_RDONLY);
+  if (res != LFS_ERR_OK) {
+    if (res == LFS_ERR_NOENT) {
+      entry.state = States::Missing;
+    } else {
+      entry = {};
+    }
+    return LV_FS_RES_NOT_EX;
+  }
+  const int size = filesystem.FileSize(&entry.file);
+  if (entry.file.type == 0 || size < 0) {
+    filesystem.FileClose(&entry.file);
+    entry = {};
+    return LV_FS_RES_FS_ERR;
+  }
+  entry.size = size;
+
+  // Reading a small file once costs less RAM than keeping it open
+  if (entry.size <= maxDataFileSize) {
+    while (dataSize + entry.size > dataBudget && EvictLeastRecentlyUsed(States::Data)) {
+    }
+    if (dataSize + entry.size <= dataBudget) {
+      entry.data = static_cast<uint8_t*>(lv_mem_alloc(entry.size));
+      if (entry.data != nullptr && filesystem.FileRead(&entry.file, entry.data, entry.size) == size) {
+        filesystem.FileClose(&entry.file);
+        entry.state = States::Data;
+        dataSize += entry.size;
+        return LV_FS_RES_OK;
+      }
+      if (entry.data != nullptr) {
+        lv_mem_free(entry.data);
+        entry.data = nullptr;
+      }
+      filesystem.FileSeek(&entry.file, 0);
+    }
+  }
+
+  // Open files use the file caches of the file system, leave some for the other users
+  auto nbOpenFiles = [this]() {
+    return std::count_if(entries.begin(), entries.end(), [](const Entry& e) {
+      return e.state == States::Open;
+    });
+  };
+  while (nbOpenFiles() >= maxOpenFiles && EvictLeastRecentlyUsed(States::Open)) {
+  }
+  entry.state = States::Open;
+  return LV_FS_RES_OK;
+}
+
+lv_fs_res_t FileCache::OpenUncached(File& file, const char* path) {
+  if (filesystem.FileOpen(&file.file, path, LFS_O_RDONLY) != LFS_ERR_OK) {
+    return LV_FS_RES_NOT_EX;
+  }
+  if (file.file.type == 0) {
+    filesystem.FileClose(&file.file);
+    return LV_FS_RES_FS_ERR;
+  }
+  return LV_FS_RES_OK;
+}
+
+lv_fs_res_t FileCache::ReadFile(File& file, uint8_t* data, uint32_t size, uint32_t* read) {
+  *read = 0;
+  if (file.entry != nullptr && file.entry->state == States::Data) {
+    const uint32_t fileSize = file.entry->size;
+    const uint32_t count = (file.position < fileSize) ? std::min(size, fileSize - file.position) : 0;
+    std::memcpy(data, file.entry->data + file.position, count);
+    file.position += count;
+    *read = count;
+    return LV_FS_RES_OK;
+  }
+
+  while (size > 0) {
+    if (file.position >= file.bufferStart && file.position < file.bufferStart + file.bufferSize) {
+      const uint32_t offset = file.position - file.bufferStart;
+      const uint32_t count = std::min<uint32_t>(size, file.bufferSize - offset);
+      std::memcpy(data, file.buffer + offset, count);
+      file.position += count;
+      data += count;
+      size -= count;
+      *read += count;
+      continue;
+    }
+
+    // Large reads go straight to the file, small ones refill the read ahead buffer
+    const bool direct = size >= readAheadSize;
+    const int res = direct ? ReadHandle(file, data, size) : ReadHandle(file, file.buffer, readAheadSize);
+    if (res < 0) {
+      return LV_FS_RES_FS_ERR;
+    }
+    if (direct) {
+      file.position += res;
+      *read += res;
+      return LV_FS_RES_OK;
+    }
+    file.bufferStart = file.position;
+    file.bufferSize = res;
+    if (res == 0) {
+      // End of file
+      return LV_FS_RES_OK;
+    }
+  }
+  return LV_FS_RES_OK;
+}
+
+int FileCache::ReadHandle(File& file, uint8_t* data, uint32_t size) {
+  lfs_file_t* handle = Handle(file);
+  if (file.handlePosition != file.position) {
+    const int res = filesystem.FileSeek(handle, file.position);
+    if (res < 0) {
+      return res;
+    }
+    file.handlePosition = file.position;
+  }
+  const int res = filesystem.FileRead(handle, data, size);
+  if (res > 0) {
+    file.handlePosition += res;
+  }
+  return res;
+}
+
+void FileCache::CloseFile(File& file) {
+  if (file.entry == nullptr) {
+    filesystem.FileClose(&file.file);
+    return;
+  }
+  Entry& entry = *file.entry;
+  entry.inUse = false;
+  if (entry.stale) {
+    Release(entry);
+  }
+}
+
+lfs_file_t* FileCache::Handle(File& file) {
+  return (file.entry != nullptr) ? &file.entry->file : &file.file;
+}
+
+FileCache::Entry* FileCache::Find(const char* path) {
+  for (auto& entry : entries) {
+    if (entry.state != States::Free && !entry.stale && std::strcmp(entry.path, path) == 0) {
+      return &entry;
+    }
+  }
+  return nullptr;
+}
+
+FileCache::Entry* FileCache::Allocate() {
+  Entry* leastRecentlyUsed = nullptr;
+  for (auto& entry : entries) {
+    if (entry.state == States::Free) {
+      return &entry;
+    }
+    if (!entry.inUse && (leastRecentlyUsed == nullptr || entry.lastUse < leastRecentlyUsed->lastUse)) {
+      leastRecentlyUsed = &entry;
+    }
+  }
+  if (leastRecentlyUsed != nullptr) {
+    Release(*leastRecentlyUsed);
+  }
+  return leastRecentlyUsed;
+}
+
+bool FileCache::EvictLeastRecentlyUsed(States state) {
+  Entry* leastRecentlyUsed = nullptr;
+  for (auto& entry : entries) {
+    if (entry.state == state && !entry.inUse && (leastRecentlyUsed == nullptr || entry.lastUse < leastRecentlyUsed->lastUse)) {
+      leastRecentlyUsed = &entry;
+    }
+  }
+  if (leastRecentlyUsed == nullptr) {
+    return false;
+  }
+  Release(*leastRecentlyUsed);
+  return true;
+}
+
+void FileCache::Release(Entry& entry) {
+  if (entry.state == States::Open) {
+    filesystem.FileClose(&entry.file);
+  } else if (entry.state == States::Data) {
+    lv_mem_free(entry.data);
+    dataSize -= entry.size;
+  }
+  entry = {};
+}
+
+void FileCache::Invalidate() {
+  for (auto& entry : entries) {
+    if (entry.inUse) {
+      entry.stale = true;
+    } else if (entry.state != States::Free) {
+      Release(entry);
+    }
+  }
+}
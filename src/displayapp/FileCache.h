@@ -0,0 +1,95 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <lvgl/lvgl.h>
+#include "components/fs/FS.h"
+
+namespace Pinetime {
+  namespace Components {
+    /* Driver of the F: LVGL drive. LVGL opens an image file several times per lv_img_set_src() and again
+     * for every redraw, and each open walks the littlefs metadata. The most recently used files are kept:
+     * small ones in RAM, larger ones open, and files that don't exist are remembered as such.
+     * Everything is dropped as soon as something is written to the file system.
+     */
+    class FileCache {
+    public:
+      explicit FileCache(Pinetime::Controllers::FS& filesystem);
+
+      FileCache(const FileCache&) = delete;
+      FileCache& operator=(const FileCache&) = delete;
+      FileCache(FileCache&&) = delete;
+      FileCache& operator=(FileCache&&) = delete;
+
+      // Registers the F: drive
+      void Register();
+
+    private:
+      // Longer paths are not cached
+      static constexpr size_t maxPathLength = 48;
+      static constexpr uint8_t maxOpenFiles = 2;
+      static_assert(maxOpenFiles < Pinetime::Controllers::FS::longLivedFiles, "FS::longLivedFiles must count the open entries");
+      static constexpr uint32_t maxDataFileSize = 1024;
+      static constexpr uint32_t dataBudget = 2048;
+      // Smaller reads are served from a buffer filled with this many bytes
+      static constexpr uint16_t readAheadSize = 64;
+
+      enum class States : uint8_t { Free, Missing, Data, Open };
+
+      struct Entry {
+        States state = States::Free;
+        bool inUse = false;
+        // Invalidated while in use, released when closed
+        bool stale = false;
+        char path[maxPathLength] = {};
+        uint32_t size = 0;
+        uint32_t lastUse = 0;
+        uint8_t* data = nullptr;
+        lfs_file_t file = {};
+      };
+
+      // What LVGL allocates for every open file. file is only used when the file couldn't be cached.
+      struct File {
+        Entry* entry;
+        uint32_t position;
+        // Position of the littlefs file, seeks are only done when reading
+        uint32_t handlePosition;
+        // Read ahead: file data from bufferStart
+        uint32_t bufferStart;
+        uint16_t bufferSize;
+        uint8_t buffer[readAheadSize];
+        lfs_file_t file;
+      };
+
+      static lv_fs_res_t Open(lv_fs_drv_t* drv, void* file_p, const char* path, lv_fs_mode_t mode);
+      static lv_fs_res_t Close(lv_fs_drv_t* drv, void* file_p);
+      static lv_fs_res_t Read(lv_fs_drv_t* drv, void* file_p, void* buf, uint32_t btr, uint32_t* br);
+      static lv_fs_res_t Seek(lv_fs_drv_t* drv, void* file_p, uint32_t pos);
+      static lv_fs_res_t Tell(lv_fs_drv_t* drv, void* file_p, uint32_t* pos_p);
+      static lv_fs_res_t Size(lv_fs_drv_t* drv, void* file_p, uint32_t* size_p);
+      static lv_fs_res_t DirOpen(lv_fs_drv_t* drv, void* rddir_p, const char* path);
+      static lv_fs_res_t DirRead(lv_fs_drv_t* drv, void* rddir_p, char* fn);
+      static lv_fs_res_t DirClose(lv_fs_drv_t* drv, void* rddir_p);
+
+      lv_fs_res_t OpenFile(File& file, const char* path);
+      lv_fs_res_t OpenEntry(Entry& entry, const char* path);
+      lv_fs_res_t OpenUncached(File& file, const char* path);
+      void CloseFile(File& file);
+      lv_fs_res_t ReadFile(File& file, uint8_t* data, uint32_t size, uint32_t* read);
+      int ReadHandle(File& file, uint8_t* data, uint32_t size);
+      static lfs_file_t* Handle(File& file);
+
+      Entry* Find(const char* path);
+      Entry* Allocate();
+      bool EvictLeastRecentlyUsed(States state);
+      void Release(Entry& entry);
+      void Invalidate();
+
+      Pinetime::Controllers::FS& filesystem;
+      std::array<Entry, 4> entries;
+      uint32_t modificationCount = 0;
+      uint32_t dataSize = 0;
+      uint32_t clock = 0;
+    };
+  }
+}
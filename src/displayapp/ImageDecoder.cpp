@@ -0,0 +1,243 @@
+#include "displayapp/ImageDecoder.h"
+#include <algorithm>
+#include <cstring>
+#include <new>
+
+using namespace Pinetime::Components;
+
+namespace {
+  struct Header {
+    uint8_t colorFormat;
+    uint8_t linesPerIndex;
+    uint8_t reserved[2];
+  };
+
+  static_assert(sizeof(lv_img_header_t) == 4 && sizeof(Header) == 4, "The file layout depends on these sizes");
+
+  struct Session {
+    lv_fs_file_t file;
+    lv_img_cf_t colorFormat;
+    uint8_t linesPerIndex;
+    // Size of the pixels the data is made of, and of a decoded line in the file format
+    uint8_t unitSize;
+    uint16_t lineSize;
+    lv_color_t palette[2];
+    lv_opa_t paletteOpa[2];
+    uint32_t indexStart;
+    uint32_t dataStart;
+    // Line the file is positioned at and line held by line[]
+    lv_coord_t nextLine;
+    lv_coord_t decodedLine;
+    uint8_t input[64];
+    uint8_t inputPosition;
+    uint8_t inputSize;
+    // lineSize bytes, allocated right after the session
+    uint8_t* line;
+  };
+
+  bool ReadHeaders(lv_fs_file_t* file, lv_img_header_t* imageHeader, Header* header) {
+    uint32_t read = 0;
+    if (lv_fs_read(file, imageHeader, sizeof(*imageHeader), &read) != LV_FS_RES_OK || read != sizeof(*imageHeader) ||
+        imageHeader->cf != LV_IMG_CF_USER_ENCODED_0) {
+      return false;
+    }
+    if (lv_fs_read(file, header, sizeof(*header), &read) != LV_FS_RES_OK || read != sizeof(*header) || header->linesPerIndex == 0) {
+      return false;
+    }
+    return header->colorFormat == LV_IMG_CF_TRUE_COLOR || header->colorFormat == LV_IMG_CF_TRUE_COLOR_ALPHA ||
+           header->colorFormat == LV_IMG_CF_INDEXED_1BIT;
+  }
+
+  bool Read(Session& session, uint8_t* data, size_t size) {
+    while (size > 0) {
+      if (session.inputPosition == session.inputSize) {
+        uint32_t read = 0;
+        if (lv_fs_read(&session.file, session.input, sizeof(session.input), &read) != LV_FS_RES_OK || read == 0) {
+          return false;
+        }
+        session.inputPosition = 0;
+        session.inputSize = read;
+      }
+      const size_t chunk = std::min<size_t>(size, session.inputSize - session.inputPosition);
+      std::memcpy(data, session.input + session.inputPosition, chunk);
+      session.inputPosition += chunk;
+      data += chunk;
+      size -= chunk;
+    }
+    return true;
+  }
+
+  bool Seek(Session& session, lv_coord_t line) {
+    const uint32_t entry = line / session.linesPerIndex;
+    uint32_t offset = 0;
+    uint32_t read = 0;
+    if (lv_fs_seek(&session.file, session.indexStart + (entry * sizeof(offset))) != LV_FS_RES_OK ||
+        lv_fs_read(&session.file, &offset, sizeof(offset), &read) != LV_FS_RES_OK || read != sizeof(offset) ||
+        lv_fs_seek(&session.file, session.dataStart + offset) != LV_FS_RES_OK) {
+      return false;
+    }
+    session.inputPosition = 0;
+    session.inputSize = 0;
+    session.nextLine = entry * session.linesPerIndex;
+    return true;
+  }
+
+  bool DecodeLine(Session& session) {
+    const uint8_t unitSize = session.unitSize;
+    uint16_t decoded = 0;
+    while (decoded < session.lineSize) {
+      uint8_t control;
+      if (!Read(session, &control, 1)) {
+        return false;
+      }
+      const bool repeat = control >= 128;
+      const uint16_t size = (repeat ? control - 126 : control + 1) * unitSize;
+      if (decoded + size > session.lineSize) {
+        return false;
+      }
+      uint8_t* destination = session.line + decoded;
+      if (!Read(session, destination, repeat ? unitSize : size)) {
+        return false;
+      }
+      if (repeat) {
+        for (uint16_t i = unitSize; i < size; i += unitSize) {
+          std::memcpy(destination + i, destination, unitSize);
+        }
+      }
+      decoded += size;
+    }
+    session.decodedLine = session.nextLine;
+    session.nextLine++;
+    return true;
+  }
+}
+
+void ImageDecoder::Register() {
+  lv_img_decoder_t* decoder = lv_img_decoder_create();
+  lv_img_decoder_set_info_cb(decoder, Info);
+  lv_img_decoder_set_open_cb(decoder, Open);
+  lv_img_decoder_set_read_line_cb(decoder, ReadLine);
+  lv_img_decoder_set_close_cb(decoder, Close);
+}
+
+lv_res_t ImageDecoder::Info(lv_img_decoder_t* /*decoder*/, const void* src, lv_img_header_t* header) {
+  if (lv_img_src_get_type(src) != LV_IMG_SRC_FILE) {
+    return LV_RES_INV;
+  }
+  lv_fs_file_t file;
+  if (lv_fs_open(&file, static_cast<const char*>(src), LV_FS_MODE_RD) != LV_FS_RES_OK) {
+    return LV_RES_INV;
+  }
+  Header fileHeader;
+  const bool valid = ReadHeaders(&file, header, &fileHeader);
+  lv_fs_close(&file);
+  if (!valid) {
+    return LV_RES_INV;
+  }
+  // Report the format of the decoded pixels so that LVGL draws them as it does uncompressed images
+  header->cf = fileHeader.colorFormat;
+  return LV_RES_OK;
+}
+
+lv_res_t ImageDecoder::Open(lv_img_decoder_t* /*decoder*/, lv_img_decoder_dsc_t* dsc) {
+  if (dsc->src_type != LV_IMG_SRC_FILE) {
+    return LV_RES_INV;
+  }
+  lv_fs_file_t file;
+  if (lv_fs_open(&file, static_cast<const char*>(dsc->src), LV_FS_MODE_RD) != LV_FS_RES_OK) {
+    return LV_RES_INV;
+  }
+  lv_img_header_t imageHeader;
+  Header header;
+  if (!ReadHeaders(&file, &imageHeader, &header)) {
+    lv_fs_close(&file);
+    return LV_RES_INV;
+  }
+
+  const auto colorFormat = static_cast<lv_img_cf_t>(header.colorFormat);
+  const uint8_t unitSize = (colorFormat == LV_IMG_CF_INDEXED_1BIT) ? 1 : lv_img_cf_get_px_size(colorFormat) / 8;
+  const uint16_t lineSize = (colorFormat == LV_IMG_CF_INDEXED_1BIT) ? (imageHeader.w + 7) / 8 : imageHeader.w * unitSize;
+  void* memory = lv_mem_alloc(sizeof(Session) + lineSize);
+  if (memory == nullptr) {
+    lv_fs_close(&file);
+    return LV_RES_INV;
+  }
+  auto* session = new (memory) Session {};
+  dsc->user_data = session;
+  session->file = file;
+  session->colorFormat = colorFormat;
+  session->linesPerIndex = header.linesPerIndex;
+  session->unitSize = unitSize;
+  session->lineSize = lineSize;
+  session->indexStart = sizeof(imageHeader) + sizeof(header);
+  session->nextLine = -1;
+  session->decodedLine = -1;
+  session->line = static_cast<uint8_t*>(memory) + sizeof(Session);
+
+  if (colorFormat == LV_IMG_CF_INDEXED_1BIT) {
+    lv_color32_t palette[2];
+    uint32_t read = 0;
+    if (lv_fs_read(&file, palette, sizeof(palette), &read) != LV_FS_RES_OK || read != sizeof(palette)) {
+      Close(nullptr, dsc);
+      return LV_RES_INV;
+    }
+    for (uint8_t i = 0; i < 2; i++) {
+      session->palette[i] = lv_color_make(palette[i].ch.red, palette[i].ch.green, palette[i].ch.blue);
+      session->paletteOpa[i] = palette[i].ch.alpha;
+    }
+    session->indexStart += sizeof(palette);
+  }
+  const uint32_t nbIndexEntries = (imageHeader.h + header.linesPerIndex - 1) / header.linesPerIndex;
+  session->dataStart = session->indexStart + (nbIndexEntries * sizeof(uint32_t));
+
+  // No image data: LVGL reads it line by line with ReadLine()
+  dsc->img_data = nullptr;
+  return LV_RES_OK;
+}
+
+lv_res_t ImageDecoder::ReadLine(lv_img_decoder_t* /*decoder*/,
+                                lv_img_decoder_dsc_t* dsc,
+                                lv_coord_t x,
+                                lv_coord_t y,
+                                lv_coord_t len,
+                                uint8_t* buf) {
+  auto& session = *static_cast<Session*>(dsc->user_data);
+  if (y != session.decodedLine) {
+    // Decoding the lines in between is cheaper than seeking unless the next index entry is closer
+    const bool seek = (session.nextLine < 0) || (y < session.nextLine) ||
+                      (y / session.linesPerIndex != session.nextLine / session.linesPerIndex);
+    if (seek && !Seek(session, y)) {
+      return LV_RES_INV;
+    }
+    while (session.decodedLine != y) {
+      if (!DecodeLine(session)) {
+        session.decodedLine = -1;
+        session.nextLine = -1;
+        return LV_RES_INV;
+      }
+    }
+  }
+
+  if (session.colorFormat != LV_IMG_CF_INDEXED_1BIT) {
+    std::memcpy(buf, session.line + (x * session.unitSize), len * session.unitSize);
+    return LV_RES_OK;
+  }
+  for (lv_coord_t i = 0; i < len; i++) {
+    const lv_coord_t pixel = x + i;
+    const uint8_t index = (session.line[pixel >> 3] >> (7 - (pixel & 0x07))) & 0x01;
+    std::memcpy(buf, &session.palette[index], sizeof(lv_color_t));
+    buf[sizeof(lv_color_t)] = session.paletteOpa[index];
+    buf += LV_IMG_PX_SIZE_ALPHA_BYTE;
+  }
+  return LV_RES_OK;
+}
+
+void ImageDecoder::Close(lv_img_decoder_t* /*decoder*/, lv_img_decoder_dsc_t* dsc) {
+  auto* session = static_cast<Session*>(dsc->user_data);
+  if (session == nullptr) {
+    return;
+  }
+  lv_fs_close(&session->file);
+  lv_mem_free(session);
+  dsc->user_data = nullptr;
+}
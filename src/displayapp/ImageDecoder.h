@@ -0,0 +1,32 @@
+#pragma once
+
+#include <lvgl/lvgl.h>
+
+namespace Pinetime {
+  namespace Components {
+    /* LVGL decoder for images compressed by lv_img_conv.py --compress (LV_IMG_CF_USER_ENCODED_0 files).
+     *
+     * File layout, after the usual 4 bytes LVGL image header:
+     *  - decoded color format (LV_IMG_CF_TRUE_COLOR, LV_IMG_CF_TRUE_COLOR_ALPHA or LV_IMG_CF_INDEXED_1BIT),
+     *    number of lines per index entry, 2 reserved bytes
+     *  - the palette (2 x lv_color32_t) for indexed images
+     *  - the index: offset of every linesPerIndex-th line from the start of the data (uint32_t)
+     *  - the data: every line PackBits encoded on its own. A control byte c < 128 is followed by c + 1 raw
+     *    pixels, c >= 128 by a pixel repeated c - 126 times. A pixel is 1 byte (8 pixels) for indexed images.
+     *
+     * Lines are decoded one at a time into a line buffer, the index allows seeking to any line
+     * (e.g. icons in an atlas) without decoding the whole image.
+     */
+    class ImageDecoder {
+    public:
+      static void Register();
+
+    private:
+      static lv_res_t Info(lv_img_decoder_t* decoder, const void* src, lv_img_header_t* header);
+      static lv_res_t Open(lv_img_decoder_t* decoder, lv_img_decoder_dsc_t* dsc);
+      static lv_res_t
+      ReadLine(lv_img_decoder_t* decoder, lv_img_decoder_dsc_t* dsc, lv_coord_t x, lv_coord_t y, lv_coord_t len, uint8_t* buf);
+      static void Close(lv_img_decoder_t* decoder, lv_img_decoder_dsc_t* dsc);
+    };
+  }
+}
@@ -0,0 +1,621 @@
+#include "displayapp/LazyFont.h"
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <new>
+
+using namespace Pinetime::Components;
+
+namespace {
+  // Binary font layout, as written by lv_font_conv and read by LVGL's lv_font_load()
+  struct FontHeader {
+    uint32_t version;
+    uint16_t tablesCount;
+    uint16_t fontSize;
+    uint16_t ascent;
+    int16_t descent;
+    uint16_t typoAscent;
+    int16_t typoDescent;
+    uint16_t typoLineGap;
+    int16_t minY;
+    int16_t maxY;
+    uint16_t defaultAdvanceWidth;
+    uint16_t kerningScale;
+    uint8_t indexToLocFormat;
+    uint8_t glyphIdFormat;
+    uint8_t advanceWidthFormat;
+    uint8_t bitsPerPixel;
+    uint8_t xyBits;
+    uint8_t whBits;
+    uint8_t advanceWidthBits;
+    uint8_t compressionId;
+    uint8_t subpixelsMode;
+    uint8_t padding;
+  };
+
+  struct CmapTable {
+    uint32_t dataOffset;
+    uint32_t rangeStart;
+    uint16_t rangeLength;
+    uint16_t glyphIdStart;
+    uint16_t dataEntriesCount;
+    uint8_t formatType;
+    uint8_t padding;
+  };
+
+  static_assert(sizeof(FontHeader) == 36 && sizeof(CmapTable) == 16, "The file layout depends on these sizes");
+
+  enum class CmapTypes : uint8_t { Format0Full = 0, SparseFull = 1, Format0Tiny = 2, SparseTiny = 3 };
+  enum class KerningTypes : uint8_t { None, Pairs, Classes };
+
+  struct Cmap {
+    uint32_t rangeStart;
+    uint16_t rangeLength;
+    uint16_t glyphIdStart;
+    uint16_t listLength;
+    CmapTypes type;
+    uint16_t* unicodeList;
+    uint8_t* glyphIdOffsets;
+    uint16_t* sparseGlyphIdOffsets;
+  };
+
+  struct Glyph {
+    // Position of the bitmap in the file, it starts bitmapShift bits into this byte
+    uint32_t bitmapOffset;
+    uint16_t bitmapSize;
+    // In 1/16 px
+    uint16_t advanceWidth;
+    uint8_t boxWidth;
+    uint8_t boxHeight;
+    int8_t offsetX;
+    int8_t offsetY;
+    uint8_t bitmapShift;
+  };
+
+  struct Font {
+    lv_font_t font;
+    // Open while the font is loaded, bitmaps are read from it
+    lv_fs_file_t file;
+    uint8_t bpp;
+    uint16_t kerningScale;
+    uint16_t nbCmaps;
+    Cmap* cmaps;
+    uint32_t nbGlyphs;
+    Glyph* glyphs;
+
+    KerningTypes kerning;
+    bool wideGlyphIds;
+    uint32_t nbPairs;
+    uint8_t* pairGlyphIds;
+    int8_t* pairValues;
+    uint16_t classMappingLength;
+    uint8_t nbLeftClasses;
+    uint8_t nbRightClasses;
+    uint8_t* leftClassMapping;
+    uint8_t* rightClassMapping;
+    int8_t* classValues;
+  };
+
+  bool ReadExact(lv_fs_file_t* file, void* data, uint32_t size) {
+    uint32_t read = 0;
+    return lv_fs_read(file, data, size, &read) == LV_FS_RES_OK && read == size;
+  }
+
+  template <typename T>
+  T* AllocateArray(uint32_t count) {
+    void* memory = lv_mem_alloc(count * sizeof(T));
+    if (memory != nullptr) {
+      std::memset(memory, 0, count * sizeof(T));
+    }
+    return static_cast<T*>(memory);
+  }
+
+  template <typename T>
+  bool ReadArray(lv_fs_file_t* file, T*& array, uint32_t count) {
+    array = AllocateArray<T>(count);
+    return array != nullptr && ReadExact(file, array, count * sizeof(T));
+  }
+
+  void Release(void* memory) {
+    if (memory != nullptr) {
+      lv_mem_free(memory);
+    }
+  }
+
+  // Return the length of the table starting at start, or -1 if it isn't labeled label
+  int32_t ReadLabel(lv_fs_file_t* file, uint32_t start, const char* label) {
+    uint32_t length;
+    char tag[4];
+    if (lv_fs_seek(file, start) != LV_FS_RES_OK || !ReadExact(file, &length, sizeof(length)) || !ReadExact(file, tag, sizeof(tag)) ||
+        std::memcmp(tag, label, sizeof(tag)) != 0) {
+      return -1;
+    }
+    return length;
+  }
+
+  // Glyph descriptions are bit fields, MSB first
+  class BitReader {
+  public:
+    explicit BitReader(const uint8_t* data) : data {data} {
+    }
+
+    uint32_t Read(uint8_t nbBits) {
+      uint32_t value = 0;
+      for (; nbBits > 0; nbBits--, position++) {
+        value = (value << 1) | ((data[position / 8] >> (7 - (position % 8))) & 0x01);
+      }
+      return value;
+    }
+
+    int32_t ReadSigned(uint8_t nbBits) {
+      uint32_t value = Read(nbBits);
+      if (nbBits > 0 && (value & (1u << (nbBits - 1))) != 0) {
+        value |= ~0u << nbBits;
+      }
+      return static_cast<int32_t>(value);
+    }
+
+  private:
+    const uint8_t* data;
+    uint32_t position = 0;
+  };
+
+  int32_t LoadCmaps(lv_fs_file_t* file, Font& font, uint32_t start) {
+    const int32_t length = ReadLabel(file, start, "cmap");
+    uint32_t nbCmaps;
+    if (length < 0 || !ReadExact(file, &nbCmaps, sizeof(nbCmaps))) {
+      return -1;
+    }
+    CmapTable* tables = nullptr;
+    font.cmaps = AllocateArray<Cmap>(nbCmaps);
+    if (font.cmaps == nullptr || !ReadArray(file, tables, nbCmaps)) {
+      Release(tables);
+      return -1;
+    }
+    font.nbCmaps = nbCmaps;
+
+    bool success = true;
+    for (uint32_t i = 0; i < nbCmaps && success; i++) {
+      const CmapTable& table = tables[i];
+      Cmap& cmap = font.cmaps[i];
+      cmap.rangeStart = table.rangeStart;
+      cmap.rangeLength = table.rangeLength;
+      cmap.glyphIdStart = table.glyphIdStart;
+      cmap.type = static_cast<CmapTypes>(table.formatType);
+      success = lv_fs_seek(file, start + table.dataOffset) == LV_FS_RES_OK;
+      switch (cmap.type) {
+        case CmapTypes::Format0Full:
+          cmap.listLength = table.rangeLength;
+          success = success && ReadArray(file, cmap.glyphIdOffsets, table.dataEntriesCount);
+          break;
+        case CmapTypes::Format0Tiny:
+          break;
+        case CmapTypes::SparseFull:
+        case CmapTypes::SparseTiny:
+          cmap.listLength = table.dataEntriesCount;
+          success = success && ReadArray(file, cmap.unicodeList, table.dataEntriesCount);
+          if (cmap.type == CmapTypes::SparseFull) {
+            success = success && ReadArray(file, cmap.sparseGlyphIdOffsets, table.dataEntriesCount);
+          }
+          break;
+        default:
+          success = false;
+          break;
+      }
+    }
+    Release(tables);
+    return success ? length : -1;
+  }
+
+  int32_t LoadGlyphs(lv_fs_file_t* file, Font& font, const FontHeader& header, uint32_t start, const uint32_t* offsets) {
+    const int32_t length = ReadLabel(file, start, "glyf");
+    font.glyphs = AllocateArray<Glyph>(font.nbGlyphs);
+    if (length < 0 || font.glyphs == nullptr) {
+      return -1;
+    }
+
+    const uint32_t nbBits = header.advanceWidthBits + (2 * header.xyBits) + (2 * header.whBits);
+    std::array<uint8_t, 8> description;
+    if (nbBits > description.size() * 8) {
+      return -1;
+    }
+    // Glyph 0 is reserved and stays empty
+    for (uint32_t i = 1; i < font.nbGlyphs; i++) {
+      const uint32_t next = (i < font.nbGlyphs - 1) ? offsets[i + 1] : length;
+      if (lv_fs_seek(file, start + offsets[i]) != LV_FS_RES_OK || !ReadExact(file, description.data(), (nbBits + 7) / 8)) {
+        return -1;
+      }
+      BitReader reader {description.data()};
+      Glyph& glyph = font.glyphs[i];
+      glyph.advanceWidth = (header.advanceWidthBits == 0) ? header.defaultAdvanceWidth : reader.Read(header.advanceWidthBits);
+      if (header.advanceWidthFormat == 0) {
+        glyph.advanceWidth *= 16;
+      }
+      glyph.offsetX = reader.ReadSigned(header.xyBits);
+      glyph.offsetY = reader.ReadSigned(header.xyBits);
+      glyph.boxWidth = reader.Read(header.whBits);
+      glyph.boxHeight = reader.Read(header.whBits);
+      glyph.bitmapOffset = start + offsets[i] + (nbBits / 8);
+      glyph.bitmapShift = nbBits % 8;
+      if (glyph.boxWidth * glyph.boxHeight != 0) {
+        glyph.bitmapSize = next - offsets[i] - (nbBits / 8);
+      }
+    }
+    return length;
+  }
+
+  bool LoadKerning(lv_fs_file_t* file, Font& font, uint32_t start) {
+    uint8_t format[4];
+    if (ReadLabel(file, start, "kern") < 0 || !ReadExact(file, format, sizeof(format))) {
+      return false;
+    }
+    if (format[0] == 0) {
+      // Sorted pairs of glyph ids
+      uint32_t nbPairs;
+      if (!ReadExact(file, &nbPairs, sizeof(nbPairs))) {
+        return false;
+      }
+      font.nbPairs = nbPairs;
+      const uint32_t idsSize = nbPairs * 2 * (font.wideGlyphIds ? sizeof(uint16_t) : sizeof(uint8_t));
+      if (!ReadArray(file, font.pairGlyphIds, idsSize) || !ReadArray(file, font.pairValues, nbPairs)) {
+        return false;
+      }
+      font.kerning = KerningTypes::Pairs;
+      return true;
+    }
+    if (format[0] == 3) {
+      // Left and right classes of every glyph, and the value of every pair of classes
+      uint16_t mappingLength;
+      if (!ReadExact(file, &mappingLength, sizeof(mappingLength)) || !ReadExact(file, &font.nbLeftClasses, 1) ||
+          !ReadExact(file, &font.nbRightClasses, 1)) {
+        return false;
+      }
+      font.classMappingLength = mappingLength;
+      if (!ReadArray(file, font.leftClassMapping, mappingLength) || !ReadArray(file, font.rightClassMapping, mappingLength) ||
+          !ReadArray(file, font.classValues, font.nbLeftClasses * font.nbRightClasses)) {
+        return false;
+      }
+      font.kerning = KerningTypes::Classes;
+      return true;
+    }
+    return false;
+  }
+
+  bool LoadFont(lv_fs_file_t* file, Font& font) {
+    FontHeader header;
+    const int32_t headerLength = ReadLabel(file, 0, "head");
+    // Compressed bitmaps would have to be decompressed for every draw, they are not supported
+    if (headerLength < 0 || !ReadExact(file, &header, sizeof(header)) || header.compressionId != 0) {
+      return false;
+    }
+    font.font.line_height = header.ascent - header.descent;
+    font.font.base_line = -header.descent;
+    font.font.subpx = header.subpixelsMode;
+    font.bpp = header.bitsPerPixel;
+    font.kerningScale = header.kerningScale;
+    font.wideGlyphIds = header.glyphIdFormat != 0;
+
+    const uint32_t cmapsStart = headerLength;
+    const int32_t cmapsLength = LoadCmaps(file, font, cmapsStart);
+    if (cmapsLength < 0) {
+      return false;
+    }
+
+    // Glyph offsets are only needed while loading: the glyph descriptions store where their bitmap is
+    const uint32_t locaStart = cmapsStart + cmapsLength;
+    const int32_t locaLength = ReadLabel(file, locaStart, "loca");
+    uint32_t nbGlyphs;
+    if (locaLength < 0 || !ReadExact(file, &nbGlyphs, sizeof(nbGlyphs)) || nbGlyphs == 0) {
+      return false;
+    }
+    font.nbGlyphs = nbGlyphs;
+    uint32_t* offsets = AllocateArray<uint32_t>(nbGlyphs);
+    bool success = offsets != nullptr;
+    for (uint32_t i = 0; i < nbGlyphs && success; i++) {
+      if (header.indexToLocFormat == 0) {
+        uint16_t offset = 0;
+        success = ReadExact(file, &offset, sizeof(offset));
+        offsets[i] = offset;
+      } else {
+        success = ReadExact(file, &offsets[i], sizeof(offsets[i]));
+      }
+    }
+
+    const uint32_t glyphsStart = locaStart + locaLength;
+    const int32_t glyphsLength = success ? LoadGlyphs(file, font, header, glyphsStart, offsets) : -1;
+    Release(offsets);
+    if (glyphsLength < 0) {
+      return false;
+    }
+
+    // The kerning table is optional, a font without it is still usable
+    if (header.tablesCount >= 4 && !LoadKerning(file, font, glyphsStart + glyphsLength)) {
+      font.kerning = KerningTypes::None;
+    }
+    return true;
+  }
+
+  void ReleaseFont(Font& font) {
+    for (uint16_t i = 0; font.cmaps != nullptr && i < font.nbCmaps; i++) {
+      Release(font.cmaps[i].unicodeList);
+      Release(font.cmaps[i].glyphIdOffsets);
+      Release(font.cmaps[i].sparseGlyphIdOffsets);
+    }
+    Release(font.cmaps);
+    Release(font.glyphs);
+    Release(font.pairGlyphIds);
+    Release(font.pairValues);
+    Release(font.leftClassMapping);
+    Release(font.rightClassMapping);
+    Release(font.classValues);
+  }
+
+  uint32_t GlyphId(const Font& font, uint32_t letter) {
+    for (uint16_t i = 0; i < font.nbCmaps; i++) {
+      const Cmap& cmap = font.cmaps[i];
+      if (letter < cmap.rangeStart || letter - cmap.rangeStart >= cmap.rangeLength) {
+        continue;
+      }
+      const uint32_t codePoint = letter - cmap.rangeStart;
+      uint32_t glyphId = 0;
+      if (cmap.type == CmapTypes::Format0Tiny) {
+        glyphId = cmap.glyphIdStart + codePoint;
+      } else if (cmap.type == CmapTypes::Format0Full) {
+        glyphId = cmap.glyphIdStart + cmap.glyphIdOffsets[codePoint];
+      } else {
+        const uint16_t* begin = cmap.unicodeList;
+        const uint16_t* end = begin + cmap.listLength;
+        const uint16_t* found = std::lower_bound(begin, end, codePoint);
+        if (found == end || *found != codePoint) {
+          continue;
+        }
+        const uint32_t index = found - begin;
+        glyphId = cmap.glyphIdStart + ((cmap.type == CmapTypes::SparseFull) ? cmap.sparseGlyphIdOffsets[index] : index);
+      }
+      return (glyphId < font.nbGlyphs) ? glyphId : 0;
+    }
+    return 0;
+  }
+
+  template <typename T>
+  int8_t PairValue(const Font& font, uint32_t left, uint32_t right) {
+    const T* ids = reinterpret_cast<const T*>(font.pairGlyphIds);
+    uint32_t low = 0;
+    uint32_t high = font.nbPairs;
+    while (low < high) {
+      const uint32_t middle = (low + high) / 2;
+      const T middleLeft = ids[middle * 2];
+      const T middleRight = ids[(middle * 2) + 1];
+      if (middleLeft == left && middleRight == right) {
+        return font.pairValues[middle];
+      }
+      if (middleLeft < left || (middleLeft == left && middleRight < right)) {
+        low = middle + 1;
+      } else {
+        high = middle;
+      }
+    }
+    return 0;
+  }
+
+  int8_t KerningValue(const Font& font, uint32_t left, uint32_t right) {
+    if (font.kerning == KerningTypes::Pairs) {
+      return font.wideGlyphIds ? PairValue<uint16_t>(font, left, right) : PairValue<uint8_t>(font, left, right);
+    }
+    if (font.kerning == KerningTypes::Classes && left < font.classMappingLength && right < font.classMappingLength) {
+      const uint8_t leftClass = font.leftClassMapping[left];
+      const uint8_t rightClass = font.rightClassMapping[right];
+      if (leftClass > 0 && rightClass > 0) {
+        return font.classValues[((leftClass - 1) * font.nbRightClasses) + (rightClass - 1)];
+      }
+    }
+    return 0;
+  }
+
+  bool ReadBitmap(Font& font, const Glyph& glyph, uint8_t* bitmap) {
+    const bool success = lv_fs_seek(&font.file, glyph.bitmapOffset) == LV_FS_RES_OK && ReadExact(&font.file, bitmap, glyph.bitmapSize);
+
+    // Bitmaps follow the bit fields of the glyph description, realign them on a byte boundary
+    const uint8_t shift = glyph.bitmapShift;
+    if (success && shift != 0) {
+      for (uint16_t i = 0; i < glyph.bitmapSize; i++) {
+        const uint8_t next = (i + 1 < glyph.bitmapSize) ? bitmap[i + 1] >> (8 - shift) : 0;
+        bitmap[i] = (bitmap[i] << shift) | next;
+      }
+    }
+    return success;
+  }
+
+  /* Glyph bitmaps allocated from the LVGL heap, up to a total size of budget (unless a single glyph is bigger).
+   * LVGL draws the screen in strips of a few lines and asks again for the bitmap of every glyph crossing each
+   * strip. When a strip crosses more glyphs than the cache holds, least recently used eviction would drop every
+   * glyph just before it is needed again: the glyphs that don't fit are then read into a buffer of their own
+   * instead, so that the others stay cached.
+   */
+  class GlyphCache {
+  public:
+    const uint8_t* Get(Font& font, uint32_t glyphId) {
+      clock++;
+      ReleaseUncached();
+      for (auto& entry : entries) {
+        if (entry.bitmap != nullptr && entry.font == &font && entry.glyphId == glyphId) {
+          entry.lastUse = clock;
+          statistics.hits++;
+          return entry.bitmap;
+        }
+      }
+      statistics.misses++;
+
+      const Glyph& glyph = font.glyphs[glyphId];
+      auto slot = entries.end();
+      while (true) {
+        slot = std::find_if(entries.begin(), entries.end(), [](const Entry& entry) {
+          return entry.bitmap == nullptr;
+        });
+        if (slot != entries.end() && used + glyph.bitmapSize <= budget) {
+          break;
+        }
+        Entry* leastRecentlyUsed = nullptr;
+        for (auto& entry : entries) {
+          if (entry.bitmap != nullptr && (leastRecentlyUsed == nullptr || entry.lastUse < leastRecentlyUsed->lastUse)) {
+            leastRecentlyUsed = &entry;
+          }
+        }
+        if (leastRecentlyUsed == nullptr) {
+          break;
+        }
+        // Every glyph left was asked for during the last entries.size() calls: they are all being drawn
+        if (clock - leastRecentlyUsed->lastUse <= entries.size()) {
+          slot = entries.end();
+          break;
+        }
+        Evict(*leastRecentlyUsed);
+      }
+
+      auto* bitmap = static_cast<uint8_t*>(lv_mem_alloc(glyph.bitmapSize));
+      if (bitmap == nullptr) {
+        return nullptr;
+      }
+      if (!ReadBitmap(font, glyph, bitmap)) {
+        lv_mem_free(bitmap);
+        return nullptr;
+      }
+      if (slot == entries.end()) {
+        uncached = bitmap;
+        return bitmap;
+      }
+      *slot = {&font, static_cast<uint16_t>(glyphId), glyph.bitmapSize, clock, bitmap};
+      used += glyph.bitmapSize;
+      return bitmap;
+    }
+
+    void EvictFont(const Font& font) {
+      ReleaseUncached();
+      for (auto& entry : entries) {
+        if (entry.bitmap != nullptr && entry.font == &font) {
+          Evict(entry);
+        }
+      }
+    }
+
+    LazyFont::CacheStatistics GetStatistics() const {
+      return statistics;
+    }
+
+  private:
+    struct Entry {
+      const Font* font = nullptr;
+      uint16_t glyphId = 0;
+      uint16_t size = 0;
+      uint32_t lastUse = 0;
+      uint8_t* bitmap = nullptr;
+    };
+
+    void Evict(Entry& entry) {
+      lv_mem_free(entry.bitmap);
+      used -= entry.size;
+      entry = {};
+    }
+
+    void ReleaseUncached() {
+      if (uncached != nullptr) {
+        lv_mem_free(uncached);
+        uncached = nullptr;
+      }
+    }
+
+    // A strip of the Casio face crosses up to 9 glyphs of 2 fonts, the 5 digits of its time take 2.7 KB
+    static constexpr size_t budget = 4096;
+    std::array<Entry, 16> entries;
+    size_t used = 0;
+    uint32_t clock = 0;
+    // Bitmap of the last glyph that wasn't cached, released on the next call
+    uint8_t* uncached = nullptr;
+    LazyFont::CacheStatistics statistics;
+  };
+
+  GlyphCache glyphCache;
+
+  bool GetGlyphDsc(const lv_font_t* lvFont, lv_font_glyph_dsc_t* dsc, uint32_t letter, uint32_t letterNext) {
+    const auto& font = *static_cast<const Font*>(lvFont->dsc);
+    // Tabs are drawn as 2 spaces, like lv_font_fmt_txt does
+    const bool isTab = letter == '\t';
+    const uint32_t glyphId = GlyphId(font, isTab ? ' ' : letter);
+    if (glyphId == 0) {
+      return false;
+    }
+
+    int32_t kerning = 0;
+    if (letterNext != 0 && font.kerning != KerningTypes::None) {
+      const uint32_t nextGlyphId = GlyphId(font, letterNext);
+      if (nextGlyphId != 0) {
+        kerning = (static_cast<int32_t>(KerningValue(font, glyphId, nextGlyphId)) * font.kerningScale) >> 4;
+      }
+    }
+
+    const Glyph& glyph = font.glyphs[glyphId];
+    int32_t advanceWidth = glyph.advanceWidth * (isTab ? 2 : 1);
+    advanceWidth += kerning;
+    dsc->adv_w = (advanceWidth + (1 << 3)) >> 4;
+    dsc->box_w = glyph.boxWidth * (isTab ? 2 : 1);
+    dsc->box_h = glyph.boxHeight;
+    dsc->ofs_x = glyph.offsetX;
+    dsc->ofs_y = glyph.offsetY;
+    dsc->bpp = font.bpp;
+    return true;
+  }
+
+  const uint8_t* GetGlyphBitmap(const lv_font_t* lvFont, uint32_t letter) {
+    auto& font = *static_cast<Font*>(const_cast<void*>(lvFont->dsc));
+    const uint32_t glyphId = GlyphId(font, (letter == '\t') ? ' ' : letter);
+    if (glyphId == 0 || font.glyphs[glyphId].bitmapSize == 0) {
+      return nullptr;
+    }
+    // Only valid until the next call: LVGL draws a glyph right after getting its bitmap
+    return glyphCache.Get(font, glyphId);
+  }
+}
+
+lv_font_t* LazyFont::Load(const char* path) {
+  void* memory = lv_mem_alloc(sizeof(Font));
+  if (memory == nullptr) {
+    return nullptr;
+  }
+  auto* font = new (memory) Font {};
+  if (lv_fs_open(&font->file, path, LV_FS_MODE_RD) != LV_FS_RES_OK) {
+    lv_mem_free(font);
+    return nullptr;
+  }
+  if (!LoadFont(&font->file, *font)) {
+    lv_fs_close(&font->file);
+    ReleaseFont(*font);
+    lv_mem_free(font);
+    return nullptr;
+  }
+
+  font->font.dsc = font;
+  font->font.get_glyph_dsc = GetGlyphDsc;
+  font->font.get_glyph_bitmap = GetGlyphBitmap;
+  return &font->font;
+}
+
+void LazyFont::Free(lv_font_t* lvFont) {
+  auto* font = static_cast<Font*>(const_cast<void*>(lvFont->dsc));
+  glyphCache.EvictFont(*font);
+  lv_fs_close(&font->file);
+  ReleaseFont(*font);
+  lv_mem_free(font);
+}
+
+LazyFont::CacheStatistics LazyFont::GetCacheStatistics() {
+  return glyphCache.GetStatistics();
+}
+
+uint8_t LazyFont::CacheHitRate() {
+  const CacheStatistics statistics = glyphCache.GetStatistics();
+  const uint32_t total = statistics.hits + statistics.misses;
+  if (total == 0) {
+    return 0;
+  }
+  return static_cast<uint8_t>((static_cast<uint64_t>(statistics.hits) * 100) / total);
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstdint>
+#include <lvgl/lvgl.h>
+
+namespace Pinetime {
+  namespace Components {
+    /* Loads binary fonts (lv_font_conv --format bin) like lv_font_load(), but only keeps the header, the
+     * character maps, the kerning and the glyph descriptions in RAM. The file stays open until the font is
+     * freed: glyph bitmaps are read from it when they are drawn and kept in a small LRU cache shared by all
+     * the fonts loaded this way.
+     */
+    class LazyFont {
+    public:
+      struct CacheStatistics {
+        uint32_t hits = 0;
+        uint32_t misses = 0;
+      };
+
+      // Return nullptr if the file can't be opened or isn't a valid font
+      static lv_font_t* Load(const char* path);
+      static void Free(lv_font_t* font);
+
+      static CacheStatistics GetCacheStatistics();
+
+      // Percentage of glyphs drawn from the cache since boot
+      static uint8_t CacheHitRate();
+    };
+  }
+}
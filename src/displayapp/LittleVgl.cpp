@@ -1,8 +1,10 @@
 #include "displayapp/LittleVgl.h"
 #include "displayapp/InfiniTimeTheme.h"
+#include "displayapp/ImageDecoder.h"
 
 #include <FreeRTOS.h>
 #include <task.h>
+#include <algorithm>
 #include "drivers/St7789.h"
 #include "littlefs/lfs.h"
 #include "components/fs/FS.h"
@@ -14,43 +16,6 @@ namespace {
     lv_theme_t* theme = lv_pinetime_theme_init();
     lv_theme_set_act(theme);
   }
-
-  lv_fs_res_t lvglOpen(lv_fs_drv_t* drv, void* file_p, const char* path, lv_fs_mode_t /*mode*/) {
-    lfs_file_t* file = static_cast<lfs_file_t*>(file_p);
-    Pinetime::Controllers::FS* filesys = static_cast<Pinetime::Controllers::FS*>(drv->user_data);
-    int res = filesys->FileOpen(file, path, LFS_O_RDONLY);
-    if (res == 0) {
-      if (file->type == 0) {
-        return LV_FS_RES_FS_ERR;
-      } else {
-        return LV_FS_RES_OK;
-      }
-    }
-    return LV_FS_RES_NOT_EX;
-  }
-
-  lv_fs_res_t lvglClose(lv_fs_drv_t* drv, void* file_p) {
-    Pinetime::Controllers::FS* filesys = static_cast<Pinetime::Controllers::FS*>(drv->user_data);
-    lfs_file_t* file = static_cast<lfs_file_t*>(file_p);
-    filesys->FileClose(file);
-
-    return LV_FS_RES_OK;
-  }
-
-  lv_fs_res_t lvglRead(lv_fs_drv_t* drv, void* file_p, void* buf, uint32_t btr, uint32_t* br) {
-    Pinetime::Controllers::FS* filesys = static_cast<Pinetime::Controllers::FS*>(drv->user_data);
-    lfs_file_t* file = static_cast<lfs_file_t*>(file_p);
-    filesys->FileRead(file, static_cast<uint8_t*>(buf), btr);
-    *br = btr;
-    return LV_FS_RES_OK;
-  }
-
-  lv_fs_res_t lvglSeek(lv_fs_drv_t* drv, void* file_p, uint32_t pos) {
-    Pinetime::Controllers::FS* filesys = static_cast<Pinetime::Controllers::FS*>(drv->user_data);
-    lfs_file_t* file = static_cast<lfs_file_t*>(file_p);
-    filesys->FileSeek(file, pos);
-    return LV_FS_RES_OK;
-  }
 }
 
 static void disp_flush(lv_disp_drv_t* disp_drv, const lv_area_t* area, lv_color_t* color_p) {
@@ -58,6 +23,16 @@ static void disp_flush(lv_disp_drv_t* disp_drv, const lv_area_t* area, lv_color_
   lvgl->FlushDisplay(area, color_p);
 }
 
+static void disp_wait(lv_disp_drv_t* disp_drv) {
+  auto* lvgl = static_cast<LittleVgl*>(disp_drv->user_data);
+  lvgl->OnWaitForTransfer();
+}
+
+static void disp_monitor(lv_disp_drv_t* disp_drv, uint32_t /*time*/, uint32_t px) {
+  auto* lvgl = static_cast<LittleVgl*>(disp_drv->user_data);
+  lvgl->OnFrameDone(px);
+}
+
 static void rounder(lv_disp_drv_t* disp_drv, lv_area_t* area) {
   auto* lvgl = static_cast<LittleVgl*>(disp_drv->user_data);
   if (lvgl->GetFullRefresh()) {
@@ -66,6 +41,10 @@ static void rounder(lv_disp_drv_t* disp_drv, lv_area_t* area) {
     area->y1 = 0;
     area->y2 = LV_VER_RES - 1;
   }
+  // 2 pixels are packed in 3 bytes in low power mode, flush an even number of pixels per line.
+  // Round in all modes: the areas invalidated before entering low power mode are flushed after it.
+  area->x1 &= ~1;
+  area->x2 |= 1;
 }
 
 bool touchpad_read(lv_indev_drv_t* indev_drv, lv_indev_data_t* data) {
@@ -73,7 +52,10 @@ bool touchpad_read(lv_indev_drv_t* indev_drv, lv_indev_data_t* data) {
   return lvgl->GetTouchPadInfo(data);
 }
 
-LittleVgl::LittleVgl(Pinetime::Drivers::St7789& lcd, Pinetime::Controllers::FS& filesystem) : lcd {lcd}, filesystem {filesystem} {
+LittleVgl::LittleVgl(Pinetime::Drivers::St7789& lcd,
+                     Pinetime::Controllers::FS& filesystem,
+                     Pinetime::Controllers::FrameProfiler& frameProfiler)
+  : lcd {lcd}, filesystem {filesystem}, frameProfiler {frameProfiler}, fileCache {filesystem} {
 }
 
 void LittleVgl::Init() {
@@ -81,7 +63,8 @@ void LittleVgl::Init() {
   InitTheme();
   InitDisplay();
   InitTouchpad();
-  InitFileSystem();
+  fileCache.Register();
+  ImageDecoder::Register();
 }
 
 void LittleVgl::InitDisplay() {
@@ -100,6 +83,8 @@ void LittleVgl::InitDisplay() {
   disp_drv.buffer = &disp_buf_2;
   disp_drv.user_data = this;
   disp_drv.rounder_cb = rounder;
+  disp_drv.wait_cb = disp_wait;
+  disp_drv.monitor_cb = disp_monitor;
 
   /*Finally register the driver*/
   lv_disp_drv_register(&disp_drv);
@@ -115,22 +100,6 @@ void LittleVgl::InitTouchpad() {
   lv_indev_drv_register(&indev_drv);
 }
 
-void LittleVgl::InitFileSystem() {
-  lv_fs_drv_t fs_drv;
-  lv_fs_drv_init(&fs_drv);
-
-  fs_drv.file_size = sizeof(lfs_file_t);
-  fs_drv.letter = 'F';
-  fs_drv.open_cb = lvglOpen;
-  fs_drv.close_cb = lvglClose;
-  fs_drv.read_cb = lvglRead;
-  fs_drv.seek_cb = lvglSeek;
-
-  fs_drv.user_data = &filesystem;
-
-  lv_fs_drv_register(&fs_drv);
-}
-
 void LittleVgl::SetFullRefresh(FullRefreshDirections direction) {
   if (scrollDirection == FullRefreshDirections::None) {
     scrollDirection = direction;
@@ -153,9 +122,123 @@ bool LittleVgl::IsScrolling() {
   return scrollDirection != LittleVgl::FullRefreshDirections::None;
 }
 
+void LittleVgl::SetLowPower(bool enabled) {
+  if (enabled == lowPower) {
+    return;
+  }
+  lowPower = enabled;
+  if (enabled) {
+    lcd.LowPowerOn();
+    lowPowerStart = xTaskGetTickCount();
+  } else {
+    lcd.LowPowerOff();
+    lowPowerTicks += xTaskGetTickCount() - lowPowerStart;
+  }
+}
+
+uint32_t LittleVgl::GetLowPowerPixelsPerHour() const {
+  const TickType_t ticks = lowPowerTicks + (lowPower ? xTaskGetTickCount() - lowPowerStart : 0);
+  if (ticks == 0) {
+    return 0;
+  }
+  return static_cast<uint32_t>((static_cast<uint64_t>(lowPowerPixels) * 3600 * configTICK_RATE_HZ) / ticks);
+}
+
+bool LittleVgl::CaptureScreen(lfs_file_t* file, uint32_t offset) {
+  lv_disp_t* disp = lv_disp_get_default();
+  const bool topLayerHidden = lv_obj_get_hidden(lv_layer_top());
+  lv_obj_set_hidden(lv_layer_top(), true);
+  lv_obj_invalidate(lv_scr_act());
+
+  captureFile = file;
+  captureOffset = offset;
+  captureFailed = false;
+  lv_refr_now(disp);
+  captureFile = nullptr;
+
+  lv_obj_set_hidden(lv_layer_top(), topLayerHidden);
+  return !captureFailed;
+}
+
+void LittleVgl::CaptureArea(const lv_area_t* area, const lv_color_t* color_p) {
+  const lv_coord_t width = lv_area_get_width(area);
+  // Full width areas are contiguous in the file, other areas are written line by line
+  const lv_coord_t nbLines = (width == LV_HOR_RES) ? 1 : lv_area_get_height(area);
+  const uint32_t lineSize = ((width == LV_HOR_RES) ? lv_area_get_size(area) : width) * sizeof(lv_color_t);
+  for (lv_coord_t line = 0; line < nbLines && !captureFailed; line++) {
+    const uint32_t position = captureOffset + ((area->y1 + line) * LV_HOR_RES + area->x1) * sizeof(lv_color_t);
+    const auto* data = reinterpret_cast<const uint8_t*>(color_p + (line * width));
+    captureFailed = filesystem.FileSeek(captureFile, position) < 0 ||
+                    filesystem.FileWrite(captureFile, data, lineSize) != static_cast<int>(lineSize);
+  }
+}
+
+void LittleVgl::StartFrame() {
+  renderStartCycles = DWT->CYCCNT;
+  waitingForTransfer = false;
+
+  const TickType_t now = xTaskGetTickCount();
+  const TickType_t elapsed = now - pixelsWindowStart;
+  if (elapsed >= configTICK_RATE_HZ) {
+    pixelsPerSecond = static_cast<uint32_t>((static_cast<uint64_t>(pixelsFlushed) * configTICK_RATE_HZ) / elapsed);
+    pixelsFlushed = 0;
+    pixelsWindowStart = now;
+  }
+}
+
+void LittleVgl::OnWaitForTransfer() {
+  if (!waitingForTransfer) {
+    waitingForTransfer = true;
+    waitStartCycles = DWT->CYCCNT;
+  }
+}
+
+// Called from the SPI interrupt once the buffer passed to FlushDisplay() has been sent
+void LittleVgl::OnTransferDone() {
+  const uint32_t now = DWT->CYCCNT;
+  transferCyclesTotal = transferCyclesTotal + (now - transferStartCycles);
+  transferEndCycles = now;
+  lv_disp_flush_ready(&disp_drv);
+}
+
+void LittleVgl::OnFrameDone(uint32_t renderedPixels) {
+  lastFramePixels = renderedPixels;
+  totalFrames++;
+  frameProfiler.Record(Pinetime::Controllers::FrameProfiler::Phases::Render, frameRenderCycles);
+  frameRenderCycles = 0;
+
+  frameCount++;
+  if (frameCount < frameStatsWindow) {
+    return;
+  }
+  const uint32_t transferCycles = transferCyclesTotal - transferCyclesWindowStart;
+  averageFrameTimes.renderUs = renderCycles / (cyclesPerUs * frameCount);
+  averageFrameTimes.transferUs = transferCycles / (cyclesPerUs * frameCount);
+  averageFrameTimes.overlapUs = overlapCycles / (cyclesPerUs * frameCount);
+  transferCyclesWindowStart = transferCyclesWindowStart + transferCycles;
+  renderCycles = 0;
+  overlapCycles = 0;
+  frameCount = 0;
+}
+
 void LittleVgl::FlushDisplay(const lv_area_t* area, lv_color_t* color_p) {
   uint16_t y1, y2, width, height = 0;
 
+  // LVGL rendered this area since the previous flush returned (or the frame started), possibly
+  // while the previous area was still being sent. LVGL only calls us once that transfer is done.
+  const uint32_t flushStartCycles = DWT->CYCCNT;
+  const uint32_t renderDuration = (waitingForTransfer ? waitStartCycles : flushStartCycles) - renderStartCycles;
+  const uint32_t transferDoneAfterRenderStart = transferEndCycles - renderStartCycles;
+  renderCycles += renderDuration;
+  frameRenderCycles += renderDuration;
+  if (static_cast<int32_t>(transferDoneAfterRenderStart) > 0) {
+    overlapCycles += std::min(renderDuration, transferDoneAfterRenderStart);
+  }
+
+  auto transferDone = [this]() {
+    OnTransferDone();
+  };
+
   if ((scrollDirection == LittleVgl::FullRefreshDirections::Down) && (area->y2 == visibleNbLines - 1)) {
     writeOffset = ((writeOffset + totalNbLines) - visibleNbLines) % totalNbLines;
   } else if ((scrollDirection == FullRefreshDirections::Up) && (area->y1 == 0)) {
@@ -167,6 +250,20 @@ void LittleVgl::FlushDisplay(const lv_area_t* area, lv_color_t* color_p) {
 
   width = (area->x2 - area->x1) + 1;
   height = (area->y2 - area->y1) + 1;
+  pixelsFlushed += width * height;
+
+  if (captureFile != nullptr) {
+    CaptureArea(area, color_p);
+  }
+
+  auto* data = reinterpret_cast<uint8_t*>(color_p);
+  auto dataSize = [this](uint32_t nbPixels) -> size_t {
+    return lowPower ? (nbPixels * 3) / 2 : nbPixels * sizeof(lv_color_t);
+  };
+  if (lowPower) {
+    lowPowerPixels += width * height;
+    Pinetime::Drivers::St7789::PackLowPowerPixels(data, width * height);
+  }
 
   if (scrollDirection == LittleVgl::FullRefreshDirections::Down) {
 
@@ -214,24 +311,27 @@ void LittleVgl::FlushDisplay(const lv_area_t* area, lv_color_t* color_p) {
     }
   }
 
+  transferStartCycles = DWT->CYCCNT;
   if (y2 < y1) {
     height = totalNbLines - y1;
 
     if (height > 0) {
-      lcd.DrawBuffer(area->x1, y1, width, height, reinterpret_cast<const uint8_t*>(color_p), width * height * 2);
+      lcd.DrawBuffer(area->x1, y1, width, height, data, dataSize(width * height));
     }
 
     uint16_t pixOffset = width * height;
     height = y2 + 1;
-    lcd.DrawBuffer(area->x1, 0, width, height, reinterpret_cast<const uint8_t*>(color_p + pixOffset), width * height * 2);
+    lcd.DrawBuffer(area->x1, 0, width, height, data + dataSize(pixOffset), dataSize(width * height), transferDone);
 
   } else {
-    lcd.DrawBuffer(area->x1, y1, width, height, reinterpret_cast<const uint8_t*>(color_p), width * height * 2);
+    lcd.DrawBuffer(area->x1, y1, width, height, data, dataSize(width * height), transferDone);
   }
 
-  // IMPORTANT!!!
-  // Inform the graphics library that you are ready with the flushing
-  lv_disp_flush_ready(&disp_drv);
+  // The transfer is still running: lv_disp_flush_ready() is called by OnTransferDone() from the SPI
+  // interrupt, so LVGL can render into the other buffer in the meantime.
+  renderStartCycles = DWT->CYCCNT;
+  frameProfiler.Record(Pinetime::Controllers::FrameProfiler::Phases::Flush, renderStartCycles - flushStartCycles);
+  waitingForTransfer = false;
 }
 
 void LittleVgl::SetNewTouchPoint(int16_t x, int16_t y, bool contact) {
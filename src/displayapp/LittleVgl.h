@@ -1,7 +1,10 @@
 #pragma once
 
+#include <FreeRTOS.h>
 #include <lvgl/lvgl.h>
 #include <components/fs/FS.h>
+#include "components/profiler/FrameProfiler.h"
+#include "displayapp/FileCache.h"
 
 namespace Pinetime {
   namespace Drivers {
@@ -12,7 +15,14 @@ namespace Pinetime {
     class LittleVgl {
     public:
       enum class FullRefreshDirections { None, Up, Down, Left, Right, LeftAnim, RightAnim };
-      LittleVgl(Pinetime::Drivers::St7789& lcd, Pinetime::Controllers::FS& filesystem);
+
+      struct FrameTimes {
+        uint32_t renderUs = 0;
+        uint32_t transferUs = 0;
+        uint32_t overlapUs = 0;
+      };
+
+      LittleVgl(Pinetime::Drivers::St7789& lcd, Pinetime::Controllers::FS& filesystem, Pinetime::Controllers::FrameProfiler& frameProfiler);
 
       LittleVgl(const LittleVgl&) = delete;
       LittleVgl& operator=(const LittleVgl&) = delete;
@@ -22,6 +32,10 @@ namespace Pinetime {
       void Init();
 
       void FlushDisplay(const lv_area_t* area, lv_color_t* color_p);
+      void OnTransferDone();
+      void OnWaitForTransfer();
+      void OnFrameDone(uint32_t renderedPixels);
+      void StartFrame();
       bool GetTouchPadInfo(lv_indev_data_t* ptr);
       void SetFullRefresh(FullRefreshDirections direction);
       void SetNewTouchPoint(int16_t x, int16_t y, bool contact);
@@ -29,6 +43,36 @@ namespace Pinetime {
       void ClearTouchState();
       bool IsScrolling();
 
+      // Switches the display to/from its low power mode (always on display): 8 colours, sent with 12 bits per pixel
+      void SetLowPower(bool enabled);
+
+      // Pixels sent per hour of always on display, since boot
+      uint32_t GetLowPowerPixelsPerHour() const;
+
+      // Renders the active screen now and also writes it to file, from offset, as the raw RGB565 lines
+      // sent to the display. Return false if the file could not be written.
+      bool CaptureScreen(lfs_file_t* file, uint32_t offset);
+
+      // Average render, SPI transfer and render/transfer overlap time per frame over the last frameStatsWindow frames
+      FrameTimes GetAverageFrameTimes() const {
+        return averageFrameTimes;
+      }
+
+      // Pixels sent to the display during the last full second, i.e. the SPI/power cost of the current screen
+      uint32_t GetPixelsPerSecond() const {
+        return pixelsPerSecond;
+      }
+
+      // Number of refreshes since boot
+      uint32_t GetFrameCount() const {
+        return totalFrames;
+      }
+
+      // Pixels redrawn by LVGL during the last refresh
+      uint32_t GetLastFramePixels() const {
+        return lastFramePixels;
+      }
+
       bool GetFullRefresh() {
         bool returnValue = fullRefresh;
         if (fullRefresh) {
@@ -40,10 +84,12 @@ namespace Pinetime {
     private:
       void InitDisplay();
       void InitTouchpad();
-      void InitFileSystem();
+      void CaptureArea(const lv_area_t* area, const lv_color_t* color_p);
 
       Pinetime::Drivers::St7789& lcd;
       Pinetime::Controllers::FS& filesystem;
+      Pinetime::Controllers::FrameProfiler& frameProfiler;
+      FileCache fileCache;
 
       lv_disp_buf_t disp_buf_2;
       lv_color_t buf2_1[LV_HOR_RES_MAX * 4];
@@ -64,6 +110,37 @@ namespace Pinetime {
       uint16_t writeOffset = 0;
       uint16_t scrollOffset = 0;
 
+      static constexpr uint8_t frameStatsWindow = 32;
+      static constexpr uint32_t cyclesPerUs = 64;
+      uint8_t frameCount = 0;
+      uint32_t renderStartCycles = 0;
+      uint32_t waitStartCycles = 0;
+      bool waitingForTransfer = false;
+      volatile uint32_t transferStartCycles = 0;
+      volatile uint32_t transferEndCycles = 0;
+      uint32_t renderCycles = 0;
+      uint32_t frameRenderCycles = 0;
+      uint32_t totalFrames = 0;
+      uint32_t overlapCycles = 0;
+      // Only ever incremented (from the SPI interrupt), windows are computed from the difference
+      volatile uint32_t transferCyclesTotal = 0;
+      uint32_t transferCyclesWindowStart = 0;
+      FrameTimes averageFrameTimes;
+
+      uint32_t lastFramePixels = 0;
+      uint32_t pixelsFlushed = 0;
+      uint32_t pixelsPerSecond = 0;
+      TickType_t pixelsWindowStart = 0;
+
+      bool lowPower = false;
+      uint32_t lowPowerPixels = 0;
+      TickType_t lowPowerTicks = 0;
+      TickType_t lowPowerStart = 0;
+
+      lfs_file_t* captureFile = nullptr;
+      uint32_t captureOffset = 0;
+      bool captureFailed = false;
+
       lv_point_t touchPoint = {};
       bool tapped = false;
       bool isCancelled = false;
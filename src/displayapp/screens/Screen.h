@@ -40,6 +40,12 @@ namespace Pinetime {
           return false;
         }
 
+        /** @return true if what the screen shows only changes with the minute (no seconds): in always on mode, it is
+         * then only drawn when the minute changes */
+        virtual bool OnlyChangesEachMinute() const {
+          return false;
+        }
+
       protected:
         bool running = true;
       };
@@ -4,6 +4,8 @@
 #include "displayapp/screens/SystemInfo.h"
 #include <lvgl/lvgl.h>
 #include "displayapp/DisplayApp.h"
+#include "displayapp/LittleVgl.h"
+#include "displayapp/LazyFont.h"
 #include "displayapp/screens/Label.h"
 #include "Version.h"
 #include "BootloaderVersion.h"
@@ -13,6 +15,8 @@
 #include "components/datetime/DateTimeController.h"
 #include "components/motion/MotionController.h"
 #include "drivers/Watchdog.h"
+#include "drivers/SpiNorFlash.h"
+#include "drivers/St7789.h"
 #include "displayapp/InfiniTimeTheme.h"
 
 using namespace Pinetime::Applications::Screens;
@@ -39,7 +43,9 @@ SystemInfo::SystemInfo(Pinetime::Applications::DisplayApp* app,
                        const Pinetime::Drivers::Watchdog& watchdog,
                        Pinetime::Controllers::MotionController& motionController,
                        const Pinetime::Drivers::Cst816S& touchPanel,
-                       const Pinetime::Drivers::SpiNorFlash& spiNorFlash)
+                       const Pinetime::Drivers::SpiNorFlash& spiNorFlash,
+                       const Pinetime::Drivers::St7789& lcd,
+                       const Pinetime::Components::LittleVgl& lvgl)
   : dateTimeController {dateTimeController},
     batteryController {batteryController},
     brightnessController {brightnessController},
@@ -48,6 +54,8 @@ SystemInfo::SystemInfo(Pinetime::Applications::DisplayApp* app,
     motionController {motionController},
     touchPanel {touchPanel},
     spiNorFlash {spiNorFlash},
+    lcd {lcd},
+    lvgl {lvgl},
     screens {app,
              0,
              {[this]() -> std::unique_ptr<Screen> {
@@ -64,6 +72,9 @@ SystemInfo::SystemInfo(Pinetime::Applications::DisplayApp* app,
               },
               [this]() -> std::unique_ptr<Screen> {
                 return CreateScreen5();
+              },
+              [this]() -> std::unique_ptr<Screen> {
+                return CreateScreen6();
               }},
              Screens::ScreenListModes::UpDown} {
 }
@@ -96,7 +107,7 @@ std::unique_ptr<Screen> SystemInfo::CreateScreen1() {
                         BootloaderVersion::VersionString());
   lv_label_set_align(label, LV_LABEL_ALIGN_CENTER);
   lv_obj_align(label, lv_scr_act(), LV_ALIGN_CENTER, 0, 0);
-  return std::make_unique<Screens::Label>(0, 5, label);
+  return std::make_unique<Screens::Label>(0, 6, label);
 }
 
 std::unique_ptr<Screen> SystemInfo::CreateScreen2() {
@@ -175,7 +186,7 @@ std::unique_ptr<Screen> SystemInfo::CreateScreen2() {
                         touchPanel.GetFwVersion(),
                         TARGET_DEVICE_NAME);
   lv_obj_align(label, lv_scr_act(), LV_ALIGN_CENTER, 0, 0);
-  return std::make_unique<Screens::Label>(1, 5, label);
+  return std::make_unique<Screens::Label>(1, 6, label);
 }
 
 extern int mallocFailedCount;
@@ -193,7 +204,7 @@ std::unique_ptr<Screen> SystemInfo::CreateScreen3() {
                         " %02x:%02x:%02x:%02x:%02x:%02x\n"
                         "\n"
                         "#808080 SPI Flash# %02x-%02x-%02x\n"
-                        "\n"
+                        "#808080 Glyph cache# %d%% hit\n"
                         "#808080 Memory heap#\n"
                         " #808080 Free# %d/%d\n"
                         " #808080 Min free# %d\n"
@@ -208,13 +219,14 @@ std::unique_ptr<Screen> SystemInfo::CreateScreen3() {
                         spiFlashId.manufacturer,
                         spiFlashId.type,
                         spiFlashId.density,
+                        Components::LazyFont::CacheHitRate(),
                         xPortGetFreeHeapSize(),
                         xPortGetHeapSize(),
                         xPortGetMinimumEverFreeHeapSize(),
                         mallocFailedCount,
                         stackOverflowCount);
   lv_obj_align(label, lv_scr_act(), LV_ALIGN_CENTER, 0, 0);
-  return std::make_unique<Screens::Label>(2, 5, label);
+  return std::make_unique<Screens::Label>(2, 6, label);
 }
 
 bool SystemInfo::sortById(const TaskStatus_t& lhs, const TaskStatus_t& rhs) {
@@ -280,10 +292,36 @@ std::unique_ptr<Screen> SystemInfo::CreateScreen4() {
     }
     lv_table_set_cell_value(infoTask, i + 1, 3, buffer);
   }
-  return std::make_unique<Screens::Label>(3, 5, infoTask);
+  return std::make_unique<Screens::Label>(3, 6, infoTask);
 }
 
 std::unique_ptr<Screen> SystemInfo::CreateScreen5() {
+  const auto frameTimes = lvgl.GetAverageFrameTimes();
+
+  lv_obj_t* label = lv_label_create(lv_scr_act(), nullptr);
+  lv_label_set_recolor(label, true);
+  lv_label_set_text_fmt(label,
+                        "#FFFF00 Display#\n\n"
+                        "#808080 Avg. frame time#\n"
+                        " #808080 Render# %lu us\n"
+                        " #808080 Transfer# %lu us\n"
+                        " #808080 Overlap# %lu us\n"
+                        "\n"
+                        "#808080 SPI throughput#\n"
+                        " #808080 LCD# %lu kB/s\n"
+                        " #808080 Flash# %lu kB/s\n"
+                        "#808080 Always on# %lu px/h",
+                        frameTimes.renderUs,
+                        frameTimes.transferUs,
+                        frameTimes.overlapUs,
+                        lcd.SpiThroughput() / 1024,
+                        spiNorFlash.SpiThroughput() / 1024,
+                        lvgl.GetLowPowerPixelsPerHour());
+  lv_obj_align(label, lv_scr_act(), LV_ALIGN_CENTER, 0, 0);
+  return std::make_unique<Screens::Label>(4, 6, label);
+}
+
+std::unique_ptr<Screen> SystemInfo::CreateScreen6() {
   lv_obj_t* label = lv_label_create(lv_scr_act(), nullptr);
   lv_label_set_recolor(label, true);
   lv_label_set_text_static(label,
@@ -297,5 +335,5 @@ std::unique_ptr<Screen> SystemInfo::CreateScreen5() {
                            "#FFFF00 InfiniTime#");
   lv_label_set_align(label, LV_LABEL_ALIGN_CENTER);
   lv_obj_align(label, lv_scr_act(), LV_ALIGN_CENTER, 0, 0);
-  return std::make_unique<Screens::Label>(4, 5, label);
+  return std::make_unique<Screens::Label>(5, 6, label);
 }
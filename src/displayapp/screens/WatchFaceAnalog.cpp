@@ -1,6 +1,5 @@
 #include "displayapp/screens/WatchFaceAnalog.h"
 #include <cmath>
-#include <limits>
 #include <lvgl/lvgl.h>
 #include "displayapp/screens/BatteryIcon.h"
 #include "displayapp/screens/BleIcon.h"
@@ -8,6 +7,7 @@
 #include "displayapp/screens/NotificationIcon.h"
 #include "components/settings/Settings.h"
 #include "displayapp/InfiniTimeTheme.h"
+#include "utility/Trigonometry.h"
 
 using namespace Pinetime::Applications::Screens;
 
@@ -16,19 +16,6 @@ namespace {
   constexpr int16_t MinuteLength = 90;
   constexpr int16_t SecondLength = 110;
 
-  // LVGL sin isn't constexpr (though it could be if it were C++) so fix size here
-  // All the types are hardcoded anyway and would need changing if the size changed
-  // sin(90) = 1 so the value of _lv_trigo_sin(90) is the scaling factor
-  constexpr int16_t LV_TRIG_SCALE = std::numeric_limits<int16_t>::max(); // = _lv_trigo_sin(90)
-
-  int16_t Cosine(int16_t angle) {
-    return _lv_trigo_sin(angle + 90);
-  }
-
-  int16_t Sine(int16_t angle) {
-    return _lv_trigo_sin(angle);
-  }
-
   int16_t CoordinateXRelocate(int16_t x) {
     return (x + LV_HOR_RES / 2);
   }
@@ -38,8 +25,8 @@ namespace {
   }
 
   lv_point_t CoordinateRelocate(int16_t radius, int16_t angle) {
-    return lv_point_t {.x = CoordinateXRelocate(radius * static_cast<int32_t>(Sine(angle)) / LV_TRIG_SCALE),
-                       .y = CoordinateYRelocate(radius * static_cast<int32_t>(Cosine(angle)) / LV_TRIG_SCALE)};
+    return lv_point_t {.x = CoordinateXRelocate(Pinetime::Utility::MultiplyQ15(radius, Pinetime::Utility::Sine(angle))),
+                       .y = CoordinateYRelocate(Pinetime::Utility::MultiplyQ15(radius, Pinetime::Utility::Cosine(angle)))};
   }
 
 }
@@ -48,9 +35,12 @@ WatchFaceAnalog::WatchFaceAnalog(Controllers::DateTime& dateTimeController,
                                  const Controllers::Battery& batteryController,
                                  const Controllers::Ble& bleController,
                                  Controllers::NotificationManager& notificationManager,
-                                 Controllers::Settings& settingsController)
+                                 Controllers::Settings& settingsController,
+                                 Controllers::FS& filesystem,
+                                 Components::LittleVgl& lvgl)
   : currentDateTime {{}},
     batteryIcon(true),
+    staticLayer(filesystem, lvgl),
     dateTimeController {dateTimeController},
     batteryController {batteryController},
     bleController {bleController},
@@ -61,7 +51,7 @@ WatchFaceAnalog::WatchFaceAnalog(Controllers::DateTime& dateTimeController,
   sMinute = 99;
   sSecond = 99;
 
-  minor_scales = lv_linemeter_create(lv_scr_act(), nullptr);
+  lv_obj_t* minor_scales = lv_linemeter_create(lv_scr_act(), nullptr);
   lv_linemeter_set_scale(minor_scales, 300, 51);
   lv_linemeter_set_angle_offset(minor_scales, 180);
   lv_obj_set_size(minor_scales, 240, 240);
@@ -71,7 +61,7 @@ WatchFaceAnalog::WatchFaceAnalog(Controllers::DateTime& dateTimeController,
   lv_obj_set_style_local_scale_end_line_width(minor_scales, LV_LINEMETER_PART_MAIN, LV_STATE_DEFAULT, 1);
   lv_obj_set_style_local_scale_end_color(minor_scales, LV_LINEMETER_PART_MAIN, LV_STATE_DEFAULT, LV_COLOR_GRAY);
 
-  major_scales = lv_linemeter_create(lv_scr_act(), nullptr);
+  lv_obj_t* major_scales = lv_linemeter_create(lv_scr_act(), nullptr);
   lv_linemeter_set_scale(major_scales, 300, 11);
   lv_linemeter_set_angle_offset(major_scales, 180);
   lv_obj_set_size(major_scales, 240, 240);
@@ -81,7 +71,7 @@ WatchFaceAnalog::WatchFaceAnalog(Controllers::DateTime& dateTimeController,
   lv_obj_set_style_local_scale_end_line_width(major_scales, LV_LINEMETER_PART_MAIN, LV_STATE_DEFAULT, 4);
   lv_obj_set_style_local_scale_end_color(major_scales, LV_LINEMETER_PART_MAIN, LV_STATE_DEFAULT, LV_COLOR_WHITE);
 
-  large_scales = lv_linemeter_create(lv_scr_act(), nullptr);
+  lv_obj_t* large_scales = lv_linemeter_create(lv_scr_act(), nullptr);
   lv_linemeter_set_scale(large_scales, 180, 3);
   lv_linemeter_set_angle_offset(large_scales, 180);
   lv_obj_set_size(large_scales, 240, 240);
@@ -91,12 +81,16 @@ WatchFaceAnalog::WatchFaceAnalog(Controllers::DateTime& dateTimeController,
   lv_obj_set_style_local_scale_end_line_width(large_scales, LV_LINEMETER_PART_MAIN, LV_STATE_DEFAULT, 4);
   lv_obj_set_style_local_scale_end_color(large_scales, LV_LINEMETER_PART_MAIN, LV_STATE_DEFAULT, LV_COLOR_AQUA);
 
-  twelve = lv_label_create(lv_scr_act(), nullptr);
+  lv_obj_t* twelve = lv_label_create(lv_scr_act(), nullptr);
   lv_label_set_align(twelve, LV_LABEL_ALIGN_CENTER);
   lv_label_set_text_static(twelve, "12");
   lv_obj_set_pos(twelve, 110, 10);
   lv_obj_set_style_local_text_color(twelve, LV_LABEL_PART_MAIN, LV_STATE_DEFAULT, LV_COLOR_AQUA);
 
+  // The scales don't depend on any setting: only bump the key when changing them.
+  // Create() deletes the objects above, don't keep pointers to them.
+  staticLayer.Create("analog", 1);
+
   batteryIcon.Create(lv_scr_act());
   lv_obj_align(batteryIcon.GetObject(), nullptr, LV_ALIGN_IN_TOP_RIGHT, 0, 0);
 
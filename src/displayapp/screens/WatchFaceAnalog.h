@@ -10,6 +10,7 @@
 #include "components/ble/BleController.h"
 #include "components/ble/NotificationManager.h"
 #include "displayapp/screens/BatteryIcon.h"
+#include "displayapp/widgets/StaticLayer.h"
 #include "utility/DirtyValue.h"
 
 namespace Pinetime {
@@ -29,7 +30,9 @@ namespace Pinetime {
                         const Controllers::Battery& batteryController,
                         const Controllers::Ble& bleController,
                         Controllers::NotificationManager& notificationManager,
-                        Controllers::Settings& settingsController);
+                        Controllers::Settings& settingsController,
+                        Controllers::FS& filesystem,
+                        Components::LittleVgl& lvgl);
 
         ~WatchFaceAnalog() override;
 
@@ -45,11 +48,6 @@ namespace Pinetime {
         Utility::DirtyValue<bool> notificationState {false};
         Utility::DirtyValue<std::chrono::time_point<std::chrono::system_clock, std::chrono::days>> currentDate;
 
-        lv_obj_t* minor_scales;
-        lv_obj_t* major_scales;
-        lv_obj_t* large_scales;
-        lv_obj_t* twelve;
-
         lv_obj_t* hour_body;
         lv_obj_t* hour_body_trace;
         lv_obj_t* minute_body;
@@ -74,6 +72,7 @@ namespace Pinetime {
         lv_obj_t* bleIcon;
 
         BatteryIcon batteryIcon;
+        Widgets::StaticLayer staticLayer;
 
         Controllers::DateTime& dateTimeController;
         const Controllers::Battery& batteryController;
@@ -98,7 +97,9 @@ namespace Pinetime {
                                             controllers.batteryController,
                                             controllers.bleController,
                                             controllers.notificationManager,
-                                            controllers.settingsController);
+                                            controllers.settingsController,
+                                            controllers.filesystem,
+                                            controllers.lvgl);
       };
 
       static bool IsAvailable(Pinetime::Controllers::FS& /*filesystem*/) {
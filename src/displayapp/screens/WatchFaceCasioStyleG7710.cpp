@@ -6,6 +6,7 @@
 #include "displayapp/screens/BleIcon.h"
 #include "displayapp/screens/NotificationIcon.h"
 #include "displayapp/screens/Symbols.h"
+#include "displayapp/LazyFont.h"
 #include "components/battery/BatteryController.h"
 #include "components/ble/BleController.h"
 #include "components/ble/NotificationManager.h"
@@ -35,17 +36,17 @@ WatchFaceCasioStyleG7710::WatchFaceCasioStyleG7710(Controllers::DateTime& dateTi
   lfs_file f = {};
   if (filesystem.FileOpen(&f, "/fonts/lv_font_dots_40.bin", LFS_O_RDONLY) >= 0) {
     filesystem.FileClose(&f);
-    font_dot40 = lv_font_load("F:/fonts/lv_font_dots_40.bin");
+    font_dot40 = Components::LazyFont::Load("F:/fonts/lv_font_dots_40.bin");
   }
 
   if (filesystem.FileOpen(&f, "/fonts/7segments_40.bin", LFS_O_RDONLY) >= 0) {
     filesystem.FileClose(&f);
-    font_segment40 = lv_font_load("F:/fonts/7segments_40.bin");
+    font_segment40 = Components::LazyFont::Load("F:/fonts/7segments_40.bin");
   }
 
   if (filesystem.FileOpen(&f, "/fonts/7segments_115.bin", LFS_O_RDONLY) >= 0) {
     filesystem.FileClose(&f);
-    font_segment115 = lv_font_load("F:/fonts/7segments_115.bin");
+    font_segment115 = Components::LazyFont::Load("F:/fonts/7segments_115.bin");
   }
 
   label_battery_value = lv_label_create(lv_scr_act(), nullptr);
@@ -179,15 +180,15 @@ WatchFaceCasioStyleG7710::~WatchFaceCasioStyleG7710() {
   lv_style_reset(&style_border);
 
   if (font_dot40 != nullptr) {
-    lv_font_free(font_dot40);
+    Components::LazyFont::Free(font_dot40);
   }
 
   if (font_segment40 != nullptr) {
-    lv_font_free(font_segment40);
+    Components::LazyFont::Free(font_segment40);
   }
 
   if (font_segment115 != nullptr) {
-    lv_font_free(font_segment115);
+    Components::LazyFont::Free(font_segment115);
   }
 
   lv_obj_clean(lv_scr_act());
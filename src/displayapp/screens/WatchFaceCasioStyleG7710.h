@@ -39,6 +39,10 @@ namespace Pinetime {
 
         void Refresh() override;
 
+        bool OnlyChangesEachMinute() const override {
+          return true;
+        }
+
         static bool IsAvailable(Pinetime::Controllers::FS& filesystem);
 
       private:
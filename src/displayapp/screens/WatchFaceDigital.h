@@ -9,6 +9,7 @@
 #include "components/ble/SimpleWeatherService.h"
 #include "components/ble/BleController.h"
 #include "displayapp/widgets/StatusIcons.h"
+#include "displayapp/widgets/DirtyLabel.h"
 #include "utility/DirtyValue.h"
 #include "displayapp/apps/Apps.h"
 
@@ -41,6 +42,10 @@ namespace Pinetime {
 
         void Refresh() override;
 
+        bool OnlyChangesEachMinute() const override {
+          return true;
+        }
+
       private:
         uint8_t displayedHour = -1;
         uint8_t displayedMinute = -1;
@@ -58,12 +63,12 @@ namespace Pinetime {
         lv_obj_t* label_time_ampm;
         lv_obj_t* label_date;
         lv_obj_t* heartbeatIcon;
-        lv_obj_t* heartbeatValue;
+        Widgets::DirtyLabel heartbeatValue;
         lv_obj_t* stepIcon;
-        lv_obj_t* stepValue;
+        Widgets::DirtyLabel stepValue;
         lv_obj_t* notificationIcon;
         lv_obj_t* weatherIcon;
-        lv_obj_t* temperature;
+        Widgets::DirtyLabel temperature;
 
         Controllers::DateTime& dateTimeController;
         Controllers::NotificationManager& notificationManager;
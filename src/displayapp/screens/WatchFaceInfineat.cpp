@@ -4,6 +4,7 @@
 #include <cstdio>
 #include "displayapp/screens/Symbols.h"
 #include "displayapp/screens/BleIcon.h"
+#include "displayapp/LazyFont.h"
 #include "components/settings/Settings.h"
 #include "components/battery/BatteryController.h"
 #include "components/ble/BleController.h"
@@ -136,12 +137,12 @@ WatchFaceInfineat::WatchFaceInfineat(Controllers::DateTime& dateTimeController,
   lfs_file f = {};
   if (filesystem.FileOpen(&f, "/fonts/teko.bin", LFS_O_RDONLY) >= 0) {
     filesystem.FileClose(&f);
-    font_teko = lv_font_load("F:/fonts/teko.bin");
+    font_teko = Components::LazyFont::Load("F:/fonts/teko.bin");
   }
 
   if (filesystem.FileOpen(&f, "/fonts/bebas.bin", LFS_O_RDONLY) >= 0) {
     filesystem.FileClose(&f);
-    font_bebas = lv_font_load("F:/fonts/bebas.bin");
+    font_bebas = Components::LazyFont::Load("F:/fonts/bebas.bin");
   }
 
   // Side Cover
@@ -304,10 +305,10 @@ WatchFaceInfineat::~WatchFaceInfineat() {
   lv_task_del(taskRefresh);
 
   if (font_bebas != nullptr) {
-    lv_font_free(font_bebas);
+    Components::LazyFont::Free(font_bebas);
   }
   if (font_teko != nullptr) {
-    lv_font_free(font_teko);
+    Components::LazyFont::Free(font_teko);
   }
 
   lv_obj_clean(lv_scr_act());
@@ -444,6 +444,11 @@ void WatchFacePineTimeStyle::SetBatteryIcon() {
   batteryIcon.SetBatteryPercentage(batteryPercent);
 }
 
+bool WatchFacePineTimeStyle::OnlyChangesEachMinute() const {
+  // The half gauge style shows the seconds
+  return settingsController.GetPTSGaugeStyle() != Pinetime::Controllers::Settings::PTSGaugeStyle::Half;
+}
+
 void WatchFacePineTimeStyle::Refresh() {
   isCharging = batteryController.IsCharging();
   if (isCharging.IsUpdated()) {
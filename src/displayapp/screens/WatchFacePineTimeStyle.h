@@ -41,6 +41,8 @@ namespace Pinetime {
 
         void Refresh() override;
 
+        bool OnlyChangesEachMinute() const override;
+
         void UpdateSelected(lv_obj_t* object, lv_event_t event);
 
       private:
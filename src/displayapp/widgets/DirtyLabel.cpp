@@ -0,0 +1,40 @@
+#include "displayapp/widgets/DirtyLabel.h"
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+
+using namespace Pinetime::Applications::Widgets;
+
+void DirtyLabel::Attach(lv_obj_t* label) {
+  this->label = label;
+}
+
+bool DirtyLabel::SetText(const char* newText) {
+  Text buffer {};
+  std::strncpy(buffer.data(), newText, buffer.size() - 1);
+  return Update(buffer);
+}
+
+bool DirtyLabel::SetTextFmt(const char* fmt, ...) {
+  Text buffer {};
+  va_list args;
+  va_start(args, fmt);
+  vsnprintf(buffer.data(), buffer.size(), fmt, args);
+  va_end(args);
+  return Update(buffer);
+}
+
+bool DirtyLabel::Update(const Text& newText) {
+  text = newText;
+  if (!text.IsUpdated()) {
+    return false;
+  }
+
+  const lv_coord_t previousWidth = lv_obj_get_width(label);
+  lv_label_set_text(label, text.Get().data());
+  if (lv_obj_get_width(label) == previousWidth) {
+    return false;
+  }
+  lv_obj_realign(label);
+  return true;
+}
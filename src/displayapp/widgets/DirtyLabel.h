@@ -0,0 +1,36 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <lvgl/lvgl.h>
+#include "utility/DirtyValue.h"
+
+namespace Pinetime {
+  namespace Applications {
+    namespace Widgets {
+      // Label that only redraws when its text changes and only realigns when its width changes.
+      // Setting the text of a label invalidates its whole area, realigning it after a width change
+      // invalidates both its old and its new area.
+      class DirtyLabel {
+      public:
+        static constexpr size_t maxTextSize = 32;
+
+        void Attach(lv_obj_t* label);
+
+        // Return true if the width of the label changed, objects aligned on it must then be realigned
+        bool SetText(const char* text);
+        bool SetTextFmt(const char* fmt, ...) __attribute__((format(printf, 2, 3)));
+
+        lv_obj_t* GetObject() const {
+          return label;
+        }
+
+      private:
+        using Text = std::array<char, maxTextSize>;
+        bool Update(const Text& newText);
+
+        lv_obj_t* label = nullptr;
+        Utility::DirtyValue<Text> text {};
+      };
+    }
+  }
+}
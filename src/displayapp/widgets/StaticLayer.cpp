@@ -0,0 +1,126 @@
+#include "displayapp/widgets/StaticLayer.h"
+#include <cstdio>
+#include "components/fs/FS.h"
+#include "displayapp/LittleVgl.h"
+#include "Version.h"
+
+using namespace Pinetime::Applications::Widgets;
+
+namespace {
+  constexpr uint32_t Fnv1a(const char* text) {
+    uint32_t hash = 2166136261u;
+    while (*text != '\0') {
+      hash = (hash ^ static_cast<uint8_t>(*text++)) * 16777619u;
+    }
+    return hash;
+  }
+
+  // Firmware updates may change how the objects are drawn, and so invalidate every cache
+  constexpr uint32_t firmwareId = Fnv1a(Pinetime::Version::GitCommitHash());
+  static_assert(firmwareId != 0, "0 marks incomplete cache files");
+}
+
+StaticLayer::StaticLayer(Controllers::FS& filesystem, Components::LittleVgl& lvgl) : filesystem {filesystem}, lvgl {lvgl} {
+}
+
+StaticLayer::~StaticLayer() {
+  if (fileOpen) {
+    filesystem.FileClose(&file);
+  }
+}
+
+void StaticLayer::Create(const char* name, uint32_t key) {
+  char path[LFS_NAME_MAX];
+  snprintf(path, sizeof(path), "/.system/%s.lyr", name);
+  const Header header {key, firmwareId};
+
+  if (!Load(path, header) && !Render(path, header)) {
+    // The objects are simply left on the screen and drawn as usual
+    return;
+  }
+
+  lv_obj_clean(lv_scr_act());
+  layer = lv_obj_create(lv_scr_act(), nullptr);
+  lv_obj_set_pos(layer, 0, 0);
+  lv_obj_set_size(layer, LV_HOR_RES, LV_VER_RES);
+  lv_obj_set_click(layer, false);
+  lv_obj_set_user_data(layer, this);
+  lv_obj_set_design_cb(layer, Design);
+}
+
+bool StaticLayer::Load(const char* path, const Header& header) {
+  if (filesystem.FileOpen(&file, path, LFS_O_RDONLY) != LFS_ERR_OK) {
+    return false;
+  }
+  Header stored {};
+  const int size = filesystem.FileRead(&file, reinterpret_cast<uint8_t*>(&stored), sizeof(stored));
+  if (size != static_cast<int>(sizeof(stored)) || stored.key != header.key || stored.firmware != header.firmware) {
+    filesystem.FileClose(&file);
+    return false;
+  }
+  fileOpen = true;
+  return true;
+}
+
+bool StaticLayer::Render(const char* path, const Header& header) {
+  lfs_dir systemDir;
+  if (filesystem.DirOpen("/.system", &systemDir) != LFS_ERR_OK) {
+    filesystem.DirCreate("/.system");
+  }
+  filesystem.DirClose(&systemDir);
+
+  if (filesystem.FileOpen(&file, path, LFS_O_WRONLY | LFS_O_CREAT | LFS_O_TRUNC) != LFS_ERR_OK) {
+    return false;
+  }
+
+  // The header is only written once all the pixels are, so that an interrupted capture is never loaded
+  const Header incomplete {0, 0};
+  constexpr int headerSize = sizeof(Header);
+  bool success = filesystem.FileWrite(&file, reinterpret_cast<const uint8_t*>(&incomplete), headerSize) == headerSize;
+  success = success && lvgl.CaptureScreen(&file, headerSize);
+  success = success && filesystem.FileSeek(&file, 0) >= 0;
+  success = success && filesystem.FileWrite(&file, reinterpret_cast<const uint8_t*>(&header), headerSize) == headerSize;
+  success = (filesystem.FileClose(&file) == LFS_ERR_OK) && success;
+
+  if (!success) {
+    filesystem.FileDelete(path);
+    return false;
+  }
+  return Load(path, header);
+}
+
+lv_design_res_t StaticLayer::Design(lv_obj_t* obj, const lv_area_t* clipArea, lv_design_mode_t mode) {
+  if (mode == LV_DESIGN_COVER_CHK) {
+    return _lv_area_is_in(clipArea, &obj->coords, 0) ? LV_DESIGN_RES_COVER : LV_DESIGN_RES_NOT_COVER;
+  }
+  if (mode == LV_DESIGN_DRAW_MAIN) {
+    static_cast<StaticLayer*>(lv_obj_get_user_data(obj))->Draw(clipArea);
+  }
+  return LV_DESIGN_RES_OK;
+}
+
+// Copies the cached pixels straight into the draw buffer, nothing is drawn below the layer
+void StaticLayer::Draw(const lv_area_t* clipArea) {
+  lv_area_t area;
+  if (!_lv_area_intersect(&area, clipArea, &layer->coords)) {
+    return;
+  }
+
+  lv_disp_buf_t* vdb = lv_disp_get_buf(_lv_refr_get_disp_refreshing());
+  auto* buffer = static_cast<lv_color_t*>(vdb->buf_act);
+  const lv_coord_t bufferWidth = lv_area_get_width(&vdb->area);
+  const lv_coord_t width = lv_area_get_width(&area);
+  // Full width areas are contiguous both in the file and in the buffer
+  const bool contiguous = (width == LV_HOR_RES) && (bufferWidth == LV_HOR_RES);
+  const lv_coord_t nbLines = contiguous ? 1 : lv_area_get_height(&area);
+  const uint32_t lineSize = (contiguous ? lv_area_get_size(&area) : width) * sizeof(lv_color_t);
+
+  for (lv_coord_t line = 0; line < nbLines; line++) {
+    const lv_coord_t y = area.y1 + line;
+    const uint32_t position = sizeof(Header) + (y * LV_HOR_RES + area.x1) * sizeof(lv_color_t);
+    auto* destination = reinterpret_cast<uint8_t*>(buffer + ((y - vdb->area.y1) * bufferWidth) + (area.x1 - vdb->area.x1));
+    if (filesystem.FileSeek(&file, position) < 0 || filesystem.FileRead(&file, destination, lineSize) < 0) {
+      return;
+    }
+  }
+}
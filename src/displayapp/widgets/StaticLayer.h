@@ -0,0 +1,51 @@
+#pragma once
+#include <cstdint>
+#include <lvgl/lvgl.h>
+#include <littlefs/lfs.h>
+
+namespace Pinetime {
+  namespace Controllers {
+    class FS;
+  }
+
+  namespace Components {
+    class LittleVgl;
+  }
+
+  namespace Applications {
+    namespace Widgets {
+      // Static decorations of a watch face (scales, backgrounds...) rendered once and cached in the file system.
+      // On redraw, their pixels are read back from the cache instead of being rendered again.
+      class StaticLayer {
+      public:
+        StaticLayer(Controllers::FS& filesystem, Components::LittleVgl& lvgl);
+        ~StaticLayer();
+
+        StaticLayer(const StaticLayer&) = delete;
+        StaticLayer& operator=(const StaticLayer&) = delete;
+
+        // Call once all the static objects are on the active screen, before creating the dynamic ones:
+        // they are replaced by a single object drawing the cached pixels. key must change whenever a
+        // setting that affects these objects changes, the cache is then rendered again.
+        void Create(const char* name, uint32_t key);
+
+      private:
+        struct Header {
+          uint32_t key;
+          uint32_t firmware;
+        };
+
+        static lv_design_res_t Design(lv_obj_t* obj, const lv_area_t* clipArea, lv_design_mode_t mode);
+        bool Load(const char* path, const Header& header);
+        bool Render(const char* path, const Header& header);
+        void Draw(const lv_area_t* clipArea);
+
+        Controllers::FS& filesystem;
+        Components::LittleVgl& lvgl;
+        lfs_file_t file;
+        bool fileOpen = false;
+        lv_obj_t* layer = nullptr;
+      };
+    }
+  }
+}
@@ -4,36 +4,75 @@
 
 using namespace Pinetime::Drivers;
 
-Spi::Spi(SpiMaster& spiMaster, uint8_t pinCsn) : spiMaster {spiMaster}, pinCsn {pinCsn} {
+Spi::Spi(SpiMaster& spiMaster, uint8_t pinCsn) : Spi(spiMaster, pinCsn, spiMaster.DefaultMode(), spiMaster.DefaultFrequency()) {
+}
+
+Spi::Spi(SpiMaster& spiMaster, uint8_t pinCsn, SpiMaster::Modes mode, SpiMaster::Frequencies frequency)
+  : spiMaster {spiMaster}, device {pinCsn, mode, frequency} {
   nrf_gpio_cfg_output(pinCsn);
   nrf_gpio_pin_set(pinCsn);
 }
 
 bool Spi::Write(const uint8_t* data, size_t size, const std::function<void()>& preTransactionHook) {
-  return spiMaster.Write(pinCsn, data, size, preTransactionHook);
+  return spiMaster.Write(device, data, size, preTransactionHook, nullptr);
+}
+
+bool Spi::Write(const uint8_t* data,
+                size_t size,
+                const std::function<void()>& preTransactionHook,
+                const std::function<void()>& postTransactionHook) {
+  return spiMaster.Write(device, data, size, preTransactionHook, postTransactionHook);
 }
 
 bool Spi::Read(uint8_t* cmd, size_t cmdSize, uint8_t* data, size_t dataSize) {
-  return spiMaster.Read(pinCsn, cmd, cmdSize, data, dataSize);
+  return spiMaster.Read(device, cmd, cmdSize, data, dataSize);
+}
+
+bool Spi::ReadAsync(const uint8_t* cmd, size_t cmdSize, uint8_t* data, size_t dataSize, const std::function<void()>& postTransactionHook) {
+  return spiMaster.ReadAsync(device, cmd, cmdSize, data, dataSize, postTransactionHook);
 }
 
 void Spi::Sleep() {
-  nrf_gpio_cfg_default(pinCsn);
+  nrf_gpio_cfg_default(device.pinCsn);
   NRF_LOG_INFO("[SPI] Sleep")
 }
 
 bool Spi::WriteCmdAndBuffer(const uint8_t* cmd, size_t cmdSize, const uint8_t* data, size_t dataSize) {
-  return spiMaster.WriteCmdAndBuffer(pinCsn, cmd, cmdSize, data, dataSize);
+  return spiMaster.WriteCmdAndBuffer(device, cmd, cmdSize, data, dataSize);
 }
 
 bool Spi::Init() {
-  nrf_gpio_cfg_output(pinCsn);
-  nrf_gpio_pin_set(pinCsn);
+  nrf_gpio_cfg_output(device.pinCsn);
+  nrf_gpio_pin_set(device.pinCsn);
   return true;
 }
 
 void Spi::Wakeup() {
-  nrf_gpio_cfg_output(pinCsn);
-  nrf_gpio_pin_set(pinCsn);
+  nrf_gpio_cfg_output(device.pinCsn);
+  nrf_gpio_pin_set(device.pinCsn);
   NRF_LOG_INFO("[SPI] Wakeup")
 }
+
+void Spi::SetFrequency(SpiMaster::Frequencies frequency) {
+  device.frequency = frequency;
+}
+
+SpiMaster::Frequencies Spi::GetFrequency() const {
+  return device.frequency;
+}
+
+void Spi::SetPriority(SpiMaster::Priorities priority) {
+  device.priority = priority;
+}
+
+uint32_t Spi::Throughput() const {
+  const uint32_t cycles = device.transferCycles;
+  if (cycles == 0) {
+    return 0;
+  }
+  return static_cast<uint32_t>((static_cast<uint64_t>(device.bytesTransferred) * SystemCoreClock) / cycles);
+}
+
+uint32_t Spi::MaxBusHoldUs() const {
+  return static_cast<uint32_t>((static_cast<uint64_t>(device.maxTransactionCycles) * 1000000) / SystemCoreClock);
+}
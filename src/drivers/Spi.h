@@ -9,6 +9,7 @@ namespace Pinetime {
     class Spi {
     public:
       Spi(SpiMaster& spiMaster, uint8_t pinCsn);
+      Spi(SpiMaster& spiMaster, uint8_t pinCsn, SpiMaster::Modes mode, SpiMaster::Frequencies frequency);
       Spi(const Spi&) = delete;
       Spi& operator=(const Spi&) = delete;
       Spi(Spi&&) = delete;
@@ -16,14 +17,30 @@ namespace Pinetime {
 
       bool Init();
       bool Write(const uint8_t* data, size_t size, const std::function<void()>& preTransactionHook);
+      bool Write(const uint8_t* data,
+                 size_t size,
+                 const std::function<void()>& preTransactionHook,
+                 const std::function<void()>& postTransactionHook);
       bool Read(uint8_t* cmd, size_t cmdSize, uint8_t* data, size_t dataSize);
+      bool ReadAsync(const uint8_t* cmd, size_t cmdSize, uint8_t* data, size_t dataSize, const std::function<void()>& postTransactionHook);
       bool WriteCmdAndBuffer(const uint8_t* cmd, size_t cmdSize, const uint8_t* data, size_t dataSize);
       void Sleep();
       void Wakeup();
 
+      // Applied from the next transaction on
+      void SetFrequency(SpiMaster::Frequencies frequency);
+      SpiMaster::Frequencies GetFrequency() const;
+      // Class of the transactions of this device for the bus arbiter, applied from the next transaction on
+      void SetPriority(SpiMaster::Priorities priority);
+
+      // Average throughput (bytes per second) while this device was selected
+      uint32_t Throughput() const;
+      // Longest time (microseconds) a single transaction of this device held the bus
+      uint32_t MaxBusHoldUs() const;
+
     private:
       SpiMaster& spiMaster;
-      uint8_t pinCsn;
+      SpiMaster::Device device;
     };
   }
 }
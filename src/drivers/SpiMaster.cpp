@@ -1,18 +1,38 @@
 #include "drivers/SpiMaster.h"
 #include <hal/nrf_gpio.h>
 #include <hal/nrf_spim.h>
+#include <hal/nrf_timer.h>
 #include <nrfx_log.h>
 #include <algorithm>
+#include <cstdint>
 
 using namespace Pinetime::Drivers;
 
+namespace {
+  // Counts the END events of an EasyDMA list transfer
+  NRF_TIMER_Type* const listTimer = NRF_TIMER3;
+
+  // A channel is free if nothing else has set it up yet (Init() is also called on wakeup)
+  [[maybe_unused]] bool PpiChannelAvailable(nrf_ppi_channel_t channel, uint32_t eventAddress) {
+    const uint32_t currentEvent = NRF_PPI->CH[channel].EEP;
+    return currentEvent == 0 || currentEvent == eventAddress;
+  }
+
+  // EasyDMA pointers and PPI endpoints are 32 bits registers
+  uint32_t Address(const volatile void* pointer) {
+    return static_cast<uint32_t>(reinterpret_cast<uintptr_t>(pointer));
+  }
+}
+
 SpiMaster::SpiMaster(const SpiMaster::SpiModule spi, const SpiMaster::Parameters& params) : spi {spi}, params {params} {
 }
 
 bool SpiMaster::Init() {
-  if (mutex == nullptr) {
-    mutex = xSemaphoreCreateBinary();
-    ASSERT(mutex != nullptr);
+  for (auto& granted : busGranted) {
+    if (granted == nullptr) {
+      granted = xSemaphoreCreateBinary();
+      ASSERT(granted != nullptr);
+    }
   }
 
   /* Configure GPIO pins used for pselsck, pselmosi, pselmiso and pselss for SPI0 */
@@ -40,27 +60,133 @@ bool SpiMaster::Init() {
   spiBaseAddress->PSELMOSI = params.pinMOSI;
   spiBaseAddress->PSELMISO = params.pinMISO;
 
-  uint32_t frequency;
-  switch (params.Frequency) {
+  currentFrequency = FrequencyRegister(params.Frequency);
+  currentConfig = ConfigRegister(params.bitOrder, params.mode);
+  spiBaseAddress->FREQUENCY = currentFrequency;
+  spiBaseAddress->CONFIG = currentConfig;
+  spiBaseAddress->EVENTS_ENDRX = 0;
+  spiBaseAddress->EVENTS_ENDTX = 0;
+  spiBaseAddress->EVENTS_END = 0;
+
+  spiBaseAddress->INTENSET = ((unsigned) 1 << (unsigned) 6);
+  spiBaseAddress->INTENSET = ((unsigned) 1 << (unsigned) 1);
+  spiBaseAddress->INTENSET = ((unsigned) 1 << (unsigned) 19);
+
+  spiBaseAddress->ENABLE = (SPIM_ENABLE_ENABLE_Enabled << SPIM_ENABLE_ENABLE_Pos);
+
+  NRFX_IRQ_PRIORITY_SET(SPIM0_SPIS0_TWIM0_TWIS0_SPI0_TWI0_IRQn, 2);
+  NRFX_IRQ_ENABLE(SPIM0_SPIS0_TWIM0_TWIS0_SPI0_TWI0_IRQn);
+
+  listTimer->TASKS_STOP = 1;
+  listTimer->MODE = TIMER_MODE_MODE_LowPowerCounter;
+  listTimer->BITMODE = TIMER_BITMODE_BITMODE_16Bit;
+  listTimer->INTENCLR = 0xFFFFFFFF;
+  listTimer->EVENTS_COMPARE[0] = 0;
+  listTimer->EVENTS_COMPARE[1] = 0;
+
+  const auto endEvent = Address(&spiBaseAddress->EVENTS_END);
+  const auto compareEvent = Address(&listTimer->EVENTS_COMPARE[0]);
+  ASSERT(PpiChannelAvailable(listRestartPpi, endEvent) && PpiChannelAvailable(listCountPpi, endEvent) &&
+         PpiChannelAvailable(listStopPpi, compareEvent));
+  ASSERT((NRF_PPI->CHG[listPpiGroup] & ~(1UL << listRestartPpi)) == 0);
+
+  // END -> START (next chunk of the list)
+  nrf_ppi_channel_endpoint_setup(listRestartPpi, endEvent, Address(&spiBaseAddress->TASKS_START));
+  // END -> COUNT, outside of the group so that the END of the last chunk is counted too
+  nrf_ppi_channel_endpoint_setup(listCountPpi, endEvent, Address(&listTimer->TASKS_COUNT));
+  // The last chunk has been started -> stop restarting the SPIM
+  nrf_ppi_channel_endpoint_setup(listStopPpi, compareEvent, Address(&NRF_PPI->TASKS_CHG[listPpiGroup].DIS));
+  nrf_ppi_channel_include_in_group(listRestartPpi, listPpiGroup);
+  nrf_ppi_channel_enable(listStopPpi);
+  listActive = false;
+
+  NRFX_IRQ_PRIORITY_SET(TIMER3_IRQn, 2);
+  NRFX_IRQ_ENABLE(TIMER3_IRQn);
+
+  ReleaseBus();
+  return true;
+}
+
+void SpiMaster::AcquireBus(Priorities priority) {
+  const auto index = static_cast<size_t>(priority);
+  taskENTER_CRITICAL();
+  if (!busTaken) {
+    busTaken = true;
+    taskEXIT_CRITICAL();
+    return;
+  }
+  busWaiters[index] = busWaiters[index] + 1;
+  taskEXIT_CRITICAL();
+
+  // ReleaseBus() passes the bus on without freeing it, so nobody can take it in between
+  [[maybe_unused]] auto ok = xSemaphoreTake(busGranted[index], portMAX_DELAY);
+  ASSERT(ok == pdTRUE);
+}
+
+// Must be called in a critical section. Returns the semaphore to give to the next owner, or nullptr if the bus is now free.
+SemaphoreHandle_t SpiMaster::NextBusOwner() {
+  for (size_t i = 0; i < nbPriorities; i++) {
+    if (busWaiters[i] > 0) {
+      busWaiters[i] = busWaiters[i] - 1;
+      return busGranted[i];
+    }
+  }
+  busTaken = false;
+  return nullptr;
+}
+
+void SpiMaster::ReleaseBus() {
+  taskENTER_CRITICAL();
+  SemaphoreHandle_t next = NextBusOwner();
+  taskEXIT_CRITICAL();
+
+  if (next != nullptr) {
+    xSemaphoreGive(next);
+  }
+}
+
+void SpiMaster::ReleaseBusFromISR() {
+  UBaseType_t interruptStatus = taskENTER_CRITICAL_FROM_ISR();
+  SemaphoreHandle_t next = NextBusOwner();
+  taskEXIT_CRITICAL_FROM_ISR(interruptStatus);
+
+  if (next != nullptr) {
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    xSemaphoreGiveFromISR(next, &xHigherPriorityTaskWoken);
+    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+  }
+}
+
+uint32_t SpiMaster::FrequencyRegister(Frequencies frequency) {
+  switch (frequency) {
+    case Frequencies::Freq125Khz:
+      return SPIM_FREQUENCY_FREQUENCY_K125;
+    case Frequencies::Freq250Khz:
+      return SPIM_FREQUENCY_FREQUENCY_K250;
+    case Frequencies::Freq500Khz:
+      return SPIM_FREQUENCY_FREQUENCY_K500;
+    case Frequencies::Freq1Mhz:
+      return SPIM_FREQUENCY_FREQUENCY_M1;
+    case Frequencies::Freq2Mhz:
+      return SPIM_FREQUENCY_FREQUENCY_M2;
+    case Frequencies::Freq4Mhz:
+      return SPIM_FREQUENCY_FREQUENCY_M4;
     case Frequencies::Freq8Mhz:
-      frequency = 0x80000000;
-      break;
     default:
-      return false;
+      return SPIM_FREQUENCY_FREQUENCY_M8;
   }
-  spiBaseAddress->FREQUENCY = frequency;
+}
 
+uint32_t SpiMaster::ConfigRegister(BitOrder bitOrder, Modes mode) {
   uint32_t regConfig = 0;
-  switch (params.bitOrder) {
+  switch (bitOrder) {
     case BitOrder::Msb_Lsb:
       break;
     case BitOrder::Lsb_Msb:
       regConfig = 1;
       break;
-    default:
-      return false;
   }
-  switch (params.mode) {
+  switch (mode) {
     case Modes::Mode0:
       break;
     case Modes::Mode1:
@@ -72,37 +198,58 @@ bool SpiMaster::Init() {
     case Modes::Mode3:
       regConfig |= (0x03 << 1);
       break;
-    default:
-      return false;
   }
+  return regConfig;
+}
 
-  spiBaseAddress->CONFIG = regConfig;
-  spiBaseAddress->EVENTS_ENDRX = 0;
-  spiBaseAddress->EVENTS_ENDTX = 0;
-  spiBaseAddress->EVENTS_END = 0;
+// Selects the device and applies its speed profile. Must be called with the bus acquired
+void SpiMaster::BeginTransaction(Device& device) {
+  currentDevice = &device;
+
+  const uint32_t frequency = FrequencyRegister(device.frequency);
+  const uint32_t config = ConfigRegister(params.bitOrder, device.mode);
+  if (frequency != currentFrequency || config != currentConfig) {
+    // FREQUENCY and CONFIG can only be changed while the peripheral is idle, which is
+    // guaranteed here since the previous transaction released the bus
+    spiBaseAddress->FREQUENCY = frequency;
+    spiBaseAddress->CONFIG = config;
+    currentFrequency = frequency;
+    currentConfig = config;
+  }
 
-  spiBaseAddress->INTENSET = ((unsigned) 1 << (unsigned) 6);
-  spiBaseAddress->INTENSET = ((unsigned) 1 << (unsigned) 1);
-  spiBaseAddress->INTENSET = ((unsigned) 1 << (unsigned) 19);
+  transactionStartCycles = DWT->CYCCNT;
+  nrf_gpio_pin_clear(device.pinCsn);
+}
 
-  spiBaseAddress->ENABLE = (SPIM_ENABLE_ENABLE_Enabled << SPIM_ENABLE_ENABLE_Pos);
+// Releases the chip select of the current device. Can be called from the SPI interrupt
+void SpiMaster::EndTransaction() {
+  nrf_gpio_pin_set(currentDevice->pinCsn);
 
-  NRFX_IRQ_PRIORITY_SET(SPIM0_SPIS0_TWIM0_TWIS0_SPI0_TWI0_IRQn, 2);
-  NRFX_IRQ_ENABLE(SPIM0_SPIS0_TWIM0_TWIS0_SPI0_TWI0_IRQn);
+  const uint32_t transactionCycles = DWT->CYCCNT - transactionStartCycles;
+  if (transactionCycles > currentDevice->maxTransactionCycles) {
+    currentDevice->maxTransactionCycles = transactionCycles;
+  }
 
-  xSemaphoreGive(mutex);
-  return true;
+  uint32_t cycles = currentDevice->transferCycles + transactionCycles;
+  uint32_t bytes = currentDevice->bytesTransferred;
+  // Halve both counters before they overflow, this keeps the ratio (throughput) meaningful
+  if (cycles > 0x80000000) {
+    cycles /= 2;
+    bytes /= 2;
+  }
+  currentDevice->transferCycles = cycles;
+  currentDevice->bytesTransferred = bytes;
 }
 
 void SpiMaster::SetupWorkaroundForErratum58() {
   nrfx_gpiote_pin_t pin = spiBaseAddress->PSEL.SCK;
-  nrfx_gpiote_in_config_t gpioteCfg = {.sense = NRF_GPIOTE_POLARITY_TOGGLE,
-                                       .pull = NRF_GPIO_PIN_NOPULL,
-                                       .is_watcher = false,
-                                       .hi_accuracy = true,
-                                       .skip_gpio_setup = true};
   if (!workaroundActive) {
     // Create an event when SCK toggles.
+    nrfx_gpiote_in_config_t gpioteCfg = {.sense = NRF_GPIOTE_POLARITY_TOGGLE,
+                                         .pull = NRF_GPIO_PIN_NOPULL,
+                                         .is_watcher = false,
+                                         .hi_accuracy = true,
+                                         .skip_gpio_setup = true};
     APP_ERROR_CHECK(nrfx_gpiote_in_init(pin, &gpioteCfg, NULL));
     nrfx_gpiote_in_event_enable(pin, false);
 
@@ -140,21 +287,27 @@ void SpiMaster::OnEndEvent() {
     return;
   }
 
-  auto s = currentBufferSize;
-  if (s > 0) {
-    auto currentSize = std::min((size_t) 255, s);
-    PrepareTx(currentBufferAddr, currentSize);
-    currentBufferAddr = currentBufferAddr + currentSize;
-    currentBufferSize = currentBufferSize - currentSize;
-
-    spiBaseAddress->TASKS_START = 1;
+  if (currentBufferSize > 0) {
+    StartNextTx();
+  } else if (currentRxBufferSize > 0) {
+    StartNextRx();
   } else {
-    nrf_gpio_pin_set(this->pinCsn);
+    EndTransaction();
     currentBufferAddr = 0;
-    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
-    xSemaphoreGiveFromISR(mutex, &xHigherPriorityTaskWoken);
-    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+    currentRxBufferAddr = 0;
+    if (postTransactionHook != nullptr) {
+      postTransactionHook();
+    }
+    ReleaseBusFromISR();
+  }
+}
+
+void SpiMaster::OnListEndEvent() {
+  if (!listActive) {
+    return;
   }
+  DisableListTransfer();
+  OnEndEvent();
 }
 
 void SpiMaster::OnStartedEvent() {
@@ -170,6 +323,87 @@ void SpiMaster::PrepareTx(const uint32_t bufferAddress, const size_t size) {
   spiBaseAddress->EVENTS_END = 0;
 }
 
+void SpiMaster::PrepareTxList(const uint32_t bufferAddress, const size_t chunkSize, const size_t chunkCount) {
+  spiBaseAddress->TXD.PTR = bufferAddress;
+  spiBaseAddress->TXD.MAXCNT = chunkSize;
+  spiBaseAddress->TXD.LIST = SPIM_TXD_LIST_LIST_ArrayList << SPIM_TXD_LIST_LIST_Pos;
+  spiBaseAddress->RXD.PTR = 0;
+  spiBaseAddress->RXD.MAXCNT = 0;
+  spiBaseAddress->RXD.LIST = 0;
+  spiBaseAddress->EVENTS_END = 0;
+
+  // Only the timer reports the end of the whole list, STARTED would otherwise interrupt every chunk
+  spiBaseAddress->INTENCLR = (1 << 6);
+  spiBaseAddress->INTENCLR = (1 << 19);
+
+  listTimer->TASKS_STOP = 1;
+  listTimer->TASKS_CLEAR = 1;
+  listTimer->CC[0] = chunkCount - 1;
+  listTimer->CC[1] = chunkCount;
+  listTimer->EVENTS_COMPARE[0] = 0;
+  listTimer->EVENTS_COMPARE[1] = 0;
+  listTimer->INTENSET = TIMER_INTENSET_COMPARE1_Msk;
+  listTimer->TASKS_START = 1;
+
+  nrf_ppi_channel_enable(listCountPpi);
+  nrf_ppi_group_enable(listPpiGroup);
+  listActive = true;
+}
+
+void SpiMaster::DisableListTransfer() {
+  nrf_ppi_group_disable(listPpiGroup);
+  nrf_ppi_channel_disable(listCountPpi);
+  listTimer->INTENCLR = TIMER_INTENCLR_COMPARE1_Msk;
+  listTimer->TASKS_STOP = 1;
+  listTimer->EVENTS_COMPARE[0] = 0;
+  listTimer->EVENTS_COMPARE[1] = 0;
+  listActive = false;
+
+  spiBaseAddress->TXD.LIST = 0;
+  spiBaseAddress->EVENTS_END = 0;
+  spiBaseAddress->EVENTS_STARTED = 0;
+  spiBaseAddress->INTENSET = (1 << 6);
+  spiBaseAddress->INTENSET = (1 << 19);
+}
+
+// Returns the largest chunk size (<= maxChunkSize) that divides size evenly,
+// or maxChunkSize if there is no such divisor larger than minListChunkSize.
+// A list needs at least 2 chunks: COMPARE0 (chunkCount - 1) would never match otherwise.
+size_t SpiMaster::ListChunkSize(size_t size) {
+  for (size_t chunkSize = maxChunkSize; chunkSize >= minListChunkSize; chunkSize--) {
+    if (size % chunkSize == 0) {
+      return chunkSize;
+    }
+  }
+  return maxChunkSize;
+}
+
+void SpiMaster::StartNextTx() {
+  const size_t chunkSize = ListChunkSize(currentBufferSize);
+  const size_t chunkCount = currentBufferSize / chunkSize;
+  if (chunkCount >= 2) {
+    // Send as much as possible as a single EasyDMA list. If the size is not a multiple of
+    // the chunk size, the remaining bytes are sent as a regular transfer afterwards.
+    PrepareTxList(currentBufferAddr, chunkSize, chunkCount);
+    currentBufferAddr = currentBufferAddr + (chunkSize * chunkCount);
+    currentBufferSize = currentBufferSize - (chunkSize * chunkCount);
+  } else {
+    const size_t currentSize = std::min(maxChunkSize, static_cast<size_t>(currentBufferSize));
+    PrepareTx(currentBufferAddr, currentSize);
+    currentBufferAddr = currentBufferAddr + currentSize;
+    currentBufferSize = currentBufferSize - currentSize;
+  }
+  spiBaseAddress->TASKS_START = 1;
+}
+
+void SpiMaster::StartNextRx() {
+  const size_t currentSize = std::min(maxChunkSize, static_cast<size_t>(currentRxBufferSize));
+  PrepareRx(currentRxBufferAddr, currentSize);
+  currentRxBufferAddr = currentRxBufferAddr + currentSize;
+  currentRxBufferSize = currentRxBufferSize - currentSize;
+  spiBaseAddress->TASKS_START = 1;
+}
+
 void SpiMaster::PrepareRx(const uint32_t bufferAddress, const size_t size) {
   spiBaseAddress->TXD.PTR = 0;
   spiBaseAddress->TXD.MAXCNT = 0;
@@ -180,13 +414,16 @@ void SpiMaster::PrepareRx(const uint32_t bufferAddress, const size_t size) {
   spiBaseAddress->EVENTS_END = 0;
 }
 
-bool SpiMaster::Write(uint8_t pinCsn, const uint8_t* data, size_t size, const std::function<void()>& preTransactionHook) {
+bool SpiMaster::Write(Device& device,
+                      const uint8_t* data,
+                      size_t size,
+                      const std::function<void()>& preTransactionHook,
+                      const std::function<void()>& postTransactionHook) {
   if (data == nullptr)
     return false;
-  auto ok = xSemaphoreTake(mutex, portMAX_DELAY);
-  ASSERT(ok == true);
+  AcquireBus(device.priority);
 
-  this->pinCsn = pinCsn;
+  this->postTransactionHook = postTransactionHook;
 
   if (size == 1) {
     SetupWorkaroundForErratum58();
@@ -197,63 +434,93 @@ bool SpiMaster::Write(uint8_t pinCsn, const uint8_t* data, size_t size, const st
   if (preTransactionHook != nullptr) {
     preTransactionHook();
   }
-  nrf_gpio_pin_clear(this->pinCsn);
+  device.bytesTransferred = device.bytesTransferred + size;
+  BeginTransaction(device);
 
-  currentBufferAddr = (uint32_t) data;
+  currentBufferAddr = Address(data);
   currentBufferSize = size;
 
-  auto currentSize = std::min((size_t) 255, (size_t) currentBufferSize);
-  PrepareTx(currentBufferAddr, currentSize);
-  currentBufferSize = currentBufferSize - currentSize;
-  currentBufferAddr = currentBufferAddr + currentSize;
-  spiBaseAddress->TASKS_START = 1;
+  StartNextTx();
 
   if (size == 1) {
     while (spiBaseAddress->EVENTS_END == 0)
       ;
-    nrf_gpio_pin_set(this->pinCsn);
+    EndTransaction();
     currentBufferAddr = 0;
+    if (postTransactionHook != nullptr) {
+      postTransactionHook();
+    }
 
     DisableWorkaroundForErratum58();
 
-    xSemaphoreGive(mutex);
+    ReleaseBus();
   }
 
   return true;
 }
 
-bool SpiMaster::Read(uint8_t pinCsn, uint8_t* cmd, size_t cmdSize, uint8_t* data, size_t dataSize) {
-  xSemaphoreTake(mutex, portMAX_DELAY);
+bool SpiMaster::Read(Device& device, uint8_t* cmd, size_t cmdSize, uint8_t* data, size_t dataSize) {
+  AcquireBus(device.priority);
 
-  this->pinCsn = pinCsn;
   DisableWorkaroundForErratum58();
   spiBaseAddress->INTENCLR = (1 << 6);
   spiBaseAddress->INTENCLR = (1 << 1);
   spiBaseAddress->INTENCLR = (1 << 19);
 
-  nrf_gpio_pin_clear(this->pinCsn);
+  device.bytesTransferred = device.bytesTransferred + cmdSize + dataSize;
+  BeginTransaction(device);
 
   currentBufferAddr = 0;
   currentBufferSize = 0;
 
-  PrepareTx((uint32_t) cmd, cmdSize);
+  PrepareTx(Address(cmd), cmdSize);
   spiBaseAddress->TASKS_START = 1;
   while (spiBaseAddress->EVENTS_END == 0)
     ;
 
-  PrepareRx((uint32_t) data, dataSize);
+  PrepareRx(Address(data), dataSize);
   spiBaseAddress->TASKS_START = 1;
 
   while (spiBaseAddress->EVENTS_END == 0)
     ;
-  nrf_gpio_pin_set(this->pinCsn);
+  EndTransaction();
+
+  ReleaseBus();
+
+  return true;
+}
+
+bool SpiMaster::ReadAsync(Device& device,
+                          const uint8_t* cmd,
+                          size_t cmdSize,
+                          uint8_t* data,
+                          size_t dataSize,
+                          const std::function<void()>& postTransactionHook) {
+  if (cmd == nullptr || cmdSize == 0 || cmdSize > maxCommandSize) {
+    return false;
+  }
+  AcquireBus(device.priority);
+
+  this->postTransactionHook = postTransactionHook;
+  DisableWorkaroundForErratum58();
+  std::copy(cmd, cmd + cmdSize, commandBuffer);
+
+  device.bytesTransferred = device.bytesTransferred + cmdSize + dataSize;
+  BeginTransaction(device);
 
-  xSemaphoreGive(mutex);
+  // The command is sent first, then OnEndEvent() receives the data in chunks of at most 255 bytes
+  currentBufferAddr = Address(commandBuffer);
+  currentBufferSize = cmdSize;
+  currentRxBufferAddr = Address(data);
+  currentRxBufferSize = (data != nullptr) ? dataSize : 0;
 
+  StartNextTx();
   return true;
 }
 
 void SpiMaster::Sleep() {
+  listTimer->TASKS_STOP = 1;
+  listTimer->TASKS_SHUTDOWN = 1;
   while (spiBaseAddress->ENABLE != 0) {
     spiBaseAddress->ENABLE = (SPIM_ENABLE_ENABLE_Disabled << SPIM_ENABLE_ENABLE_Pos);
   }
@@ -269,33 +536,39 @@ void SpiMaster::Wakeup() {
   NRF_LOG_INFO("[SPIMASTER] Wakeup");
 }
 
-bool SpiMaster::WriteCmdAndBuffer(uint8_t pinCsn, const uint8_t* cmd, size_t cmdSize, const uint8_t* data, size_t dataSize) {
-  xSemaphoreTake(mutex, portMAX_DELAY);
+bool SpiMaster::WriteCmdAndBuffer(Device& device, const uint8_t* cmd, size_t cmdSize, const uint8_t* data, size_t dataSize) {
+  AcquireBus(device.priority);
 
-  this->pinCsn = pinCsn;
   DisableWorkaroundForErratum58();
   spiBaseAddress->INTENCLR = (1 << 6);
   spiBaseAddress->INTENCLR = (1 << 1);
   spiBaseAddress->INTENCLR = (1 << 19);
 
-  nrf_gpio_pin_clear(this->pinCsn);
+  device.bytesTransferred = device.bytesTransferred + cmdSize + dataSize;
+  BeginTransaction(device);
 
   currentBufferAddr = 0;
   currentBufferSize = 0;
 
-  PrepareTx((uint32_t) cmd, cmdSize);
+  PrepareTx(Address(cmd), cmdSize);
   spiBaseAddress->TASKS_START = 1;
   while (spiBaseAddress->EVENTS_END == 0)
     ;
 
-  PrepareTx((uint32_t) data, dataSize);
-  spiBaseAddress->TASKS_START = 1;
+  // MAXCNT is 8 bits wide: a whole page takes 2 transfers, the chip select stays asserted in between
+  while (dataSize > 0) {
+    const size_t chunkSize = std::min(maxChunkSize, dataSize);
+    PrepareTx(Address(data), chunkSize);
+    spiBaseAddress->TASKS_START = 1;
 
-  while (spiBaseAddress->EVENTS_END == 0)
-    ;
-  nrf_gpio_pin_set(this->pinCsn);
+    while (spiBaseAddress->EVENTS_END == 0)
+      ;
+    data += chunkSize;
+    dataSize -= chunkSize;
+  }
+  EndTransaction();
 
-  xSemaphoreGive(mutex);
+  ReleaseBus();
 
   return true;
 }
@@ -16,7 +16,9 @@ namespace Pinetime {
       enum class SpiModule : uint8_t { SPI0, SPI1 };
       enum class BitOrder : uint8_t { Msb_Lsb, Lsb_Msb };
       enum class Modes : uint8_t { Mode0, Mode1, Mode2, Mode3 };
-      enum class Frequencies : uint8_t { Freq8Mhz };
+      enum class Frequencies : uint8_t { Freq125Khz, Freq250Khz, Freq500Khz, Freq1Mhz, Freq2Mhz, Freq4Mhz, Freq8Mhz };
+      // Order in which waiting transactions get the bus, highest priority first
+      enum class Priorities : uint8_t { DisplayFrame, FlashRead, FlashWrite, Default };
 
       struct Parameters {
         BitOrder bitOrder;
@@ -27,6 +29,20 @@ namespace Pinetime {
         uint8_t pinMISO;
       };
 
+      // Chip select and speed profile of a device on the bus (owned by Drivers::Spi).
+      // FREQUENCY and CONFIG are only reprogrammed when the profile differs from the previous transaction.
+      struct Device {
+        uint8_t pinCsn;
+        Modes mode;
+        Frequencies frequency;
+        Priorities priority = Priorities::Default;
+        // Bytes sent/received and CPU cycles spent with the chip select asserted
+        volatile uint32_t bytesTransferred = 0;
+        volatile uint32_t transferCycles = 0;
+        // Longest single transaction, i.e. the longest time this device kept the bus from the others
+        volatile uint32_t maxTransactionCycles = 0;
+      };
+
       SpiMaster(const SpiModule spi, const Parameters& params);
       SpiMaster(const SpiMaster&) = delete;
       SpiMaster& operator=(const SpiMaster&) = delete;
@@ -34,13 +50,34 @@ namespace Pinetime {
       SpiMaster& operator=(SpiMaster&&) = delete;
 
       bool Init();
-      bool Write(uint8_t pinCsn, const uint8_t* data, size_t size, const std::function<void()>& preTransactionHook);
-      bool Read(uint8_t pinCsn, uint8_t* cmd, size_t cmdSize, uint8_t* data, size_t dataSize);
+      bool Write(Device& device,
+                 const uint8_t* data,
+                 size_t size,
+                 const std::function<void()>& preTransactionHook,
+                 const std::function<void()>& postTransactionHook);
+      bool Read(Device& device, uint8_t* cmd, size_t cmdSize, uint8_t* data, size_t dataSize);
+      // Returns as soon as the command is being sent. The command is copied, the data buffer must stay valid
+      // until postTransactionHook is called (from the SPI interrupt) after the last byte has been received.
+      bool ReadAsync(Device& device,
+                     const uint8_t* cmd,
+                     size_t cmdSize,
+                     uint8_t* data,
+                     size_t dataSize,
+                     const std::function<void()>& postTransactionHook);
+
+      bool WriteCmdAndBuffer(Device& device, const uint8_t* cmd, size_t cmdSize, const uint8_t* data, size_t dataSize);
 
-      bool WriteCmdAndBuffer(uint8_t pinCsn, const uint8_t* cmd, size_t cmdSize, const uint8_t* data, size_t dataSize);
+      Modes DefaultMode() const {
+        return params.mode;
+      }
+
+      Frequencies DefaultFrequency() const {
+        return params.Frequency;
+      }
 
       void OnStartedEvent();
       void OnEndEvent();
+      void OnListEndEvent();
 
       void Sleep();
       void Wakeup();
@@ -48,20 +85,60 @@ namespace Pinetime {
     private:
       void SetupWorkaroundForErratum58();
       void DisableWorkaroundForErratum58();
-      void PrepareTx(const volatile uint32_t bufferAddress, const volatile size_t size);
-      void PrepareRx(const volatile uint32_t bufferAddress, const volatile size_t size);
+      void PrepareTx(const uint32_t bufferAddress, const size_t size);
+      void PrepareRx(const uint32_t bufferAddress, const size_t size);
+      void BeginTransaction(Device& device);
+      void EndTransaction();
+      static uint32_t FrequencyRegister(Frequencies frequency);
+      static uint32_t ConfigRegister(BitOrder bitOrder, Modes mode);
+      void PrepareTxList(const uint32_t bufferAddress, const size_t chunkSize, const size_t chunkCount);
+      void DisableListTransfer();
+      void StartNextTx();
+      void StartNextRx();
+      void AcquireBus(Priorities priority);
+      void ReleaseBus();
+      void ReleaseBusFromISR();
+      SemaphoreHandle_t NextBusOwner();
+      static size_t ListChunkSize(size_t size);
 
       NRF_SPIM_Type* spiBaseAddress;
-      uint8_t pinCsn;
+      Device* currentDevice = nullptr;
+      uint32_t transactionStartCycles = 0;
+      uint32_t currentFrequency = 0;
+      uint32_t currentConfig = 0;
 
       SpiMaster::SpiModule spi;
       SpiMaster::Parameters params;
 
       volatile uint32_t currentBufferAddr = 0;
       volatile size_t currentBufferSize = 0;
-      SemaphoreHandle_t mutex = nullptr;
+      volatile uint32_t currentRxBufferAddr = 0;
+      volatile size_t currentRxBufferSize = 0;
+      static constexpr size_t maxCommandSize = 8;
+      uint8_t commandBuffer[maxCommandSize];
+      // Called (from the SPI interrupt for asynchronous transfers) once the last byte has been sent
+      std::function<void()> postTransactionHook;
+
+      // Bus arbiter: on release, the bus is handed over to a waiter of the highest priority class
+      static constexpr size_t nbPriorities = static_cast<size_t>(Priorities::Default) + 1;
+      SemaphoreHandle_t busGranted[nbPriorities] = {};
+      volatile uint8_t busWaiters[nbPriorities] = {};
+      // Taken until Init() has been called
+      volatile bool busTaken = true;
       static constexpr nrf_ppi_channel_t workaroundPpi = NRF_PPI_CHANNEL0;
       bool workaroundActive = false;
+
+      // EasyDMA list transfers: END restarts the SPIM through PPI and TIMER3 counts the chunks,
+      // so that the CPU is only interrupted once the whole list has been sent.
+      // TIMER0 and PPI channels 4, 5 and 17 to 31 belong to NimBLE, TIMER2 holds the bootloader version.
+      // The restart channel is the only one in the group: the count channel must still see the last END.
+      static constexpr nrf_ppi_channel_t listRestartPpi = NRF_PPI_CHANNEL3;
+      static constexpr nrf_ppi_channel_t listStopPpi = NRF_PPI_CHANNEL6;
+      static constexpr nrf_ppi_channel_t listCountPpi = NRF_PPI_CHANNEL7;
+      static constexpr nrf_ppi_channel_group_t listPpiGroup = NRF_PPI_CHANNEL_GROUP0;
+      static constexpr size_t maxChunkSize = 255;
+      static constexpr size_t minListChunkSize = 128;
+      bool listActive = false;
     };
   }
 }
@@ -3,6 +3,8 @@
 #include <libraries/delay/nrf_delay.h>
 #include <libraries/log/nrf_log.h>
 #include "drivers/Spi.h"
+#include <algorithm>
+#include <cstring>
 
 using namespace Pinetime::Drivers;
 
@@ -10,6 +12,13 @@ SpiNorFlash::SpiNorFlash(Spi& spi) : spi {spi} {
 }
 
 void SpiNorFlash::Init() {
+  if (mutex == nullptr) {
+    mutex = xSemaphoreCreateMutex();
+  }
+  if (readDone == nullptr) {
+    readDone = xSemaphoreCreateBinary();
+  }
+  spi.SetPriority(SpiMaster::Priorities::FlashRead);
   device_id = ReadIdentification();
   NRF_LOG_INFO("[SpiNorFlash] Manufacturer : %d, Memory type : %d, memory density : %d",
                device_id.manufacturer,
@@ -21,6 +30,7 @@ void SpiNorFlash::Uninit() {
 }
 
 void SpiNorFlash::Sleep() {
+  Flush();
   auto cmd = static_cast<uint8_t>(Commands::DeepPowerDown);
   spi.Write(&cmd, sizeof(uint8_t), nullptr);
   NRF_LOG_INFO("[SpiNorFlash] Sleep")
@@ -71,12 +81,72 @@ uint8_t SpiNorFlash::ReadConfigurationRegister() {
 }
 
 void SpiNorFlash::Read(uint32_t address, uint8_t* buffer, size_t size) {
+  xSemaphoreTake(mutex, portMAX_DELAY);
+  if (size >= readAheadSize) {
+    ReadFromFlash(address, buffer, size);
+    xSemaphoreGive(mutex);
+    return;
+  }
+
+  bool sequential = (address == nextSequentialAddress);
+  nextSequentialAddress = address + size;
+  while (size > 0) {
+    if (address >= readAheadAddress && address < readAheadAddress + readAheadValid) {
+      const size_t offset = address - readAheadAddress;
+      const size_t toCopy = std::min(size, readAheadValid - offset);
+      std::memcpy(buffer, readAheadBuffer + offset, toCopy);
+      address += toCopy;
+      buffer += toCopy;
+      size -= toCopy;
+      // Whatever is left directly follows the window
+      sequential = true;
+    } else if (sequential) {
+      ReadFromFlash(address, readAheadBuffer, readAheadSize);
+      readAheadAddress = address;
+      readAheadValid = readAheadSize;
+    } else {
+      // Random access: don't pay for a whole window
+      ReadFromFlash(address, buffer, size);
+      break;
+    }
+  }
+  xSemaphoreGive(mutex);
+}
+
+void SpiNorFlash::ReadFromFlash(uint32_t address, uint8_t* buffer, size_t size) {
+  // The flash must hold the pending page before it is read back
+  if (writeBufferEnd > 0 && address < writeBufferAddress + pageSize && writeBufferAddress < address + size) {
+    FlushWriteBuffer();
+  }
+
+  // Sleep until the SPI interrupt reports the end of the transfer instead of busy waiting on it.
+  // Long reads are split so that the display does not wait for more than one chunk to get the bus.
+  while (size > 0) {
+    const size_t chunkSize = std::min(size, maxReadChunkSize);
+    ReadAsync(address, buffer, chunkSize);
+    xSemaphoreTake(readDone, portMAX_DELAY);
+    address += chunkSize;
+    buffer += chunkSize;
+    size -= chunkSize;
+  }
+}
+
+void SpiNorFlash::InvalidateReadAhead() {
+  readAheadValid = 0;
+  nextSequentialAddress = 0;
+}
+
+void SpiNorFlash::ReadAsync(uint32_t address, uint8_t* buffer, size_t size) {
   static constexpr uint8_t cmdSize = 4;
   uint8_t cmd[cmdSize] = {static_cast<uint8_t>(Commands::Read),
                           static_cast<uint8_t>(address >> 16U),
                           static_cast<uint8_t>(address >> 8U),
                           static_cast<uint8_t>(address)};
-  spi.Read(reinterpret_cast<uint8_t*>(&cmd), cmdSize, buffer, size);
+  spi.ReadAsync(cmd, cmdSize, buffer, size, [this]() {
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    xSemaphoreGiveFromISR(readDone, &xHigherPriorityTaskWoken);
+    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+  });
 }
 
 void SpiNorFlash::WriteEnable() {
@@ -91,14 +161,26 @@ void SpiNorFlash::SectorErase(uint32_t sectorAddress) {
                           static_cast<uint8_t>(sectorAddress >> 8U),
                           static_cast<uint8_t>(sectorAddress)};
 
+  // The mutex is held for the whole erase: the flash ignores everything but status reads until it is done, so
+  // other users would have to wait anyway. The task sleeps meanwhile and the bus is free between status polls.
+  xSemaphoreTake(mutex, portMAX_DELAY);
+  // Program the pending page first, the erase may cover it
+  FlushWriteBuffer();
+  InvalidateReadAhead();
+  spi.SetPriority(SpiMaster::Priorities::FlashWrite);
   WriteEnable();
-  while (!WriteEnabled())
-    vTaskDelay(1);
 
+  const TickType_t start = xTaskGetTickCount();
   spi.Read(reinterpret_cast<uint8_t*>(&cmd), cmdSize, nullptr, 0);
 
-  while (WriteInProgress())
-    vTaskDelay(1);
+  if (!WaitWhileBusy(sectorEraseTicks, sectorEraseTimeout)) {
+    eraseTimedOut = true;
+  }
+
+  spi.SetPriority(SpiMaster::Priorities::FlashRead);
+  statistics.sectorErases++;
+  statistics.maxEraseTicks = std::max(statistics.maxEraseTicks, xTaskGetTickCount() - start);
+  xSemaphoreGive(mutex);
 }
 
 uint8_t SpiNorFlash::ReadSecurityRegister() {
@@ -109,43 +191,125 @@ uint8_t SpiNorFlash::ReadSecurityRegister() {
 }
 
 bool SpiNorFlash::ProgramFailed() {
-  return (ReadSecurityRegister() & 0x20u) == 0x20u;
+  const bool timedOut = programTimedOut;
+  programTimedOut = false;
+  return timedOut || (ReadSecurityRegister() & 0x20u) == 0x20u;
 }
 
 bool SpiNorFlash::EraseFailed() {
-  return (ReadSecurityRegister() & 0x40u) == 0x40u;
+  const bool timedOut = eraseTimedOut;
+  eraseTimedOut = false;
+  return timedOut || (ReadSecurityRegister() & 0x40u) == 0x40u;
+}
+
+bool SpiNorFlash::WaitWhileBusy(TickType_t expectedTicks, TickType_t timeoutTicks) {
+  // Sleep through most of the operation, then poll with an increasing interval. Each poll is a
+  // separate SPI transaction, so the bus stays available to the display in between.
+  // The timeout counts the time slept between polls, not the ticks elapsed: a status read can wait for the bus
+  // and the task can be kept from running, an operation that completed meanwhile must not be reported as failed.
+  vTaskDelay(expectedTicks);
+  TickType_t waited = expectedTicks;
+  TickType_t pollInterval = 1;
+  while (WriteInProgress()) {
+    if (waited >= timeoutTicks) {
+      NRF_LOG_INFO("[SpiNorFlash] Timeout while waiting for the end of a write/erase");
+      return false;
+    }
+    vTaskDelay(pollInterval);
+    waited += pollInterval;
+    pollInterval = std::min<TickType_t>(pollInterval * 2, maxPollInterval);
+  }
+  return true;
 }
 
 void SpiNorFlash::Write(uint32_t address, const uint8_t* buffer, size_t size) {
-  static constexpr uint8_t cmdSize = 4;
+  xSemaphoreTake(mutex, portMAX_DELAY);
+  InvalidateReadAhead();
+  while (size > 0) {
+    const uint32_t pageAddress = address & ~(pageSize - 1u);
+    const uint16_t offset = address - pageAddress;
+    const uint16_t toWrite = std::min<size_t>(size, pageSize - offset);
 
-  size_t len = size;
-  uint32_t addr = address;
-  const uint8_t* b = buffer;
-  while (len > 0) {
-    uint32_t pageLimit = (addr & ~(pageSize - 1u)) + pageSize;
-    uint32_t toWrite = pageLimit - addr > len ? len : pageLimit - addr;
+    if (writeBufferEnd > 0 && writeBufferAddress != pageAddress) {
+      FlushWriteBuffer();
+    }
 
-    uint8_t cmd[cmdSize] = {static_cast<uint8_t>(Commands::PageProgram),
-                            static_cast<uint8_t>(addr >> 16U),
-                            static_cast<uint8_t>(addr >> 8U),
-                            static_cast<uint8_t>(addr)};
+    if (writeBufferEnd == 0 && toWrite == pageSize) {
+      // Whole page, no need to go through the buffer
+      ProgramPage(pageAddress, buffer, pageSize);
+    } else {
+      if (writeBufferEnd == 0) {
+        std::memset(writeBuffer, 0xFF, pageSize);
+        writeBufferAddress = pageAddress;
+        writeBufferStart = offset;
+        writeBufferEnd = offset + toWrite;
+      }
+      // Programming can only clear bits, writing the same bytes twice results in their AND
+      for (uint16_t i = 0; i < toWrite; i++) {
+        writeBuffer[offset + i] &= buffer[i];
+      }
+      writeBufferStart = std::min(writeBufferStart, offset);
+      writeBufferEnd = std::max<uint16_t>(writeBufferEnd, offset + toWrite);
 
-    WriteEnable();
-    while (!WriteEnabled())
-      vTaskDelay(1);
+      if (writeBufferStart == 0 && writeBufferEnd == pageSize) {
+        FlushWriteBuffer();
+      }
+    }
 
-    spi.WriteCmdAndBuffer(cmd, cmdSize, b, toWrite);
+    address += toWrite;
+    buffer += toWrite;
+    size -= toWrite;
+  }
+  xSemaphoreGive(mutex);
+}
 
-    while (WriteInProgress())
-      vTaskDelay(1);
+void SpiNorFlash::Flush() {
+  xSemaphoreTake(mutex, portMAX_DELAY);
+  FlushWriteBuffer();
+  xSemaphoreGive(mutex);
+}
 
-    addr += toWrite;
-    b += toWrite;
-    len -= toWrite;
+void SpiNorFlash::FlushWriteBuffer() {
+  if (writeBufferEnd == 0) {
+    return;
   }
+  ProgramPage(writeBufferAddress + writeBufferStart, writeBuffer + writeBufferStart, writeBufferEnd - writeBufferStart);
+  writeBufferStart = 0;
+  writeBufferEnd = 0;
+}
+
+void SpiNorFlash::ProgramPage(uint32_t address, const uint8_t* buffer, size_t size) {
+  static constexpr uint8_t cmdSize = 4;
+  uint8_t cmd[cmdSize] = {static_cast<uint8_t>(Commands::PageProgram),
+                          static_cast<uint8_t>(address >> 16U),
+                          static_cast<uint8_t>(address >> 8U),
+                          static_cast<uint8_t>(address)};
+
+  spi.SetPriority(SpiMaster::Priorities::FlashWrite);
+  // The write enable latch is set as soon as the command is sent, no need to read it back
+  WriteEnable();
+
+  const TickType_t start = xTaskGetTickCount();
+  spi.WriteCmdAndBuffer(cmd, cmdSize, buffer, size);
+
+  if (!WaitWhileBusy(pageProgramTicks, pageProgramTimeout)) {
+    programTimedOut = true;
+  }
+  spi.SetPriority(SpiMaster::Priorities::FlashRead);
+
+  statistics.pagePrograms++;
+  statistics.bytesProgrammed += size;
+  statistics.maxProgramTicks = std::max(statistics.maxProgramTicks, xTaskGetTickCount() - start);
 }
 
 SpiNorFlash::Identification SpiNorFlash::GetIdentification() const {
   return device_id;
 }
+
+uint32_t SpiNorFlash::SpiThroughput() const {
+  return spi.Throughput();
+}
+
+uint32_t SpiNorFlash::MaxBusHoldUs() const {
+  return spi.MaxBusHoldUs();
+}
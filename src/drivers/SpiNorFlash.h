@@ -1,6 +1,9 @@
 #pragma once
 #include <cstddef>
 #include <cstdint>
+#include <FreeRTOS.h>
+#include <semphr.h>
+#include <task.h>
 
 namespace Pinetime {
   namespace Drivers {
@@ -24,8 +27,12 @@ namespace Pinetime {
       bool WriteInProgress();
       bool WriteEnabled();
       uint8_t ReadConfigurationRegister();
+      // The calling task sleeps while the data is transferred, the SPI interrupt wakes it up once buffer is filled
       void Read(uint32_t address, uint8_t* buffer, size_t size);
+      // Writes are collected in a page buffer and programmed once the page is complete, when another page is
+      // written, when an overlapping area is read or erased, or when Flush() is called.
       void Write(uint32_t address, const uint8_t* buffer, size_t size);
+      void Flush();
       void WriteEnable();
       void SectorErase(uint32_t sectorAddress);
       uint8_t ReadSecurityRegister();
@@ -34,6 +41,24 @@ namespace Pinetime {
 
       Identification GetIdentification() const;
 
+      // Bytes per second while the flash is selected on the SPI bus
+      uint32_t SpiThroughput() const;
+      // Longest single SPI transaction of the flash, in microseconds
+      uint32_t MaxBusHoldUs() const;
+
+      // Wear and latency counters since boot, worst cases are in FreeRTOS ticks
+      struct Statistics {
+        uint32_t sectorErases = 0;
+        uint32_t pagePrograms = 0;
+        uint32_t bytesProgrammed = 0;
+        TickType_t maxEraseTicks = 0;
+        TickType_t maxProgramTicks = 0;
+      };
+
+      const Statistics& GetStatistics() const {
+        return statistics;
+      }
+
       void Init();
       void Uninit();
 
@@ -42,6 +67,14 @@ namespace Pinetime {
 
     private:
       Identification ReadIdentification();
+      void ReadFromFlash(uint32_t address, uint8_t* buffer, size_t size);
+      // Starts the read and returns immediately, readDone is given from the SPI interrupt once the data is in buffer.
+      // Must be called with the mutex taken, after the pending page has been flushed.
+      void ReadAsync(uint32_t address, uint8_t* buffer, size_t size);
+      void InvalidateReadAhead();
+      void FlushWriteBuffer();
+      void ProgramPage(uint32_t address, const uint8_t* buffer, size_t size);
+      bool WaitWhileBusy(TickType_t expectedTicks, TickType_t timeoutTicks);
 
       enum class Commands : uint8_t {
         PageProgram = 0x02,
@@ -56,9 +89,43 @@ namespace Pinetime {
         DeepPowerDown = 0xB9
       };
       static constexpr uint16_t pageSize = 256;
+      // Typical page program time is below 1ms, wait that long before polling the status register.
+      // Timeouts are in ticks spent sleeping between polls, see WaitWhileBusy().
+      static constexpr TickType_t pageProgramTicks = 1;
+      static constexpr TickType_t pageProgramTimeout = pdMS_TO_TICKS(10);
+      // Typical sector erase time is 30-50ms, the datasheets give 300ms as the maximum
+      static constexpr TickType_t sectorEraseTicks = pdMS_TO_TICKS(30);
+      static constexpr TickType_t sectorEraseTimeout = pdMS_TO_TICKS(500);
+      static constexpr TickType_t maxPollInterval = pdMS_TO_TICKS(8);
 
       Spi& spi;
       Identification device_id;
+
+      // Small sequential reads (littlefs reads 16 bytes at a time) are served from a read-ahead window
+      // so that a run of consecutive reads costs one command header per window instead of one per read.
+      static constexpr size_t readAheadSize = 256;
+      // Longest read done in a single SPI transaction (~1ms at 8MHz)
+      static constexpr size_t maxReadChunkSize = 1024;
+      uint8_t readAheadBuffer[readAheadSize];
+      uint32_t readAheadAddress = 0;
+      size_t readAheadValid = 0;
+      uint32_t nextSequentialAddress = 0;
+
+      // Pending page program. Bytes that were not written are 0xFF, which leaves the flash untouched.
+      uint8_t writeBuffer[pageSize];
+      uint32_t writeBufferAddress = 0;
+      uint16_t writeBufferStart = 0;
+      uint16_t writeBufferEnd = 0;
+
+      // Protects the read-ahead window and the write buffer
+      SemaphoreHandle_t mutex = nullptr;
+      // Given by the SPI interrupt at the end of ReadAsync(). Task notifications are disabled in FreeRTOSConfig.h.
+      SemaphoreHandle_t readDone = nullptr;
+
+      Statistics statistics;
+      // Reported (and cleared) by ProgramFailed() and EraseFailed()
+      bool programTimedOut = false;
+      bool eraseTimedOut = false;
     };
   }
 }
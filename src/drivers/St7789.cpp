@@ -11,6 +11,7 @@ St7789::St7789(Spi& spi, uint8_t pinDataCommand, uint8_t pinReset) : spi {spi},
 }
 
 void St7789::Init() {
+  spi.SetPriority(SpiMaster::Priorities::DisplayFrame);
   nrf_gpio_cfg_output(pinDataCommand);
   nrf_gpio_cfg_output(pinReset);
   nrf_gpio_pin_set(pinReset);
@@ -18,7 +19,7 @@ void St7789::Init() {
   SoftwareReset();
   Command2Enable();
   SleepOut();
-  PixelFormat();
+  PixelFormat(pixelFormat16Bit);
   MemoryDataAccessControl();
   SetAddrWindow(0, 0, Width, Height);
 // P8B Mirrored version does not need display inversion.
@@ -39,10 +40,14 @@ void St7789::WriteData(uint8_t data) {
   WriteData(&data, 1);
 }
 
-void St7789::WriteData(const uint8_t* data, size_t size) {
-  WriteSpi(data, size, [pinDataCommand = pinDataCommand]() {
-    nrf_gpio_pin_set(pinDataCommand);
-  });
+void St7789::WriteData(const uint8_t* data, size_t size, const std::function<void()>& postTransactionHook) {
+  WriteSpi(
+    data,
+    size,
+    [pinDataCommand = pinDataCommand]() {
+      nrf_gpio_pin_set(pinDataCommand);
+    },
+    postTransactionHook);
 }
 
 void St7789::WriteCommand(uint8_t data) {
@@ -55,8 +60,11 @@ void St7789::WriteCommand(const uint8_t* data, size_t size) {
   });
 }
 
-void St7789::WriteSpi(const uint8_t* data, size_t size, const std::function<void()>& preTransactionHook) {
-  spi.Write(data, size, preTransactionHook);
+void St7789::WriteSpi(const uint8_t* data,
+                      size_t size,
+                      const std::function<void()>& preTransactionHook,
+                      const std::function<void()>& postTransactionHook) {
+  spi.Write(data, size, preTransactionHook, postTransactionHook);
 }
 
 void St7789::SoftwareReset() {
@@ -114,10 +122,9 @@ void St7789::SleepIn() {
   sleepIn = true;
 }
 
-void St7789::PixelFormat() {
+void St7789::PixelFormat(uint8_t format) {
   WriteCommand(static_cast<uint8_t>(Commands::PixelFormat));
-  // 65K colours, 16-bit per pixel
-  WriteData(0x55);
+  WriteData(format);
 }
 
 void St7789::MemoryDataAccessControl() {
@@ -237,9 +244,9 @@ void St7789::SetAddrWindow(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1) {
   WriteData(addrWindowArgs, sizeof(addrWindowArgs));
 }
 
-void St7789::WriteToRam(const uint8_t* data, size_t size) {
+void St7789::WriteToRam(const uint8_t* data, size_t size, const std::function<void()>& transferDoneHook) {
   WriteCommand(static_cast<uint8_t>(Commands::WriteToRam));
-  WriteData(data, size);
+  WriteData(data, size, transferDoneHook);
 }
 
 void St7789::SetVdv() {
@@ -268,8 +275,18 @@ void St7789::Uninit() {
 }
 
 void St7789::DrawBuffer(uint16_t x, uint16_t y, uint16_t width, uint16_t height, const uint8_t* data, size_t size) {
+  DrawBuffer(x, y, width, height, data, size, nullptr);
+}
+
+void St7789::DrawBuffer(uint16_t x,
+                        uint16_t y,
+                        uint16_t width,
+                        uint16_t height,
+                        const uint8_t* data,
+                        size_t size,
+                        const std::function<void()>& transferDoneHook) {
   SetAddrWindow(x, y, x + width - 1, y + height - 1);
-  WriteToRam(data, size);
+  WriteToRam(data, size, transferDoneHook);
 }
 
 void St7789::HardwareReset() {
@@ -286,10 +303,20 @@ void St7789::HardwareReset() {
 void St7789::LowPowerOn() {
   IdleModeOn();
   IdleFrameRateOn();
+  PixelFormat(pixelFormat12Bit);
+  // Only the frequency set out of low power mode is restored by LowPowerOff()
+  if (!lowPower) {
+    normalFrequency = spi.GetFrequency();
+    lowPower = true;
+  }
+  spi.SetFrequency(lowPowerFrequency);
   NRF_LOG_INFO("[LCD] Low power mode");
 }
 
 void St7789::LowPowerOff() {
+  spi.SetFrequency(normalFrequency);
+  lowPower = false;
+  PixelFormat(pixelFormat16Bit);
   IdleModeOff();
   IdleFrameRateOff();
   NRF_LOG_INFO("[LCD] Normal power mode");
@@ -308,3 +335,28 @@ void St7789::Wakeup() {
   DisplayOn();
   NRF_LOG_INFO("[LCD] Wakeup")
 }
+
+uint32_t St7789::SpiThroughput() const {
+  return spi.Throughput();
+}
+
+size_t St7789::PackLowPowerPixels(uint8_t* data, size_t nbPixels) {
+  // RGB565 pixels are sent MSB first: RRRRRGGG GGGBBBBB. Only the 4 MSB of each channel are kept,
+  // the idle mode only shows the MSB anyway. Writes never overtake reads, so this works in place.
+  auto rgb444 = [](const uint8_t* pixel) -> uint16_t {
+    const uint8_t red = pixel[0] >> 4;
+    const uint8_t green = ((pixel[0] & 0x07) << 1) | (pixel[1] >> 7);
+    const uint8_t blue = (pixel[1] >> 1) & 0x0f;
+    return (red << 8) | (green << 4) | blue;
+  };
+
+  uint8_t* packed = data;
+  for (size_t i = 0; i < nbPixels; i += 2) {
+    const uint16_t first = rgb444(data + (i * 2));
+    const uint16_t second = rgb444(data + (i * 2) + 2);
+    *packed++ = first >> 4;
+    *packed++ = ((first & 0x0f) << 4) | (second >> 8);
+    *packed++ = second;
+  }
+  return packed - data;
+}
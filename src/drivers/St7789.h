@@ -4,6 +4,7 @@
 #include <functional>
 
 #include <FreeRTOS.h>
+#include "drivers/SpiMaster.h"
 
 namespace Pinetime {
   namespace Drivers {
@@ -23,17 +24,41 @@ namespace Pinetime {
       void VerticalScrollStartAddress(uint16_t line);
 
       void DrawBuffer(uint16_t x, uint16_t y, uint16_t width, uint16_t height, const uint8_t* data, size_t size);
+      // transferDoneHook is called from the SPI interrupt once the whole buffer has been sent
+      void DrawBuffer(uint16_t x,
+                      uint16_t y,
+                      uint16_t width,
+                      uint16_t height,
+                      const uint8_t* data,
+                      size_t size,
+                      const std::function<void()>& transferDoneHook);
 
+      // Low power mode uses the idle mode, which only shows 8 colours: pixels are then sent with 12 bits
+      // instead of 16 and must be packed with PackLowPowerPixels()
       void LowPowerOn();
       void LowPowerOff();
       void Sleep();
       void Wakeup();
 
+      // Bytes per second while the LCD is selected on the SPI bus
+      uint32_t SpiThroughput() const;
+
+      // Packs nbPixels (an even number) byte-swapped RGB565 pixels in place into the low power mode
+      // format, RGB444 with 2 pixels in 3 bytes. Return the size of the packed data.
+      static size_t PackLowPowerPixels(uint8_t* data, size_t nbPixels);
+
     private:
       Spi& spi;
       uint8_t pinDataCommand;
       uint8_t pinReset;
-      uint8_t verticalScrollingStartAddress = 0;
+      uint16_t verticalScrollingStartAddress = 0;
+      // Always on display only redraws small areas: slow down the SPI clock to save power
+      static constexpr SpiMaster::Frequencies lowPowerFrequency = SpiMaster::Frequencies::Freq2Mhz;
+      SpiMaster::Frequencies normalFrequency = SpiMaster::Frequencies::Freq8Mhz;
+      bool lowPower = false;
+      // 65K colours, 16 and 12 bits per pixel
+      static constexpr uint8_t pixelFormat16Bit = 0x55;
+      static constexpr uint8_t pixelFormat12Bit = 0x53;
       bool sleepIn;
       TickType_t lastSleepExit;
 
@@ -43,11 +68,11 @@ namespace Pinetime {
       void SleepOut();
       void EnsureSleepOutPostDelay();
       void SleepIn();
-      void PixelFormat();
+      void PixelFormat(uint8_t format);
       void MemoryDataAccessControl();
       void DisplayInversionOn();
       void NormalModeOn();
-      void WriteToRam(const uint8_t* data, size_t size);
+      void WriteToRam(const uint8_t* data, size_t size, const std::function<void()>& transferDoneHook);
       void IdleModeOn();
       void IdleModeOff();
       void FrameRateNormalSet();
@@ -63,7 +88,10 @@ namespace Pinetime {
       void SetVdv();
       void WriteCommand(uint8_t cmd);
       void WriteCommand(const uint8_t* data, size_t size);
-      void WriteSpi(const uint8_t* data, size_t size, const std::function<void()>& preTransactionHook);
+      void WriteSpi(const uint8_t* data,
+                    size_t size,
+                    const std::function<void()>& preTransactionHook,
+                    const std::function<void()>& postTransactionHook = nullptr);
 
       enum class Commands : uint8_t {
         SoftwareReset = 0x01,
@@ -92,7 +120,7 @@ namespace Pinetime {
         Porch = 0xb2,
       };
       void WriteData(uint8_t data);
-      void WriteData(const uint8_t* data, size_t size);
+      void WriteData(const uint8_t* data, size_t size, const std::function<void()>& postTransactionHook = nullptr);
 
       static constexpr uint16_t Width = 240;
       static constexpr uint16_t Height = 320;
@@ -1,6 +1,7 @@
 #include "heartratetask/HeartRateTask.h"
 #include <drivers/Hrs3300.h>
 #include <components/heartrate/HeartRateController.h>
+#include <components/motion/MotionController.h>
 #include <limits>
 
 #include "utility/Math.h"
@@ -9,6 +10,10 @@ using namespace Pinetime::Applications;
 
 namespace {
   constexpr TickType_t backgroundMeasurementTimeLimit = 30 * configTICK_RATE_HZ;
+  // Above this, the arm moves too much for a reliable measurement (standard deviation of ~0.1g, 1g = 1024)
+  constexpr uint32_t motionVarianceThreshold = 100 * 100;
+  // Background measurements deferred because of motion are retried after this delay
+  constexpr TickType_t motionRetryDelay = 10 * configTICK_RATE_HZ;
 }
 
 std::optional<TickType_t> HeartRateTask::BackgroundMeasurementInterval() const {
@@ -27,6 +32,10 @@ bool HeartRateTask::BackgroundMeasurementNeeded() const {
   return xTaskGetTickCount() - lastMeasurementTime >= backgroundPeriod.value();
 };
 
+bool HeartRateTask::IsMoving() const {
+  return motionController.MotionVariance() > motionVarianceThreshold;
+}
+
 TickType_t HeartRateTask::CurrentTaskDelay() {
   auto backgroundPeriod = BackgroundMeasurementInterval();
   TickType_t currentTime = xTaskGetTickCount();
@@ -73,7 +82,10 @@ TickType_t HeartRateTask::CurrentTaskDelay() {
       if (currentTime - lastMeasurementTime < backgroundPeriod.value()) {
         return backgroundPeriod.value() - (currentTime - lastMeasurementTime);
       }
-      // If one is due now, go straight away
+      // If one is due now, go straight away, unless the arm moves
+      if (IsMoving()) {
+        return motionRetryDelay;
+      }
       return 0;
     case States::BackgroundMeasuring:
     case States::ForegroundMeasuring:
@@ -86,8 +98,9 @@ TickType_t HeartRateTask::CurrentTaskDelay() {
 
 HeartRateTask::HeartRateTask(Drivers::Hrs3300& heartRateSensor,
                              Controllers::HeartRateController& controller,
+                             Controllers::MotionController& motionController,
                              Controllers::Settings& settings)
-  : heartRateSensor {heartRateSensor}, controller {controller}, settings {settings} {
+  : heartRateSensor {heartRateSensor}, controller {controller}, motionController {motionController}, settings {settings} {
 }
 
 void HeartRateTask::Start() {
@@ -149,7 +162,8 @@ void HeartRateTask::Work() {
           break;
       }
     }
-    if (newState == States::Waiting && BackgroundMeasurementNeeded()) {
+    // Background measurements are deferred while the arm moves: they would likely fail and keep the sensor on
+    if (newState == States::Waiting && BackgroundMeasurementNeeded() && !IsMoving()) {
       newState = States::BackgroundMeasuring;
     } else if (newState == States::BackgroundMeasuring && !BackgroundMeasurementNeeded()) {
       newState = States::Waiting;
@@ -195,7 +209,9 @@ void HeartRateTask::StopMeasurement() {
 
 void HeartRateTask::HandleSensorData() {
   auto sensorData = heartRateSensor.ReadHrsAls();
-  int8_t ambient = ppg.Preprocess(sensorData.hrs, sensorData.als);
+  uint16_t acceleration = motionController.AccelerationMagnitude();
+  controller.UpdateSample(count, sensorData.hrs, sensorData.als, acceleration);
+  int8_t ambient = ppg.Preprocess(sensorData.hrs, sensorData.als, acceleration);
   int bpm = ppg.HeartRate();
 
   // Ambient light detected
@@ -14,6 +14,7 @@ namespace Pinetime {
 
   namespace Controllers {
     class HeartRateController;
+    class MotionController;
   }
 
   namespace Applications {
@@ -23,6 +24,7 @@ namespace Pinetime {
 
       explicit HeartRateTask(Drivers::Hrs3300& heartRateSensor,
                              Controllers::HeartRateController& controller,
+                             Controllers::MotionController& motionController,
                              Controllers::Settings& settings);
       void Start();
       void Work();
@@ -36,6 +38,7 @@ namespace Pinetime {
       void StopMeasurement();
 
       [[nodiscard]] bool BackgroundMeasurementNeeded() const;
+      [[nodiscard]] bool IsMoving() const;
       [[nodiscard]] std::optional<TickType_t> BackgroundMeasurementInterval() const;
       TickType_t CurrentTaskDelay();
 
@@ -47,6 +50,7 @@ namespace Pinetime {
       uint16_t count;
       Drivers::Hrs3300& heartRateSensor;
       Controllers::HeartRateController& controller;
+      Controllers::MotionController& motionController;
       Controllers::Settings& settings;
       Controllers::Ppg ppg;
       TickType_t lastMeasurementTime;
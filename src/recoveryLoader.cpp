@@ -72,6 +72,13 @@ void SPIM0_SPIS0_TWIM0_TWIS0_SPI0_TWI0_IRQHandler(void) {
     NRF_SPIM0->EVENTS_STOPPED = 0;
   }
 }
+
+void TIMER3_IRQHandler(void) {
+  if (NRF_TIMER3->EVENTS_COMPARE[1] == 1) {
+    NRF_TIMER3->EVENTS_COMPARE[1] = 0;
+    spi.OnListEndEvent();
+  }
+}
 }
 
 void RefreshWatchdog() {
@@ -109,6 +116,7 @@ void Process(void* /*instance*/) {
     DisplayProgressBar((static_cast<float>(offset) / static_cast<float>(sizeof(recoveryImage))) * 100.0f, colorWhite);
     RefreshWatchdog();
   }
+  spiNorFlash.Flush();
   NRF_LOG_INFO("Writing factory image done!");
   DisplayProgressBar(100.0f, colorGreen);
 
@@ -9,8 +9,10 @@ import os.path
 import argparse
 import subprocess
 
-def gen_lvconv_line(lv_img_conv: str, dest: str, color_format: str, output_format: str, binary_format: str, sources: str):
+def gen_lvconv_line(lv_img_conv: str, dest: str, color_format: str, output_format: str, binary_format: str, sources: str, compress: bool = False):
     args = [lv_img_conv, sources, '--force', '--output-file', dest, '--color-format', color_format, '--output-format', output_format, '--binary-format', binary_format]
+    if compress:
+        args.append('--compress')
     if lv_img_conv.endswith(".py"):
         # lv_img_conv is a python script, call with current python executable
         args = [sys.executable] + args
@@ -23,6 +23,90 @@ def classify_pixel(value, bits):
     return val
 
 
+# see src/displayapp/ImageDecoder.h
+LV_IMG_CF_USER_ENCODED_0 = 24
+RLE_LINES_PER_INDEX = 16
+
+
+def rle_compress(line, unit):
+    """PackBits on pixels of `unit` bytes: a control byte c < 128 is followed by c + 1
+    raw pixels, c >= 128 by a single pixel repeated c - 126 times.
+    """
+    pixels = [bytes(line[i:i + unit]) for i in range(0, len(line), unit)]
+    out = bytearray()
+    literals = []
+
+    def flush_literals():
+        while literals:
+            chunk = literals[:128]
+            del literals[:128]
+            out.append(len(chunk) - 1)
+            for pixel in chunk:
+                out.extend(pixel)
+
+    i = 0
+    while i < len(pixels):
+        run = 1
+        while i + run < len(pixels) and run < 129 and pixels[i + run] == pixels[i]:
+            run += 1
+        if run >= 2:
+            flush_literals()
+            out.append(126 + run)
+            out += pixels[i]
+            i += run
+        else:
+            literals.append(pixels[i])
+            i += 1
+    flush_literals()
+    return bytes(out)
+
+
+def rle_decompress(data, unit):
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        control = data[i]
+        i += 1
+        if control < 128:
+            size = (control + 1) * unit
+            out += data[i:i + size]
+            i += size
+        else:
+            out += data[i:i + unit] * (control - 126)
+            i += unit
+    return bytes(out)
+
+
+def rle_compress_image(lv_cf, width, height, buf):
+    """Compress every line on its own, with an index of every RLE_LINES_PER_INDEX-th line
+    so that the decoder can seek to any line without decoding the whole image.
+    """
+    palette = b''
+    if lv_cf == 7:  # CF_INDEXED_1_BIT: 8 palette bytes, then 8 pixels per byte
+        palette, buf = buf[:8], buf[8:]
+        unit = 1
+        line_size = (width + 7) // 8
+    else:
+        unit = 3 if lv_cf == 5 else 2
+        line_size = width * unit
+    index = bytearray()
+    data = bytearray()
+    for y in range(height):
+        if y % RLE_LINES_PER_INDEX == 0:
+            index += len(data).to_bytes(4, "little")
+        data += rle_compress(buf[y * line_size:(y + 1) * line_size], unit)
+    return bytes([lv_cf, RLE_LINES_PER_INDEX, 0, 0]) + palette + bytes(index) + bytes(data)
+
+
+def test_rle_compress():
+    line = bytes([1, 2, 3] * 5 + [4, 5, 6, 7, 8, 9] + [1, 2, 3] * 200)
+    compressed = rle_compress(line, 3)
+    assert len(compressed) < len(line)
+    assert rle_decompress(compressed, 3) == line
+    line = bytes(range(256)) * 2
+    assert rle_decompress(rle_compress(line, 1), 1) == line
+
+
 def test_classify_pixel():
     # test difference between round() and round_half_up()
     assert classify_pixel(18, 5) == 16
@@ -64,6 +148,9 @@ def main():
     parser.add_argument("-s", "--swap-endian",
         help="swap endian of image (not implemented)",
         action="store_true")
+    parser.add_argument("-z", "--compress",
+        help="compress the image line by line (binary output only, decoded by InfiniTime's ImageDecoder)",
+        action="store_true")
     parser.add_argument("-d", "--dither",
         help="enable dither (not implemented)",
         action="store_true")
@@ -175,6 +262,11 @@ def main():
         case _:
             # raise just to be sure
             raise NotImplementedError(f"args.color_format '{args.color_format}' not implemented")
+    if args.compress:
+        raw_size = len(buf)
+        buf = rle_compress_image(lv_cf, img_width, img_height, buf)
+        print(f"Compressed {raw_size} bytes to {len(buf)} ({100 * len(buf) // raw_size}%)")
+        lv_cf = LV_IMG_CF_USER_ENCODED_0
     header_32bit = lv_cf | (img_width << 10) | (img_height << 21)
     buf_out = bytearray(4 + len(buf))
     buf_out[0] = header_32bit & 0xFF
@@ -194,6 +286,7 @@ if __name__ == '__main__':
         # run small set of tests and exit
         print("running tests")
         test_classify_pixel()
+        test_rle_compress()
         print("success!")
         sys.exit(0)
     # run normal program
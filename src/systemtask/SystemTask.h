@@ -48,6 +48,7 @@ namespace Pinetime {
     class Battery;
     class TouchHandler;
     class ButtonHandler;
+    class FrameProfiler;
   }
 
   namespace System {
@@ -74,7 +75,8 @@ namespace Pinetime {
                  Pinetime::Applications::HeartRateTask& heartRateApp,
                  Pinetime::Controllers::FS& fs,
                  Pinetime::Controllers::TouchHandler& touchHandler,
-                 Pinetime::Controllers::ButtonHandler& buttonHandler);
+                 Pinetime::Controllers::ButtonHandler& buttonHandler,
+                 Pinetime::Controllers::FrameProfiler& frameProfiler);
 
       void Start();
       void PushMessage(Messages msg);
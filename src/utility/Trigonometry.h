@@ -0,0 +1,86 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <numbers>
+
+namespace Pinetime {
+  namespace Utility {
+    namespace Detail {
+      // Taylor series of sin(x), enough terms for 0 <= x <= pi / 2
+      constexpr double SineSeries(double x) {
+        double term = x;
+        double sum = x;
+        for (int n = 1; n < 10; n++) {
+          term *= -x * x / ((2 * n) * ((2 * n) + 1));
+          sum += term;
+        }
+        return sum;
+      }
+
+      // Quarter wave, one entry per degree. sin(30) * 32767 is exactly halfway between 2 integers, the margin
+      // makes it round up whatever the accuracy of the series.
+      constexpr std::array<int16_t, 91> MakeSineTable() {
+        std::array<int16_t, 91> table {};
+        for (size_t i = 0; i < table.size(); i++) {
+          table[i] = static_cast<int16_t>((SineSeries(static_cast<double>(i) * std::numbers::pi / 180) * 32767) + 0.5 + 1e-9);
+        }
+        return table;
+      }
+
+      inline constexpr std::array<int16_t, 91> SineTable = MakeSineTable();
+    }
+
+    // sin(x), x in radians. Slow, meant for tables computed at compile time.
+    constexpr double SineRadians(double x) {
+      while (x < 0) {
+        x += 2 * std::numbers::pi;
+      }
+      while (x >= 2 * std::numbers::pi) {
+        x -= 2 * std::numbers::pi;
+      }
+      if (x > std::numbers::pi) {
+        return -SineRadians(x - std::numbers::pi);
+      }
+      return Detail::SineSeries((x > std::numbers::pi / 2) ? std::numbers::pi - x : x);
+    }
+
+    // 1.0 in the Q15 fixed point format returned by Sine() and Cosine()
+    constexpr int16_t Q15One = 32767;
+
+    // Sine of angle, in degrees, in Q15
+    constexpr int16_t Sine(int32_t angle) {
+      angle %= 360;
+      if (angle < 0) {
+        angle += 360;
+      }
+      if (angle <= 90) {
+        return Detail::SineTable[angle];
+      }
+      if (angle <= 180) {
+        return Detail::SineTable[180 - angle];
+      }
+      if (angle <= 270) {
+        return -Detail::SineTable[angle - 180];
+      }
+      return -Detail::SineTable[360 - angle];
+    }
+
+    // Cosine of angle, in degrees, in Q15
+    constexpr int16_t Cosine(int32_t angle) {
+      return Sine((angle % 360) + 90);
+    }
+
+    // value * factor, factor in Q15, rounded to the nearest integer
+    constexpr int32_t MultiplyQ15(int32_t value, int16_t factor) {
+      // RoundedDiv(product, 32768) without the divisions
+      const int32_t product = value * factor;
+      return (product >= 0) ? (product + 16384) >> 15 : -((16384 - product) >> 15);
+    }
+
+    static_assert(Sine(0) == 0 && Sine(30) == 16384 && Sine(90) == Q15One && Sine(-90) == -Q15One);
+    static_assert(Cosine(0) == Q15One && Cosine(180) == -Q15One && Cosine(-60) == Sine(30));
+    static_assert(MultiplyQ15(110, Q15One) == 110 && MultiplyQ15(-20, Sine(30)) == -10);
+  }
+}
@@ -0,0 +1,162 @@
+// FftQ15 against a double precision DFT of the same Q15 values: the windows that the FFT engines transform for the
+// PPG traces (detrended, band-pass filtered and Hann windowed like Ppg.cpp does in float), at the largest amplitude
+// of the FIXED_POINT engine and at a weak one, and a sinusoid centered on each bin.
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <numbers>
+#include <string>
+#include <vector>
+#include "Check.h"
+#include "components/heartrate/FftQ15.h"
+
+using namespace Pinetime::Controllers;
+using namespace Pinetime::Host;
+
+namespace {
+  constexpr size_t length = 64;
+  // Samples between two windows, like overlapWindow of Ppg
+  constexpr size_t windowStep = 5;
+  // Largest magnitude error, in units of the last bit of the result (2^scale): the rounding of the products and of
+  // the halvings of each of the 6 stages, and the square root rounded down
+  constexpr double maxErrorLsb = 8.0;
+
+  using Window = std::array<int16_t, length>;
+
+  struct Statistics {
+    uint32_t windows = 0;
+    double worstLsb = 0.0;
+    // Of the error against the largest magnitude of the window
+    double worstRelative = 0.0;
+  };
+
+  // Detrend(), Filter30to240() and the Hann window of the FFT engine, in double
+  std::array<double, length> Preprocess(const uint16_t* samples) {
+    std::array<double, length> signal;
+    const double slope = static_cast<double>(samples[length - 1] - samples[0]) / (length - 1);
+    for (size_t i = 0; i < length - 1; i++) {
+      signal[i] = samples[i + 1] - samples[i] - slope;
+    }
+    signal[length - 1] = 0.0;
+    for (int loop = 0; loop < 4; loop++) {
+      double average = signal.front();
+      for (double& value : signal) {
+        average = (0.816 * value) + (0.184 * average);
+        value = average;
+      }
+    }
+    for (int loop = 0; loop < 4; loop++) {
+      double average = signal.front();
+      for (double& value : signal) {
+        average = (0.268 * value) + (0.732 * average);
+        value -= average;
+      }
+    }
+    for (size_t i = 0; i < length; i++) {
+      const double sine = std::sin(std::numbers::pi * static_cast<double>(i) / (length - 1));
+      signal[i] *= sine * sine;
+    }
+    return signal;
+  }
+
+  // Scaled to a largest value of 2^bits
+  Window Quantize(const std::array<double, length>& signal, int bits) {
+    double largest = 0.0;
+    for (double value : signal) {
+      largest = std::max(largest, std::abs(value));
+    }
+    Window window {};
+    for (size_t i = 0; i < length && largest > 0.0; i++) {
+      window[i] = static_cast<int16_t>(std::lround(signal[i] * (1 << bits) / largest));
+    }
+    return window;
+  }
+
+  void Compare(const Window& window, Statistics& statistics) {
+    std::array<int16_t, length> real = window;
+    std::array<int16_t, length> imag {};
+    const int scale = FftQ15<length>::Compute(real.data(), imag.data());
+
+    std::array<double, length / 2> expected;
+    double largest = 0.0;
+    for (size_t bin = 0; bin < expected.size(); bin++) {
+      std::complex<double> sum;
+      for (size_t i = 0; i < length; i++) {
+        sum += static_cast<double>(window[i]) * std::polar(1.0, -2 * std::numbers::pi * static_cast<double>(bin * i) / length);
+      }
+      expected[bin] = std::abs(sum);
+      largest = std::max(largest, expected[bin]);
+    }
+    for (size_t bin = 0; bin < expected.size(); bin++) {
+      const double actual = std::ldexp(FftQ15<length>::Magnitude(real[bin], imag[bin]), scale);
+      const double error = std::abs(actual - expected[bin]);
+      statistics.worstLsb = std::max(statistics.worstLsb, std::ldexp(error, -scale));
+      if (largest > 0.0) {
+        statistics.worstRelative = std::max(statistics.worstRelative, error / largest);
+      }
+    }
+    statistics.windows++;
+  }
+
+  void Report(const char* name, const Statistics& statistics) {
+    std::printf("%-32s %5u windows: worst error %4.2f LSB, %6.3f%% of the peak\n",
+                name,
+                statistics.windows,
+                statistics.worstLsb,
+                statistics.worstRelative * 100);
+    CHECK(statistics.windows > 0);
+    CHECK(statistics.worstLsb <= maxErrorLsb);
+  }
+
+  std::vector<uint16_t> LoadTrace(const std::filesystem::path& path) {
+    std::ifstream input {path};
+    std::vector<uint16_t> samples;
+    std::string line;
+    while (std::getline(input, line)) {
+      if (!line.empty() && line[0] != '#') {
+        samples.push_back(static_cast<uint16_t>(std::stoul(line)));
+      }
+    }
+    return samples;
+  }
+}
+
+int main() {
+  std::vector<std::filesystem::path> paths;
+  for (const auto& entry : std::filesystem::directory_iterator {TRACES_DIR}) {
+    if (entry.path().extension() == ".csv") {
+      paths.push_back(entry.path());
+    }
+  }
+  std::sort(paths.begin(), paths.end());
+
+  // The FIXED_POINT engine scales the detrended signal to 13 bits, the filters and the window keep it about there
+  Statistics strong;
+  Statistics weak;
+  for (const auto& path : paths) {
+    const std::vector<uint16_t> samples = LoadTrace(path);
+    for (size_t start = 0; start + length <= samples.size(); start += windowStep) {
+      const std::array<double, length> signal = Preprocess(&samples[start]);
+      Compare(Quantize(signal, 13), strong);
+      Compare(Quantize(signal, 6), weak);
+    }
+  }
+  Report("PPG traces, 13 bits", strong);
+  Report("PPG traces, 6 bits", weak);
+
+  Statistics sinusoids;
+  for (size_t bin = 0; bin < length / 2; bin++) {
+    for (int bits : {2, 8, 14}) {
+      std::array<double, length> signal;
+      for (size_t i = 0; i < length; i++) {
+        signal[i] = std::cos((2 * std::numbers::pi * static_cast<double>(bin * i) / length) + 0.3);
+      }
+      Compare(Quantize(signal, bits), sinusoids);
+    }
+  }
+  Report("sinusoids, 2 to 14 bits", sinusoids);
+  return Failures() != 0;
+}
@@ -0,0 +1,253 @@
+// FS and littlefs on the NOR flash model, under the write workloads of the watch. Writes a JSON report with
+// the throughput, the flash wear and the worst latencies of each workload to stdout, or to the file given as
+// the first argument. There are no reference figures to compare with: the test only fails if the data read back
+// is wrong or if the flash receives commands it would reject. Compare the reports of two builds to see the
+// effect of a change.
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "Check.h"
+#include "FlashHarness.h"
+#include "components/fs/FS.h"
+
+using namespace Pinetime::Controllers;
+using namespace Pinetime::Host;
+
+namespace {
+  FlashHarness harness;
+
+  // Payload of a WRITE_DATA request of the FS service with a 247 bytes ATT MTU
+  constexpr uint32_t bleChunkSize = 200;
+  constexpr uint32_t settingsSize = 128;
+  constexpr int settingsSaves = 200;
+  constexpr uint32_t uploadSize = 32 * 1024;
+  constexpr uint32_t heartRateRecordSize = 8;
+  constexpr int heartRateRecords = 2000;
+
+  struct Report {
+    const char* name;
+    uint32_t operations = 0;
+    uint64_t bytes = 0;
+    Time duration = 0;
+    Latency operation;
+    uint32_t sectorErases = 0;
+    uint32_t pagePrograms = 0;
+    uint32_t bytesProgrammed = 0;
+  };
+
+  std::vector<Report> reports;
+
+  // Measures the flash activity of a workload
+  class Workload {
+  public:
+    explicit Workload(const char* name) : start {Now()}, flash {harness.flash.statistics} {
+      report.name = name;
+    }
+
+    // One file system operation of the workload
+    template <class Operation>
+    void Run(uint32_t bytes, Operation operation) {
+      const Time operationStart = Now();
+      operation();
+      report.operation.Add(Now() - operationStart);
+      report.operations++;
+      report.bytes += bytes;
+    }
+
+    ~Workload() {
+      const auto& statistics = harness.flash.statistics;
+      report.duration = Now() - start;
+      report.sectorErases = statistics.sectorErases - flash.sectorErases;
+      report.pagePrograms = statistics.pagePrograms - flash.pagePrograms;
+      report.bytesProgrammed = statistics.bytesProgrammed - flash.bytesProgrammed;
+      reports.push_back(report);
+    }
+
+  private:
+    Report report;
+    Time start;
+    NorFlash::Statistics flash;
+  };
+
+  uint8_t Pattern(uint32_t position) {
+    return static_cast<uint8_t>(position * 29 + (position >> 9));
+  }
+
+  void Fill(uint8_t* data, uint32_t position, uint32_t size) {
+    for (uint32_t i = 0; i < size; i++) {
+      data[i] = Pattern(position + i);
+    }
+  }
+
+  // Same sequence of calls as FSService for a WRITE_DATA request
+  void BleWriteChunk(FS& fs, const char* path, uint32_t offset, const uint8_t* data, uint32_t size) {
+    lfs_file_t file;
+    CHECK_EQUAL(LFS_ERR_OK, fs.FileOpen(&file, path, LFS_O_RDWR | LFS_O_CREAT));
+    CHECK(fs.FileSeek(&file, offset) >= 0);
+    CHECK_EQUAL(static_cast<int>(size), fs.FileWrite(&file, data, size));
+    fs.FileClose(&file);
+  }
+
+  void BleUpload(FS& fs, Workload& workload, const char* path, uint32_t size) {
+    uint8_t data[bleChunkSize];
+    for (uint32_t offset = 0; offset < size; offset += bleChunkSize) {
+      const uint32_t chunk = std::min(bleChunkSize, size - offset);
+      Fill(data, offset, chunk);
+      workload.Run(chunk, [&]() {
+        BleWriteChunk(fs, path, offset, data, chunk);
+      });
+    }
+  }
+
+  bool Verify(FS& fs, const char* path, uint32_t size) {
+    lfs_file_t file;
+    if (fs.FileOpen(&file, path, LFS_O_RDONLY) != LFS_ERR_OK) {
+      return false;
+    }
+    bool valid = fs.FileSize(&file) == static_cast<int>(size);
+    uint8_t data[256];
+    for (uint32_t position = 0; valid && position < size; position += sizeof(data)) {
+      const uint32_t chunk = std::min<uint32_t>(sizeof(data), size - position);
+      valid = fs.FileRead(&file, data, chunk) == static_cast<int>(chunk);
+      for (uint32_t i = 0; valid && i < chunk; i++) {
+        valid = data[i] == Pattern(position + i);
+      }
+    }
+    fs.FileClose(&file);
+    return valid;
+  }
+
+  void SettingsSaves(FS& fs) {
+    Workload workload {"settings_save"};
+    uint8_t settings[settingsSize];
+    for (int i = 0; i < settingsSaves; i++) {
+      Fill(settings, i, settingsSize);
+      // Settings::SaveSettingsToFile()
+      workload.Run(settingsSize, [&]() {
+        lfs_file_t file;
+        CHECK_EQUAL(LFS_ERR_OK, fs.FileOpen(&file, "/settings.dat", LFS_O_WRONLY | LFS_O_CREAT));
+        CHECK_EQUAL(static_cast<int>(settingsSize), fs.FileWrite(&file, settings, settingsSize));
+        fs.FileClose(&file);
+      });
+    }
+  }
+
+  // Replaces an installed resource package: the old files are deleted, the new ones uploaded over BLE
+  void ResourcePackageInstall(FS& fs) {
+    static constexpr struct {
+      const char* path;
+      uint32_t size;
+    } files[] = {
+      {"/fonts/teko.bin", 5 * 1024},
+      {"/fonts/bebas.bin", 8 * 1024},
+      {"/fonts/lv_font_dots_40.bin", 3 * 1024},
+      {"/fonts/7segments_40.bin", 2 * 1024},
+      {"/fonts/7segments_115.bin", 6 * 1024},
+      {"/images/pine_small.bin", 7 * 1024},
+      {"/images/navigation0.bin", 24 * 1024},
+      {"/images/navigation1.bin", 24 * 1024},
+    };
+    for (int install = 0; install < 2; install++) {
+      Workload workload {install == 0 ? "resource_install" : "resource_update"};
+      workload.Run(0, [&]() {
+        fs.DirCreate("/fonts");
+        fs.DirCreate("/images");
+      });
+      for (const auto& file : files) {
+        workload.Run(0, [&]() {
+          fs.FileDelete(file.path);
+        });
+        BleUpload(fs, workload, file.path, file.size);
+      }
+    }
+    for (const auto& file : files) {
+      CHECK(Verify(fs, file.path, file.size));
+    }
+  }
+
+  void BleUploads(FS& fs) {
+    Workload workload {"ble_upload"};
+    BleUpload(fs, workload, "/upload.bin", uploadSize);
+    CHECK(Verify(fs, "/upload.bin", uploadSize));
+  }
+
+  void HeartRateLog(FS& fs) {
+    Workload workload {"heart_rate_log_append"};
+    uint8_t record[heartRateRecordSize];
+    for (int i = 0; i < heartRateRecords; i++) {
+      Fill(record, i * heartRateRecordSize, heartRateRecordSize);
+      workload.Run(heartRateRecordSize, [&]() {
+        lfs_file_t file;
+        CHECK_EQUAL(LFS_ERR_OK, fs.FileOpen(&file, "/hr.log", LFS_O_WRONLY | LFS_O_CREAT | LFS_O_APPEND));
+        CHECK_EQUAL(static_cast<int>(heartRateRecordSize), fs.FileWrite(&file, record, heartRateRecordSize));
+        fs.FileClose(&file);
+      });
+    }
+    CHECK(Verify(fs, "/hr.log", heartRateRecords * heartRateRecordSize));
+  }
+
+  void WriteJson(FILE* output) {
+    std::fprintf(output, "{\n  \"workloads\": [\n");
+    for (size_t i = 0; i < reports.size(); i++) {
+      const Report& report = reports[i];
+      std::fprintf(output,
+                   "    {\"name\": \"%s\", \"operations\": %u, \"bytes\": %llu, \"duration_us\": %llu, "
+                   "\"throughput_bytes_per_s\": %llu, \"average_operation_us\": %llu, \"worst_operation_us\": %llu, "
+                   "\"sector_erases\": %u, \"page_programs\": %u, \"bytes_programmed\": %u}%s\n",
+                   report.name,
+                   report.operations,
+                   static_cast<unsigned long long>(report.bytes),
+                   static_cast<unsigned long long>(report.duration / 1000),
+                   static_cast<unsigned long long>(Throughput(report.bytes, report.duration)),
+                   static_cast<unsigned long long>(report.operation.Average() / 1000),
+                   static_cast<unsigned long long>(report.operation.worst / 1000),
+                   report.sectorErases,
+                   report.pagePrograms,
+                   report.bytesProgrammed,
+                   (i + 1 < reports.size()) ? "," : "");
+    }
+    // The driver keeps the worst cases since boot, in ticks of 1/1024 s
+    const auto& driver = harness.spiNorFlash.GetStatistics();
+    std::fprintf(output,
+                 "  ],\n  \"max_sector_erases\": %u,\n  \"worst_erase_ticks\": %u,\n  \"worst_program_ticks\": %u,\n"
+                 "  \"flash_busy_violations\": %u\n}\n",
+                 harness.flash.MaxSectorEraseCount(),
+                 static_cast<unsigned>(driver.maxEraseTicks),
+                 static_cast<unsigned>(driver.maxProgramTicks),
+                 harness.flash.statistics.busyViolations);
+  }
+}
+
+int main(int argc, char** argv) {
+  Spawn("fs", 1, []() {
+    harness.Init();
+    FS fs {harness.spiNorFlash};
+    {
+      Workload workload {"format_and_mount"};
+      workload.Run(0, [&]() {
+        fs.Init();
+      });
+    }
+    ResourcePackageInstall(fs);
+    SettingsSaves(fs);
+    BleUploads(fs);
+    HeartRateLog(fs);
+  });
+  Run();
+
+  FILE* output = (argc > 1) ? std::fopen(argv[1], "w") : stdout;
+  if (output == nullptr) {
+    std::perror(argv[1]);
+    return 1;
+  }
+  WriteJson(output);
+  if (output != stdout) {
+    std::fclose(output);
+  }
+
+  CHECK_EQUAL(0u, harness.flash.statistics.busyViolations);
+  CHECK_EQUAL(0u, harness.flash.statistics.writeEnableViolations);
+  CHECK_EQUAL(0u, harness.flash.statistics.pageWraps);
+  return Failures() != 0;
+}
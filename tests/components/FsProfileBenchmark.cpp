@@ -0,0 +1,136 @@
+// Mount time, directory listing time, open latency and read throughput of the FS cache profile this benchmark is
+// compiled with (FS_PROFILE_MINIMAL, FS_PROFILE_BALANCED or FS_PROFILE_PERFORMANCE). Prints one key=value line.
+// Files are opened while FS::longLivedFiles other files are kept open, like on the watch: they must all fit in the
+// arena of the profile.
+#include <cstdio>
+#include <cstring>
+#include "Check.h"
+#include "FlashHarness.h"
+#include "components/fs/FS.h"
+
+using namespace Pinetime::Controllers;
+using namespace Pinetime::Host;
+
+namespace {
+  FlashHarness harness;
+
+  // About the size of fonts/bebas.bin, read by lv_font_load() with small reads
+  constexpr uint32_t fontSize = 8 * 1024;
+  constexpr size_t nbImages = 24;
+  constexpr int openRepetitions = 20;
+
+  uint8_t Pattern(uint32_t position) {
+    return static_cast<uint8_t>(position * 13 + (position >> 8));
+  }
+
+  void WriteFile(FS& fs, const char* path, uint32_t size) {
+    lfs_file_t file;
+    CHECK_EQUAL(LFS_ERR_OK, fs.FileOpen(&file, path, LFS_O_WRONLY | LFS_O_CREAT | LFS_O_TRUNC));
+    uint8_t data[256];
+    for (uint32_t position = 0; position < size; position += sizeof(data)) {
+      const uint32_t chunk = std::min<uint32_t>(sizeof(data), size - position);
+      for (uint32_t i = 0; i < chunk; i++) {
+        data[i] = Pattern(position + i);
+      }
+      CHECK_EQUAL(static_cast<int>(chunk), fs.FileWrite(&file, data, chunk));
+    }
+    CHECK_EQUAL(LFS_ERR_OK, fs.FileClose(&file));
+  }
+
+  // The file system of a watch with a resource package installed
+  void Populate(FS& fs) {
+    fs.DirCreate("/fonts");
+    fs.DirCreate("/images");
+    WriteFile(fs, "/fonts/bebas.bin", fontSize);
+    char path[32];
+    for (size_t i = 0; i < nbImages; i++) {
+      std::snprintf(path, sizeof(path), "/images/image%zu.bin", i);
+      WriteFile(fs, path, 1024 + 512 * (i % 6));
+    }
+    WriteFile(fs, "/settings.dat", 120);
+  }
+
+  Time ReadFile(FS& fs, const char* path, uint32_t size, uint32_t readSize) {
+    lfs_file_t file;
+    uint8_t data[1024];
+    CHECK_EQUAL(LFS_ERR_OK, fs.FileOpen(&file, path, LFS_O_RDONLY));
+    const Time start = Now();
+    for (uint32_t position = 0; position < size; position += readSize) {
+      CHECK_EQUAL(static_cast<int>(readSize), fs.FileRead(&file, data, readSize));
+      CHECK(data[0] == Pattern(position) && data[readSize - 1] == Pattern(position + readSize - 1));
+    }
+    const Time duration = Now() - start;
+    fs.FileClose(&file);
+    return duration;
+  }
+}
+
+int main() {
+  Spawn("fs", 1, []() {
+    harness.Init();
+    {
+      FS fs {harness.spiNorFlash};
+      fs.Init();
+      Populate(fs);
+    }
+
+    FS fs {harness.spiNorFlash};
+    const Time mountStart = Now();
+    fs.Init();
+    const Time mount = Now() - mountStart;
+
+    // Like the file list of the FS service
+    const Time listStart = Now();
+    lfs_dir_t dir;
+    lfs_info info;
+    size_t entries = 0;
+    CHECK_EQUAL(LFS_ERR_OK, fs.DirOpen("/images", &dir));
+    while (fs.DirRead(&dir, &info) > 0) {
+      entries++;
+    }
+    fs.DirClose(&dir);
+    const Time list = Now() - listStart;
+    // . and ..
+    CHECK_EQUAL(nbImages + 2, entries);
+
+    // Files kept open by the F: drive and the static layer of the analog face
+    lfs_file_t longLived[FS::longLivedFiles];
+    char name[32];
+    for (size_t i = 0; i < FS::longLivedFiles; i++) {
+      std::snprintf(name, sizeof(name), "/images/image%zu.bin", i);
+      CHECK_EQUAL(LFS_ERR_OK, fs.FileOpen(&longLived[i], name, LFS_O_RDONLY));
+    }
+
+    Latency open;
+    for (int i = 0; i < openRepetitions; i++) {
+      lfs_file_t file;
+      const char* path = (i % 2 == 0) ? "/fonts/bebas.bin" : "/images/image17.bin";
+      const Time start = Now();
+      CHECK_EQUAL(LFS_ERR_OK, fs.FileOpen(&file, path, LFS_O_RDONLY));
+      open.Add(Now() - start);
+      fs.FileClose(&file);
+    }
+
+    const Time read16 = ReadFile(fs, "/fonts/bebas.bin", fontSize, 16);
+    const Time read1k = ReadFile(fs, "/fonts/bebas.bin", fontSize, 1024);
+    for (auto& file : longLived) {
+      fs.FileClose(&file);
+    }
+
+    std::printf("profile=%s mount_us=%llu list_us=%llu open_avg_us=%llu open_max_us=%llu read16_bytes_per_s=%llu "
+                "read1k_bytes_per_s=%llu flash_reads=%u\n",
+                FS_PROFILE_NAME,
+                static_cast<unsigned long long>(mount / 1000),
+                static_cast<unsigned long long>(list / 1000),
+                static_cast<unsigned long long>(open.Average() / 1000),
+                static_cast<unsigned long long>(open.worst / 1000),
+                static_cast<unsigned long long>(Throughput(fontSize, read16)),
+                static_cast<unsigned long long>(Throughput(fontSize, read1k)),
+                harness.flash.statistics.reads);
+  });
+  Run();
+
+  CHECK_EQUAL(0u, harness.flash.statistics.busyViolations);
+  CHECK_EQUAL(0u, harness.flash.statistics.pageWraps);
+  return Failures() != 0;
+}
@@ -0,0 +1,187 @@
+// Replays 10 Hz hrs,als,acceleration traces (see ppg/generate_traces.py and doc/ble.md) through Ppg, the way
+// HeartRateTask calls it. For each trace, reports the time to the first heart rate, the error of the heart rates
+// against the "# bpm:" comment of the trace and the host CPU time of Preprocess() and HeartRate(). Traces with an
+// "# engines:" comment are only checked with these engines, the others only report the results.
+//   ppg-replay [--readings readings.csv] [trace.csv...], all the traces of TRACES_DIR by default
+// --readings writes every heart rate as trace,seconds,bpm, to compare two versions of the algorithm.
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "Check.h"
+#include "components/heartrate/Ppg.h"
+
+using namespace Pinetime::Controllers;
+using namespace Pinetime::Host;
+
+namespace {
+  // The first heart rate must come within this time, half of what HeartRateTask waits for it in the background
+  // (backgroundMeasurementTimeLimit), and the heart rates must be this close to the reference on average
+  constexpr float maxTimeToFirstReading = 15.0f;
+  constexpr float maxAverageError = 5.0f;
+  // The CPU times are those of the fastest of these replays, to leave out the noise of the host
+  constexpr int timingRepetitions = 10;
+
+  struct Sample {
+    uint16_t hrs;
+    uint16_t als;
+    uint16_t acceleration;
+  };
+
+  struct Trace {
+    std::string name;
+    int bpm = 0;
+    bool checked = true;
+    std::vector<Sample> samples;
+  };
+
+  struct Result {
+    // Seconds, negative if there was none
+    float timeToFirstReading = -1.0f;
+    uint32_t readings = 0;
+    float averageError = 0.0f;
+    float worstError = 0.0f;
+    double averageNs = 0.0;
+    double worstNs = 0.0;
+  };
+
+  bool Load(const std::filesystem::path& path, Trace& trace) {
+    std::ifstream input {path};
+    if (!input) {
+      return false;
+    }
+    trace.name = path.stem().string();
+    std::string line;
+    while (std::getline(input, line)) {
+      if (line.empty()) {
+        continue;
+      }
+      if (line[0] == '#') {
+        if (line.rfind("# bpm:", 0) == 0) {
+          trace.bpm = std::atoi(line.c_str() + 6);
+        } else if (line.rfind("# engines:", 0) == 0) {
+          trace.checked = (line + " ").find(" " PPG_ENGINE_NAME " ") != std::string::npos;
+        }
+        continue;
+      }
+      unsigned hrs = 0;
+      unsigned als = 0;
+      // Traces without acceleration were recorded without moving
+      unsigned acceleration = 1024;
+      if (std::sscanf(line.c_str(), "%u,%u,%u", &hrs, &als, &acceleration) < 2) {
+        return false;
+      }
+      trace.samples.push_back({static_cast<uint16_t>(hrs), static_cast<uint16_t>(als), static_cast<uint16_t>(acceleration)});
+    }
+    return trace.bpm > 0 && !trace.samples.empty();
+  }
+
+  // Same sequence of calls as HeartRateTask::HandleSensorData()
+  Result Replay(const Trace& trace, FILE* readings = nullptr) {
+    Result result;
+    Ppg ppg;
+    ppg.Reset(true);
+    double totalNs = 0.0;
+    double totalError = 0.0;
+    for (size_t idx = 0; idx < trace.samples.size(); idx++) {
+      const Sample& sample = trace.samples[idx];
+      const auto start = std::chrono::steady_clock::now();
+      const int8_t ambient = ppg.Preprocess(sample.hrs, sample.als, sample.acceleration);
+      int bpm = ppg.HeartRate();
+      const double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+      totalNs += ns;
+      result.worstNs = std::max(result.worstNs, ns);
+
+      if (ambient > 0) {
+        ppg.Reset(true);
+        bpm = 0;
+      }
+      if (bpm == -1) {
+        ppg.Reset(false);
+      }
+      if (bpm > 0) {
+        const float time = static_cast<float>(idx + 1) * Ppg::deltaTms / 1000.0f;
+        if (result.timeToFirstReading < 0.0f) {
+          result.timeToFirstReading = time;
+        }
+        if (readings != nullptr) {
+          std::fprintf(readings, "%s,%.1f,%d\n", trace.name.c_str(), time, bpm);
+        }
+        const float error = std::abs(static_cast<float>(bpm - trace.bpm));
+        totalError += error;
+        result.worstError = std::max(result.worstError, error);
+        result.readings++;
+      }
+    }
+    result.averageNs = totalNs / static_cast<double>(trace.samples.size());
+    if (result.readings > 0) {
+      result.averageError = static_cast<float>(totalError / result.readings);
+    }
+    return result;
+  }
+}
+
+int main(int argc, char** argv) {
+  std::vector<std::filesystem::path> paths;
+  FILE* readings = nullptr;
+  for (int idx = 1; idx < argc; idx++) {
+    if (std::string {argv[idx]} == "--readings" && idx + 1 < argc) {
+      readings = std::fopen(argv[++idx], "w");
+      if (readings == nullptr) {
+        std::perror(argv[idx]);
+        return 1;
+      }
+      continue;
+    }
+    paths.emplace_back(argv[idx]);
+  }
+  if (paths.empty()) {
+    for (const auto& entry : std::filesystem::directory_iterator {TRACES_DIR}) {
+      if (entry.path().extension() == ".csv") {
+        paths.push_back(entry.path());
+      }
+    }
+    std::sort(paths.begin(), paths.end());
+  }
+
+  std::printf("PPG engine %s\n", PPG_ENGINE_NAME);
+  // Heart rates are computed every 5 samples: a 60s trace has at most 108 readings. The CPU time is per sample.
+  std::printf("%-24s %4s %8s %8s %9s %9s %9s %9s\n", "trace", "bpm", "first s", "readings", "avg err", "worst err", "avg us", "worst us");
+  for (const auto& path : paths) {
+    Trace trace;
+    if (!Load(path, trace)) {
+      std::fprintf(stderr, "%s: invalid trace\n", path.c_str());
+      Failures()++;
+      continue;
+    }
+    Result result = Replay(trace, readings);
+    for (int repetition = 1; repetition < timingRepetitions; repetition++) {
+      const Result again = Replay(trace);
+      result.averageNs = std::min(result.averageNs, again.averageNs);
+      result.worstNs = std::min(result.worstNs, again.worstNs);
+    }
+    std::printf("%-24s %4d %8.1f %8u %9.1f %9.0f %9.2f %9.2f%s\n",
+                trace.name.c_str(),
+                trace.bpm,
+                result.timeToFirstReading,
+                result.readings,
+                result.averageError,
+                result.worstError,
+                result.averageNs / 1000,
+                result.worstNs / 1000,
+                trace.checked ? "" : "  (not checked)");
+    if (trace.checked) {
+      CHECK(result.timeToFirstReading >= 0.0f && result.timeToFirstReading <= maxTimeToFirstReading);
+      CHECK(result.readings > 0 && result.averageError <= maxAverageError);
+    }
+  }
+  if (readings != nullptr) {
+    std::fclose(readings);
+  }
+  return Failures() != 0;
+}
@@ -0,0 +1,86 @@
+#!/usr/bin/env python3
+
+"""Generates the synthetic PPG traces replayed by ppg-replay.
+
+Each trace is a 10 Hz CSV file, one sample per line: hrs,als,acceleration. hrs and als are the raw values of
+the heart rate sensor and acceleration is the magnitude of the acceleration (1g = 1024), as streamed by the
+heart rate sensor trace characteristic (see doc/ble.md). Lines starting with '#' are comments, the
+"# bpm:" comment gives the heart rate of the trace, and the "# engines:" comment the PPG engines it is checked
+with, when not all of them.
+
+The heart signal is a fundamental and its second harmonic, with a slowly varying rate, a baseline that
+drifts and breathes, and noise. Moving the arm adds an artifact at the cadence of the movement to the PPG
+signal and shows in the acceleration.
+"""
+
+import argparse
+import math
+import os.path
+import random
+
+SAMPLE_RATE = 10
+DURATION = 60
+
+# name: heart rate (bpm), cadence of the arm movements (per minute, 0 at rest), amplitude of the heart signal,
+# amplitude of the motion artifact in the PPG signal, amplitude of the acceleration, baseline and drift per second,
+# and optionally the engines that are expected to measure it
+TRACES = {
+    "rest_55bpm": dict(bpm=55, cadence=0, amplitude=30, artifact=0, swing=0, baseline=6000, drift=-30),
+    "rest_60bpm": dict(bpm=60, cadence=0, amplitude=30, artifact=0, swing=0, baseline=5000, drift=40),
+    "rest_75bpm_drift": dict(bpm=75, cadence=0, amplitude=30, artifact=0, swing=0, baseline=3000, drift=150),
+    "rest_110bpm_weak": dict(bpm=110, cadence=0, amplitude=8, artifact=0, swing=0, baseline=12000, drift=20),
+    # Weakest and strongest signals that are measured: the fixed point engine scales the samples to the range of
+    # its Q15 values. dcThreshold is absolute, stronger signals are rejected by all the engines.
+    "rest_90bpm_amplitude_2": dict(bpm=90, cadence=0, amplitude=2, artifact=0, swing=0, baseline=4000, drift=5),
+    "rest_90bpm_amplitude_50": dict(bpm=90, cadence=0, amplitude=50, artifact=0, swing=0, baseline=32000, drift=0),
+    "rest_180bpm": dict(bpm=180, cadence=0, amplitude=40, artifact=0, swing=0, baseline=8000, drift=40),
+    # Above ~180 bpm the DC bin of the filtered window of the FFT engine exceeds dcThreshold: its filters start from
+    # the first sample of the window, far from the mean of the signal at these rates (rest_180bpm: 40 readings of 108)
+    "rest_225bpm": dict(bpm=225, cadence=0, amplitude=40, artifact=0, swing=0, baseline=8000, drift=40,
+                        engines="SLIDING_DFT FIXED_POINT"),
+    "walking_80bpm_150spm": dict(bpm=80, cadence=150, amplitude=30, artifact=30, swing=300, baseline=5000, drift=40),
+    "walking_70bpm_110spm": dict(bpm=70, cadence=110, amplitude=30, artifact=30, swing=300, baseline=5000, drift=40),
+    "walking_140bpm_90spm": dict(bpm=140, cadence=90, amplitude=30, artifact=30, swing=300, baseline=5000, drift=40),
+    "running_60bpm_170spm": dict(bpm=60, cadence=170, amplitude=30, artifact=30, swing=400, baseline=5000, drift=40),
+    # Heart rate at the cadence and at twice the cadence, with light movements: the heart rate peak is much stronger
+    # than the artifact and is kept by the motion suppression
+    "running_150bpm_150spm": dict(bpm=150, cadence=150, amplitude=30, artifact=10, swing=100, baseline=5000, drift=40),
+    "walking_160bpm_80spm": dict(bpm=160, cadence=80, amplitude=30, artifact=10, swing=100, baseline=5000, drift=40),
+}
+
+
+def generate(name, bpm, cadence, amplitude, artifact, swing, baseline, drift, engines=None):
+    rng = random.Random(name)
+    heart_phase = 0.0
+    motion_phase = rng.uniform(0, 2 * math.pi)
+    lines = ["# {}".format(name), "# bpm: {}".format(bpm)]
+    if engines:
+        lines.append("# engines: {}".format(engines))
+    lines.append("# hrs,als,acceleration")
+    for index in range(DURATION * SAMPLE_RATE):
+        t = index / SAMPLE_RATE
+        # Heart rate variability: +-2 bpm over 20 s
+        rate = (bpm + 2 * math.sin(2 * math.pi * t / 20)) / 60
+        heart_phase += 2 * math.pi * rate / SAMPLE_RATE
+        motion_phase += 2 * math.pi * cadence / 60 / SAMPLE_RATE
+        heart = amplitude * (math.sin(heart_phase) + math.sin(2 * heart_phase + 1) / 3)
+        motion = artifact * (math.sin(motion_phase) + math.sin(2 * motion_phase + 0.5) / 4)
+        breathing = amplitude * math.sin(2 * math.pi * t * 15 / 60)
+        hrs = baseline + drift * t + breathing + heart + motion + rng.gauss(0, amplitude / 10)
+        als = 10 + rng.randint(0, 2)
+        acceleration = 1024 + swing * math.sin(motion_phase + 0.3) + rng.gauss(0, 5)
+        lines.append("{},{},{}".format(int(round(hrs)), als, int(round(acceleration))))
+    return "\n".join(lines) + "\n"
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--output", default=os.path.dirname(os.path.abspath(__file__)), help="Output directory")
+    args = parser.parse_args()
+    for name, parameters in TRACES.items():
+        with open(os.path.join(args.output, name + ".csv"), "w") as output:
+            output.write(generate(name, **parameters))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,249 @@
+// F: LVGL drive on littlefs and the NOR flash model: byte counts at the end of files, tell and size, directory
+// listings, files that are cached in RAM, kept open or opened for each user, and invalidation on writes.
+// Also compares small reads through the read ahead buffer with the same reads done directly on littlefs.
+#include <cstring>
+#include <string>
+#include <vector>
+#include "Check.h"
+#include "FlashHarness.h"
+#include "components/fs/FS.h"
+#include "displayapp/FileCache.h"
+
+using namespace Pinetime::Components;
+using namespace Pinetime::Controllers;
+using namespace Pinetime::Host;
+
+namespace {
+  FlashHarness harness;
+
+  // Stored in RAM by the cache
+  constexpr uint32_t smallFileSize = 300;
+  // Kept open by the cache
+  constexpr uint32_t largeFileSize = 8 * 1024;
+
+  uint8_t Pattern(uint32_t position) {
+    return static_cast<uint8_t>(position * 31 + (position >> 8));
+  }
+
+  void CreateFile(FS& fs, const char* path, uint32_t size, uint8_t seed = 0) {
+    std::vector<uint8_t> data(size);
+    for (uint32_t i = 0; i < size; i++) {
+      data[i] = Pattern(i) + seed;
+    }
+    lfs_file_t file;
+    CHECK_EQUAL(LFS_ERR_OK, fs.FileOpen(&file, path, LFS_O_WRONLY | LFS_O_CREAT | LFS_O_TRUNC));
+    CHECK_EQUAL(static_cast<int>(size), fs.FileWrite(&file, data.data(), size));
+    fs.FileClose(&file);
+  }
+
+  // Reads the whole file with reads of chunk bytes, checks the data and the byte counts
+  bool ReadAll(const char* path, uint32_t size, uint32_t chunk, uint8_t seed = 0) {
+    lv_fs_file_t file;
+    if (lv_fs_open(&file, path, LV_FS_MODE_RD) != LV_FS_RES_OK) {
+      return false;
+    }
+    std::vector<uint8_t> data(chunk);
+    bool valid = true;
+    for (uint32_t position = 0; valid && position < size; position += chunk) {
+      uint32_t read = 0;
+      valid = lv_fs_read(&file, data.data(), chunk, &read) == LV_FS_RES_OK && read == std::min(chunk, size - position);
+      for (uint32_t i = 0; valid && i < read; i++) {
+        valid = data[i] == static_cast<uint8_t>(Pattern(position + i) + seed);
+      }
+    }
+    lv_fs_close(&file);
+    return valid;
+  }
+
+  void TestEndOfFile(const char* path, uint32_t size) {
+    lv_fs_file_t file;
+    CHECK_EQUAL(LV_FS_RES_OK, lv_fs_open(&file, path, LV_FS_MODE_RD));
+    uint32_t value = 0;
+    CHECK_EQUAL(LV_FS_RES_OK, lv_fs_size(&file, &value));
+    CHECK_EQUAL(size, value);
+
+    // Reads that cross the end of the file only return the bytes of the file
+    uint8_t data[100];
+    uint32_t read = 0;
+    CHECK_EQUAL(LV_FS_RES_OK, lv_fs_seek(&file, size - 10));
+    CHECK_EQUAL(LV_FS_RES_OK, lv_fs_read(&file, data, 4, &read));
+    CHECK_EQUAL(4u, read);
+    CHECK_EQUAL(Pattern(size - 10), data[0]);
+    CHECK_EQUAL(LV_FS_RES_OK, lv_fs_read(&file, data, sizeof(data), &read));
+    CHECK_EQUAL(6u, read);
+    CHECK_EQUAL(Pattern(size - 1), data[5]);
+    CHECK_EQUAL(LV_FS_RES_OK, lv_fs_tell(&file, &value));
+    CHECK_EQUAL(size, value);
+    CHECK_EQUAL(LV_FS_RES_OK, lv_fs_read(&file, data, sizeof(data), &read));
+    CHECK_EQUAL(0u, read);
+
+    // Past the end
+    CHECK_EQUAL(LV_FS_RES_OK, lv_fs_seek(&file, size + 100));
+    CHECK_EQUAL(LV_FS_RES_OK, lv_fs_read(&file, data, 1, &read));
+    CHECK_EQUAL(0u, read);
+    lv_fs_close(&file);
+  }
+
+  void TestSeek(const char* path) {
+    lv_fs_file_t file;
+    CHECK_EQUAL(LV_FS_RES_OK, lv_fs_open(&file, path, LV_FS_MODE_RD));
+    // Backwards and forwards, inside and outside of the read ahead buffer
+    for (uint32_t position : {5000u, 5004u, 4990u, 100u, 7000u, 0u, 5040u}) {
+      uint8_t data[8];
+      uint32_t read = 0;
+      uint32_t tell = 0;
+      CHECK_EQUAL(LV_FS_RES_OK, lv_fs_seek(&file, position));
+      CHECK_EQUAL(LV_FS_RES_OK, lv_fs_tell(&file, &tell));
+      CHECK_EQUAL(position, tell);
+      CHECK_EQUAL(LV_FS_RES_OK, lv_fs_read(&file, data, sizeof(data), &read));
+      CHECK_EQUAL(8u, read);
+      for (uint32_t i = 0; i < sizeof(data); i++) {
+        CHECK_EQUAL(Pattern(position + i), data[i]);
+      }
+    }
+    lv_fs_close(&file);
+  }
+
+  void TestSharedFile(const char* path, uint32_t size) {
+    // The second user of a file gets a file of its own, the positions are independent
+    lv_fs_file_t first;
+    lv_fs_file_t second;
+    CHECK_EQUAL(LV_FS_RES_OK, lv_fs_open(&first, path, LV_FS_MODE_RD));
+    CHECK_EQUAL(LV_FS_RES_OK, lv_fs_open(&second, path, LV_FS_MODE_RD));
+    uint8_t data[16];
+    uint32_t read = 0;
+    lv_fs_seek(&first, size / 2);
+    CHECK_EQUAL(LV_FS_RES_OK, lv_fs_read(&second, data, sizeof(data), &read));
+    CHECK_EQUAL(16u, read);
+    CHECK_EQUAL(Pattern(0), data[0]);
+    CHECK_EQUAL(LV_FS_RES_OK, lv_fs_read(&first, data, sizeof(data), &read));
+    CHECK_EQUAL(16u, read);
+    CHECK_EQUAL(Pattern(size / 2), data[0]);
+    lv_fs_close(&second);
+    lv_fs_close(&first);
+
+    // A file reopened from the cache starts at the beginning
+    CHECK(ReadAll(path, size, 16));
+  }
+
+  void TestMissingFile() {
+    lv_fs_file_t file;
+    for (int i = 0; i < 2; i++) {
+      CHECK_EQUAL(LV_FS_RES_NOT_EX, lv_fs_open(&file, "F:/images/missing.bin", LV_FS_MODE_RD));
+    }
+  }
+
+  void TestInvalidation(FS& fs) {
+    // Cached data and missing files are forgotten once the file system is written
+    CHECK(ReadAll("F:/small.bin", smallFileSize, 64));
+    CHECK(!ReadAll("F:/new.bin", 10, 10));
+    CreateFile(fs, "/small.bin", smallFileSize, 1);
+    CreateFile(fs, "/new.bin", 10);
+    CHECK(ReadAll("F:/small.bin", smallFileSize, 64, 1));
+    CHECK(ReadAll("F:/new.bin", 10, 10));
+
+    // A file in use while it is written keeps working until it's closed
+    lv_fs_file_t file;
+    CHECK_EQUAL(LV_FS_RES_OK, lv_fs_open(&file, "F:/large.bin", LV_FS_MODE_RD));
+    CreateFile(fs, "/other.bin", 10);
+    uint8_t data[16];
+    uint32_t read = 0;
+    CHECK_EQUAL(LV_FS_RES_OK, lv_fs_read(&file, data, sizeof(data), &read));
+    CHECK_EQUAL(16u, read);
+    CHECK_EQUAL(Pattern(15), data[15]);
+    lv_fs_close(&file);
+    CHECK(ReadAll("F:/large.bin", largeFileSize, 256));
+  }
+
+  void TestDirectory() {
+    lv_fs_dir_t dir;
+    CHECK_EQUAL(LV_FS_RES_OK, lv_fs_dir_open(&dir, "F:/images"));
+    std::vector<std::string> names;
+    char name[52];
+    while (lv_fs_dir_read(&dir, name) == LV_FS_RES_OK && name[0] != '\0') {
+      names.emplace_back(name);
+    }
+    lv_fs_dir_close(&dir);
+    // littlefs lists the entries in alphabetical order
+    CHECK_EQUAL(3u, names.size());
+    CHECK(names.size() == 3 && names[0] == "/icons" && names[1] == "pine_small.bin" && names[2] == "watch_face.bin");
+    CHECK_EQUAL(LV_FS_RES_NOT_EX, lv_fs_dir_open(&dir, "F:/missing"));
+  }
+
+  // Small reads of a file that is kept open, like lv_font_load(): through the read ahead buffer, and directly on littlefs
+  void BenchmarkSmallReads(FS& fs) {
+    constexpr uint32_t readSize = 4;
+    const uint32_t flashReads = harness.flash.statistics.reads;
+    Time start = Now();
+    CHECK(ReadAll("F:/large.bin", largeFileSize, readSize));
+    const Time cached = Now() - start;
+    const uint32_t cachedFlashReads = harness.flash.statistics.reads - flashReads;
+
+    start = Now();
+    lfs_file_t file;
+    CHECK_EQUAL(LFS_ERR_OK, fs.FileOpen(&file, "/large.bin", LFS_O_RDONLY));
+    uint8_t data[readSize];
+    for (uint32_t position = 0; position < largeFileSize; position += readSize) {
+      CHECK_EQUAL(static_cast<int>(readSize), fs.FileRead(&file, data, readSize));
+    }
+    fs.FileClose(&file);
+    const Time direct = Now() - start;
+
+    std::printf("%u reads of %u bytes: %llu us with the read ahead buffer (%u flash reads), %llu us directly\n",
+                largeFileSize / readSize,
+                readSize,
+                static_cast<unsigned long long>(cached / 1000),
+                cachedFlashReads,
+                static_cast<unsigned long long>(direct / 1000));
+  }
+}
+
+int main() {
+  Spawn("displayapp", 0, []() {
+    harness.Init();
+    FS fs {harness.spiNorFlash};
+    fs.Init();
+    fs.DirCreate("/images");
+    fs.DirCreate("/images/icons");
+    CreateFile(fs, "/small.bin", smallFileSize);
+    CreateFile(fs, "/large.bin", largeFileSize);
+    CreateFile(fs, "/images/pine_small.bin", smallFileSize);
+    CreateFile(fs, "/images/watch_face.bin", largeFileSize);
+    // Too long to be cached
+    CreateFile(fs, "/images/a_file_name_longer_than_the_paths_of_the_cache.bin", largeFileSize);
+
+    FileCache fileCache {fs};
+    fileCache.Register();
+
+    for (uint32_t chunk : {1u, 3u, 64u, 100u, 1000u}) {
+      CHECK(ReadAll("F:/small.bin", smallFileSize, chunk));
+      CHECK(ReadAll("F:/large.bin", largeFileSize, chunk));
+      CHECK(ReadAll("F:/images/a_file_name_longer_than_the_paths_of_the_cache.bin", largeFileSize, chunk));
+    }
+    TestEndOfFile("F:/small.bin", smallFileSize);
+    TestEndOfFile("F:/large.bin", largeFileSize);
+    TestEndOfFile("F:/images/a_file_name_longer_than_the_paths_of_the_cache.bin", largeFileSize);
+    TestSeek("F:/large.bin");
+    TestSeek("F:/images/a_file_name_longer_than_the_paths_of_the_cache.bin");
+    TestSharedFile("F:/small.bin", smallFileSize);
+    TestSharedFile("F:/large.bin", largeFileSize);
+    TestMissingFile();
+    TestDirectory();
+
+    // More files than entries: evictions
+    for (int i = 0; i < 3; i++) {
+      CHECK(ReadAll("F:/small.bin", smallFileSize, 64));
+      CHECK(ReadAll("F:/large.bin", largeFileSize, 64));
+      CHECK(ReadAll("F:/images/pine_small.bin", smallFileSize, 64));
+      CHECK(ReadAll("F:/images/watch_face.bin", largeFileSize, 64));
+      TestMissingFile();
+    }
+
+    TestInvalidation(fs);
+    BenchmarkSmallReads(fs);
+  });
+  Run();
+
+  CHECK_EQUAL(0u, harness.flash.statistics.busyViolations);
+  return Failures() != 0;
+}
@@ -0,0 +1,338 @@
+// Drawing the external resource images from flash: compressed (ImageDecoder) against raw (LVGL's built-in decoder)
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <png.h>
+#include <string>
+#include <vector>
+#include "Check.h"
+#include "FlashHarness.h"
+#include "displayapp/ImageDecoder.h"
+
+using namespace Pinetime::Host;
+
+namespace {
+  struct Image {
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t channels = 0;
+    std::vector<uint8_t> pixels;
+  };
+
+  // 8 bits per channel, like Pillow
+  Image LoadPng(const std::string& path) {
+    png_image png {};
+    png.version = PNG_IMAGE_VERSION;
+    if (png_image_begin_read_from_file(&png, path.c_str()) == 0) {
+      return {};
+    }
+    png.format = PNG_FORMAT_RGBA;
+    Image image;
+    image.width = png.width;
+    image.height = png.height;
+    image.channels = PNG_IMAGE_PIXEL_CHANNELS(png.format);
+    image.pixels.resize(PNG_IMAGE_SIZE(png));
+    if (png_image_finish_read(&png, nullptr, image.pixels.data(), 0, nullptr) == 0) {
+      png_image_free(&png);
+      return {};
+    }
+    return image;
+  }
+
+  uint8_t ClassifyPixel(uint8_t value, int bits) {
+    const int step = 1 << (8 - bits);
+    return static_cast<uint8_t>(std::min(255, ((value + step / 2) / step) * step));
+  }
+
+  // Image data as written by lv_img_conv.py, without the LVGL header
+  std::vector<uint8_t> Convert(const Image& image, lv_img_cf_t cf) {
+    std::vector<uint8_t> data;
+    if (cf == LV_IMG_CF_TRUE_COLOR_ALPHA) {
+      // ARGB8565_RBSWAP
+      for (size_t i = 0; i < image.width * image.height; i++) {
+        const uint8_t* pixel = image.pixels.data() + (i * image.channels);
+        const uint8_t r = std::min<uint8_t>(ClassifyPixel(pixel[0], 5), 0xF8);
+        const uint8_t g = std::min<uint8_t>(ClassifyPixel(pixel[1], 6), 0xFC);
+        const uint8_t b = std::min<uint8_t>(ClassifyPixel(pixel[2], 5), 0xF8);
+        const uint16_t c16 = (r << 8) | (g << 3) | (b >> 3);
+        data.push_back(c16 >> 8);
+        data.push_back(c16 & 0xFF);
+        data.push_back(pixel[3]);
+      }
+      return data;
+    }
+    // CF_INDEXED_1_BIT: black and white palette, then the lowest bit of the grey level of every pixel
+    const uint32_t lineSize = (image.width + 7) / 8;
+    data.resize(8 + (lineSize * image.height), 0);
+    std::fill(data.begin() + 4, data.begin() + 8, 255);
+    for (uint32_t y = 0; y < image.height; y++) {
+      for (uint32_t x = 0; x < image.width; x++) {
+        const uint8_t grey = image.pixels[((y * image.width) + x) * image.channels];
+        data[8 + (y * lineSize) + (x >> 3)] |= (grey & 0x01) << (7 - (x & 0x07));
+      }
+    }
+    return data;
+  }
+
+  // rle_compress() of lv_img_conv.py
+  void CompressLine(const uint8_t* line, size_t size, size_t unit, std::vector<uint8_t>& out) {
+    std::vector<const uint8_t*> literals;
+    auto flushLiterals = [&]() {
+      for (size_t start = 0; start < literals.size(); start += 128) {
+        const size_t count = std::min<size_t>(128, literals.size() - start);
+        out.push_back(count - 1);
+        for (size_t i = 0; i < count; i++) {
+          out.insert(out.end(), literals[start + i], literals[start + i] + unit);
+        }
+      }
+      literals.clear();
+    };
+    const size_t nbPixels = size / unit;
+    size_t i = 0;
+    while (i < nbPixels) {
+      size_t run = 1;
+      while (i + run < nbPixels && run < 129 && std::memcmp(line + ((i + run) * unit), line + (i * unit), unit) == 0) {
+        run++;
+      }
+      if (run >= 2) {
+        flushLiterals();
+        out.push_back(126 + run);
+        out.insert(out.end(), line + (i * unit), line + ((i + 1) * unit));
+        i += run;
+      } else {
+        literals.push_back(line + (i * unit));
+        i++;
+      }
+    }
+    flushLiterals();
+  }
+
+  // rle_compress_image() of lv_img_conv.py
+  std::vector<uint8_t> Compress(lv_img_cf_t cf, uint32_t width, uint32_t height, const std::vector<uint8_t>& data) {
+    constexpr uint8_t linesPerIndex = 16;
+    const bool indexed = (cf == LV_IMG_CF_INDEXED_1BIT);
+    const size_t unit = indexed ? 1 : (cf == LV_IMG_CF_TRUE_COLOR_ALPHA) ? 3 : 2;
+    const size_t lineSize = indexed ? (width + 7) / 8 : width * unit;
+    const size_t paletteSize = indexed ? 8 : 0;
+    std::vector<uint8_t> index;
+    std::vector<uint8_t> lines;
+    for (uint32_t y = 0; y < height; y++) {
+      if (y % linesPerIndex == 0) {
+        const uint32_t offset = lines.size();
+        index.insert(index.end(), reinterpret_cast<const uint8_t*>(&offset), reinterpret_cast<const uint8_t*>(&offset) + 4);
+      }
+      CompressLine(data.data() + paletteSize + (y * lineSize), lineSize, unit, lines);
+    }
+    std::vector<uint8_t> out(4 + paletteSize + index.size() + lines.size());
+    out[0] = cf;
+    out[1] = linesPerIndex;
+    auto position = std::copy(data.begin(), data.begin() + paletteSize, out.begin() + 4);
+    position = std::copy(index.begin(), index.end(), position);
+    std::copy(lines.begin(), lines.end(), position);
+    return out;
+  }
+
+  std::vector<uint8_t> File(lv_img_cf_t cf, uint32_t width, uint32_t height, const std::vector<uint8_t>& data) {
+    const uint32_t header = cf | (width << 10) | (height << 21);
+    std::vector<uint8_t> file(sizeof(header) + data.size());
+    std::memcpy(file.data(), &header, sizeof(header));
+    std::copy(data.begin(), data.end(), file.begin() + sizeof(header));
+    return file;
+  }
+
+  /* Two drives with the same files: F: reads them from the simulated NOR flash through SpiNorFlash (contiguous
+   * files, without the littlefs overhead), M: from RAM to time the CPU work alone */
+  FlashHarness harness;
+
+  struct StoredFile {
+    std::string name;
+    uint32_t address;
+    std::vector<uint8_t> data;
+  };
+
+  std::vector<StoredFile> files;
+
+  struct OpenFile {
+    const StoredFile* file;
+    uint32_t position;
+  };
+
+  lv_fs_res_t Open(lv_fs_drv_t* /*drv*/, void* file_p, const char* path, lv_fs_mode_t /*mode*/) {
+    for (const auto& file : files) {
+      if (file.name == path) {
+        *static_cast<OpenFile*>(file_p) = {&file, 0};
+        return LV_FS_RES_OK;
+      }
+    }
+    return LV_FS_RES_NOT_EX;
+  }
+
+  lv_fs_res_t Close(lv_fs_drv_t* /*drv*/, void* /*file_p*/) {
+    return LV_FS_RES_OK;
+  }
+
+  lv_fs_res_t Seek(lv_fs_drv_t* /*drv*/, void* file_p, uint32_t pos) {
+    static_cast<OpenFile*>(file_p)->position = pos;
+    return LV_FS_RES_OK;
+  }
+
+  template <bool flash>
+  lv_fs_res_t Read(lv_fs_drv_t* /*drv*/, void* file_p, void* buf, uint32_t btr, uint32_t* br) {
+    auto& open = *static_cast<OpenFile*>(file_p);
+    const uint32_t size = std::min<uint32_t>(btr, open.file->data.size() - std::min<size_t>(open.position, open.file->data.size()));
+    if (flash) {
+      harness.spiNorFlash.Read(open.file->address + open.position, static_cast<uint8_t*>(buf), size);
+    } else {
+      std::memcpy(buf, open.file->data.data() + open.position, size);
+    }
+    open.position += size;
+    *br = size;
+    return LV_FS_RES_OK;
+  }
+
+  template <bool flash>
+  void RegisterDrive(char letter) {
+    lv_fs_drv_t drv;
+    lv_fs_drv_init(&drv);
+    drv.letter = letter;
+    drv.file_size = sizeof(OpenFile);
+    drv.open_cb = Open;
+    drv.close_cb = Close;
+    drv.read_cb = Read<flash>;
+    drv.seek_cb = Seek;
+    lv_fs_drv_register(&drv);
+  }
+
+  void Store(const std::string& name, const std::vector<uint8_t>& data) {
+    const uint32_t address = files.empty() ? 0x100000 : ((files.back().address + files.back().data.size() + 4095) & ~4095U);
+    std::copy(data.begin(), data.end(), harness.flash.memory.begin() + address);
+    files.push_back({name, address, data});
+  }
+
+  // Lines [first, first + count) decoded the way lv_img_draw_core() does for images without data: open, read the
+  // lines of the area to draw, close
+  std::vector<uint8_t> Draw(const std::string& path, lv_coord_t first, lv_coord_t count) {
+    lv_img_decoder_dsc_t dsc;
+    std::vector<uint8_t> pixels;
+    if (lv_img_decoder_open(&dsc, path.c_str(), {}) != LV_RES_OK) {
+      return pixels;
+    }
+    const lv_coord_t width = dsc.header.w;
+    const size_t lineSize = width * LV_IMG_PX_SIZE_ALPHA_BYTE;
+    pixels.resize(lineSize * count);
+    for (lv_coord_t y = 0; y < count; y++) {
+      if (lv_img_decoder_read_line(&dsc, 0, first + y, width, pixels.data() + (y * lineSize)) != LV_RES_OK) {
+        pixels.clear();
+        break;
+      }
+    }
+    lv_img_decoder_close(&dsc);
+    return pixels;
+  }
+
+  struct Result {
+    Time flashTime;
+    uint32_t flashReads;
+    uint64_t flashBytes;
+    double cpuNsPerLine;
+  };
+
+  Result Measure(const std::string& name, lv_coord_t first, lv_coord_t count, std::vector<uint8_t>& pixels) {
+    Result result;
+    const Time start = Now();
+    const auto stats = harness.flash.statistics;
+    pixels = Draw("F:" + name, first, count);
+    result.flashTime = Now() - start;
+    result.flashReads = harness.flash.statistics.reads - stats.reads;
+    result.flashBytes = harness.flash.statistics.bytesRead - stats.bytesRead;
+
+    constexpr int repetitions = 200;
+    const auto cpuStart = std::chrono::steady_clock::now();
+    for (int i = 0; i < repetitions; i++) {
+      CHECK(Draw("M:" + name, first, count) == pixels);
+    }
+    const auto cpuTime = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - cpuStart);
+    result.cpuNsPerLine = cpuTime.count() / (repetitions * count);
+    return result;
+  }
+
+  struct Resource {
+    const char* name;
+    const char* source;
+    lv_img_cf_t cf;
+  };
+
+  // src/resources/images.json
+  constexpr Resource resources[] = {
+    {"pine_small", "pine_logo.png", LV_IMG_CF_TRUE_COLOR_ALPHA},
+    {"navigation0", "navigation0.png", LV_IMG_CF_INDEXED_1BIT},
+    {"navigation1", "navigation1.png", LV_IMG_CF_INDEXED_1BIT},
+  };
+
+  void Report(const char* image, const char* area, const char* format, size_t fileSize, const Result& result) {
+    std::printf("%-12s %-10s %-10s %6zu bytes  %7.2f ms flash, %4u reads, %6llu bytes read  %6.0f ns/line host CPU\n",
+                image,
+                area,
+                format,
+                fileSize,
+                static_cast<double>(result.flashTime) / 1e6,
+                result.flashReads,
+                static_cast<unsigned long long>(result.flashBytes),
+                result.cpuNsPerLine);
+  }
+
+  void Benchmark() {
+    // Navigation icons are 80 lines high, icon 12 is in the middle of navigation0.bin
+    constexpr lv_coord_t iconHeight = 80;
+    constexpr lv_coord_t icon = 12;
+    for (const auto& resource : resources) {
+      const Image image = LoadPng(std::string(RESOURCES_DIR "/images/") + resource.source);
+      CHECK(!image.pixels.empty());
+      if (image.pixels.empty()) {
+        continue;
+      }
+      const auto data = Convert(image, resource.cf);
+      const auto raw = File(resource.cf, image.width, image.height, data);
+      const auto compressed = File(LV_IMG_CF_USER_ENCODED_0, image.width, image.height, Compress(resource.cf, image.width, image.height, data));
+      const std::string rawName = std::string("images/") + resource.name + ".raw.bin";
+      const std::string compressedName = std::string("images/") + resource.name + ".bin";
+      Store(rawName, raw);
+      Store(compressedName, compressed);
+
+      struct Area {
+        const char* name;
+        lv_coord_t first;
+        lv_coord_t count;
+      };
+      std::vector<Area> areas {{"image", 0, static_cast<lv_coord_t>(image.height)}};
+      if (resource.cf == LV_IMG_CF_INDEXED_1BIT) {
+        areas.push_back({"icon", icon * iconHeight, iconHeight});
+      }
+      for (const auto& area : areas) {
+        std::vector<uint8_t> rawPixels;
+        std::vector<uint8_t> compressedPixels;
+        const Result rawResult = Measure(rawName, area.first, area.count, rawPixels);
+        const Result compressedResult = Measure(compressedName, area.first, area.count, compressedPixels);
+        Report(resource.name, area.name, "raw", raw.size(), rawResult);
+        Report(resource.name, area.name, "compressed", compressed.size(), compressedResult);
+        CHECK(!rawPixels.empty());
+        CHECK(compressedPixels == rawPixels);
+        CHECK(compressedResult.flashBytes < rawResult.flashBytes);
+      }
+      CHECK(compressed.size() < raw.size());
+    }
+  }
+}
+
+int main() {
+  RegisterDrive<true>('F');
+  RegisterDrive<false>('M');
+  Pinetime::Components::ImageDecoder::Register();
+
+  Spawn("displayapp", 1, []() {
+    harness.Init();
+    Benchmark();
+  });
+  Run();
+  return Failures() != 0;
+}
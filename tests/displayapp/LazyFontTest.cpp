@@ -0,0 +1,373 @@
+// LazyFont: glyph descriptions, bitmaps and kerning of the external fonts against what LVGL returns for them
+// (generated by fonts/generate_fonts.py), then the glyph cache while the Casio and Infineat faces are drawn in
+// strips of 4 lines, like the draw buffers of LittleVgl.
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "Check.h"
+#include "displayapp/LazyFont.h"
+
+using namespace Pinetime::Components;
+using namespace Pinetime::Host;
+
+namespace {
+  constexpr lv_coord_t screenSize = 240;
+  // Lines of the draw buffers
+  constexpr lv_coord_t stripHeight = 4;
+
+  // F: drive on the files of DRIVE_DIR
+  struct DriveStatistics {
+    uint32_t opens = 0;
+    uint32_t reads = 0;
+    uint64_t bytesRead = 0;
+  };
+
+  DriveStatistics drive;
+
+  lv_fs_res_t Open(lv_fs_drv_t* /*drv*/, void* file_p, const char* path, lv_fs_mode_t /*mode*/) {
+    FILE* file = std::fopen((std::string(DRIVE_DIR) + "/" + path).c_str(), "rb");
+    if (file == nullptr) {
+      return LV_FS_RES_NOT_EX;
+    }
+    *static_cast<FILE**>(file_p) = file;
+    drive.opens++;
+    return LV_FS_RES_OK;
+  }
+
+  lv_fs_res_t Close(lv_fs_drv_t* /*drv*/, void* file_p) {
+    std::fclose(*static_cast<FILE**>(file_p));
+    return LV_FS_RES_OK;
+  }
+
+  lv_fs_res_t Read(lv_fs_drv_t* /*drv*/, void* file_p, void* buf, uint32_t btr, uint32_t* br) {
+    *br = std::fread(buf, 1, btr, *static_cast<FILE**>(file_p));
+    drive.reads++;
+    drive.bytesRead += *br;
+    return LV_FS_RES_OK;
+  }
+
+  lv_fs_res_t Seek(lv_fs_drv_t* /*drv*/, void* file_p, uint32_t pos) {
+    return (std::fseek(*static_cast<FILE**>(file_p), pos, SEEK_SET) == 0) ? LV_FS_RES_OK : LV_FS_RES_FS_ERR;
+  }
+
+  void RegisterDrive() {
+    lv_fs_drv_t driver;
+    lv_fs_drv_init(&driver);
+    driver.letter = 'F';
+    driver.file_size = sizeof(FILE*);
+    driver.open_cb = Open;
+    driver.close_cb = Close;
+    driver.read_cb = Read;
+    driver.seek_cb = Seek;
+    lv_fs_drv_register(&driver);
+  }
+
+  std::string FontPath(const std::string& name) {
+    return "F:/fonts/" + name + ".bin";
+  }
+
+  uint32_t Bit(const uint8_t* data, uint32_t position) {
+    return (data[position / 8] >> (7 - (position % 8))) & 0x01;
+  }
+
+  // Checks every item of <name>.txt, returns the size of the bitmaps
+  uint32_t CheckFont(const std::string& name) {
+    std::ifstream expected(std::string(DRIVE_DIR) + "/fonts/" + name + ".txt");
+    CHECK(expected.is_open());
+    lv_font_t* font = LazyFont::Load(FontPath(name).c_str());
+    CHECK(font != nullptr);
+    if (font == nullptr) {
+      return 0;
+    }
+
+    uint32_t bitmapsSize = 0;
+    uint32_t mismatches = 0;
+    std::string line;
+    while (std::getline(expected, line)) {
+      std::istringstream item(line);
+      std::string type;
+      item >> type;
+      lv_font_glyph_dsc_t dsc;
+      if (type == "font") {
+        int lineHeight;
+        int baseLine;
+        item >> lineHeight >> baseLine;
+        CHECK_EQUAL(lineHeight, font->line_height);
+        CHECK_EQUAL(baseLine, font->base_line);
+      } else if (type == "glyph") {
+        uint32_t letter;
+        int advanceWidth, boxWidth, boxHeight, offsetX, offsetY;
+        std::string bitmap;
+        item >> letter >> advanceWidth >> boxWidth >> boxHeight >> offsetX >> offsetY >> bitmap;
+        const bool found = lv_font_get_glyph_dsc(font, &dsc, letter, 0);
+        const bool same = found && dsc.adv_w == advanceWidth && dsc.box_w == boxWidth && dsc.box_h == boxHeight && dsc.ofs_x == offsetX &&
+                          dsc.ofs_y == offsetY && dsc.bpp == 1;
+        // LVGL doesn't ask for the bitmap of empty glyphs
+        bool sameBitmap = true;
+        if (same && bitmap != "-") {
+          const uint8_t* data = lv_font_get_glyph_bitmap(font, letter);
+          sameBitmap = data != nullptr;
+          for (uint32_t i = 0; sameBitmap && i < static_cast<uint32_t>(boxWidth * boxHeight); i++) {
+            sameBitmap = Bit(data, i) == ((std::stoul(bitmap.substr((i / 8) * 2, 2), nullptr, 16) >> (7 - (i % 8))) & 0x01);
+          }
+          bitmapsSize += bitmap.size() / 2;
+        }
+        if (!same || !sameBitmap) {
+          std::fprintf(stderr, "%s: glyph %u differs\n", name.c_str(), letter);
+          mismatches++;
+        }
+      } else if (type == "missing") {
+        uint32_t letter;
+        item >> letter;
+        CHECK(!lv_font_get_glyph_dsc(font, &dsc, letter, 0));
+      } else if (type == "pair") {
+        uint32_t letter;
+        uint32_t next;
+        int advanceWidth;
+        item >> letter >> next >> advanceWidth;
+        if (!lv_font_get_glyph_dsc(font, &dsc, letter, next) || dsc.adv_w != advanceWidth) {
+          std::fprintf(stderr, "%s: advance width of %u before %u differs\n", name.c_str(), letter, next);
+          mismatches++;
+        }
+      }
+    }
+    CHECK_EQUAL(0u, mismatches);
+    LazyFont::Free(font);
+    return bitmapsSize;
+  }
+
+  struct Area {
+    lv_coord_t x1;
+    lv_coord_t y1;
+    lv_coord_t x2;
+    lv_coord_t y2;
+  };
+
+  bool Intersect(const Area& a, const Area& b) {
+    return a.x1 <= b.x2 && b.x1 <= a.x2 && a.y1 <= b.y2 && b.y1 <= a.y2;
+  }
+
+  enum class Align { InTopLeft, InTopMid, InBottomMid, Center };
+
+  // A label of a single line, aligned like lv_obj_align()
+  struct Label {
+    lv_font_t* const* font;
+    std::string text;
+    Area parent;
+    Align align;
+    lv_coord_t x;
+    lv_coord_t y;
+    Area area;
+  };
+
+  lv_coord_t TextWidth(const lv_font_t* font, const std::string& text) {
+    lv_coord_t width = 0;
+    for (size_t i = 0; i < text.size(); i++) {
+      lv_font_glyph_dsc_t dsc;
+      if (lv_font_get_glyph_dsc(font, &dsc, text[i], (i + 1 < text.size()) ? text[i + 1] : 0)) {
+        width += dsc.adv_w;
+      }
+    }
+    return width;
+  }
+
+  // Returns the area to redraw: the previous and the new area of the label
+  Area SetText(Label& label, const std::string& text) {
+    const Area previous = label.area;
+    label.text = text;
+    const lv_coord_t width = TextWidth(*label.font, text);
+    const lv_coord_t height = (*label.font)->line_height;
+    const Area& parent = label.parent;
+    lv_coord_t x = parent.x1 + label.x;
+    lv_coord_t y = parent.y1 + label.y;
+    switch (label.align) {
+      case Align::InTopLeft:
+        break;
+      case Align::InTopMid:
+        x += (parent.x2 - parent.x1 + 1 - width) / 2;
+        break;
+      case Align::InBottomMid:
+        x += (parent.x2 - parent.x1 + 1 - width) / 2;
+        y += parent.y2 - parent.y1 + 1 - height;
+        break;
+      case Align::Center:
+        x += (parent.x2 - parent.x1 + 1 - width) / 2;
+        y += (parent.y2 - parent.y1 + 1 - height) / 2;
+        break;
+    }
+    label.area = {x, y, static_cast<lv_coord_t>(x + width - 1), static_cast<lv_coord_t>(y + height - 1)};
+    return {std::min(previous.x1, label.area.x1),
+            std::min(previous.y1, label.area.y1),
+            std::max(previous.x2, label.area.x2),
+            std::max(previous.y2, label.area.y2)};
+  }
+
+  // The letters of the label crossing the clip area, like lv_draw_label() and lv_draw_letter()
+  void DrawLabel(const Label& label, const Area& clip) {
+    const lv_font_t* font = *label.font;
+    lv_coord_t x = label.area.x1;
+    for (size_t i = 0; i < label.text.size(); i++) {
+      const uint32_t letter = label.text[i];
+      lv_font_glyph_dsc_t dsc;
+      if (!lv_font_get_glyph_dsc(font, &dsc, letter, (i + 1 < label.text.size()) ? label.text[i + 1] : 0)) {
+        continue;
+      }
+      const lv_coord_t letterX = x + dsc.ofs_x;
+      const lv_coord_t letterY = label.area.y1 + (font->line_height - font->base_line) - dsc.box_h - dsc.ofs_y;
+      x += dsc.adv_w;
+      if (dsc.box_w == 0 || dsc.box_h == 0 || letterX + dsc.box_w < clip.x1 || letterX > clip.x2 || letterY + dsc.box_h < clip.y1 ||
+          letterY > clip.y2) {
+        continue;
+      }
+      CHECK(lv_font_get_glyph_bitmap(font, letter) != nullptr);
+    }
+  }
+
+  // Redraws the area in strips of the draw buffer
+  void Refresh(const std::vector<Label>& labels, const Area& area) {
+    for (lv_coord_t y = std::max<lv_coord_t>(area.y1, 0); y <= std::min<lv_coord_t>(area.y2, screenSize - 1); y += stripHeight) {
+      const Area strip {area.x1, y, area.x2, static_cast<lv_coord_t>(y + stripHeight - 1)};
+      for (const auto& label : labels) {
+        if (Intersect(label.area, strip)) {
+          DrawLabel(label, strip);
+        }
+      }
+    }
+  }
+
+  struct Face {
+    const char* name;
+    std::vector<std::string> fonts;
+    std::vector<lv_font_t*> loaded;
+    std::vector<Label> labels;
+    // Label updated every minute
+    size_t time;
+    std::vector<std::string> times;
+  };
+
+  // Draws the face, then a few minutes. Reports the cache hit rate, the flash reads and the heap.
+  void DrawFace(Face& face, uint32_t bitmapsSize, uint32_t nbGlyphs) {
+    const size_t heapBefore = LvglHeapUsed();
+    const DriveStatistics driveBefore = drive;
+    for (auto& font : face.loaded) {
+      font = nullptr;
+    }
+    for (size_t i = 0; i < face.fonts.size(); i++) {
+      face.loaded[i] = LazyFont::Load(FontPath(face.fonts[i]).c_str());
+      CHECK(face.loaded[i] != nullptr);
+    }
+    const size_t fontsHeap = LvglHeapUsed() - heapBefore;
+    ResetLvglHeapPeak();
+    const LazyFont::CacheStatistics cacheBefore = LazyFont::GetCacheStatistics();
+    const uint64_t loadBytes = drive.bytesRead - driveBefore.bytesRead;
+
+    for (auto& label : face.labels) {
+      SetText(label, label.text);
+    }
+    Refresh(face.labels, {0, 0, screenSize - 1, screenSize - 1});
+    for (const auto& time : face.times) {
+      Refresh(face.labels, SetText(face.labels[face.time], time));
+    }
+
+    const LazyFont::CacheStatistics cache = LazyFont::GetCacheStatistics();
+    const uint32_t hits = cache.hits - cacheBefore.hits;
+    const uint32_t misses = cache.misses - cacheBefore.misses;
+    std::printf("%-8s %2zu fonts: %5zu bytes of heap (lv_font_load() > %5u), %5zu more while drawing; cache %3u%% of %5u bitmaps, "
+                "%6llu bytes read from flash (%llu to load the fonts)\n",
+                face.name,
+                face.fonts.size(),
+                fontsHeap,
+                bitmapsSize + (nbGlyphs * 8),
+                LvglHeapPeak() - heapBefore - fontsHeap,
+                (hits + misses == 0) ? 0 : (hits * 100) / (hits + misses),
+                hits + misses,
+                static_cast<unsigned long long>(drive.bytesRead - driveBefore.bytesRead),
+                static_cast<unsigned long long>(loadBytes));
+    // Each font file is opened once, when it is loaded
+    CHECK_EQUAL(face.fonts.size(), drive.opens - driveBefore.opens);
+    CHECK(hits * 100 >= (hits + misses) * 90);
+
+    for (auto* font : face.loaded) {
+      if (font != nullptr) {
+        LazyFont::Free(font);
+      }
+    }
+    CHECK_EQUAL(heapBefore, LvglHeapUsed());
+  }
+
+  uint32_t GlyphsCount(const std::string& name) {
+    std::ifstream expected(std::string(DRIVE_DIR) + "/fonts/" + name + ".txt");
+    uint32_t count = 0;
+    std::string line;
+    while (std::getline(expected, line)) {
+      // The tab is the space glyph
+      count += line.rfind("glyph ", 0) == 0 && line.rfind("glyph 9 ", 0) != 0;
+    }
+    return count;
+  }
+}
+
+int main() {
+  RegisterDrive();
+
+  const std::vector<std::string> fonts {"teko", "bebas", "lv_font_dots_40", "7segments_40", "7segments_115", "kerning_pairs", "kerning_classes"};
+  std::vector<uint32_t> bitmapsSizes;
+  for (const auto& name : fonts) {
+    bitmapsSizes.push_back(CheckFont(name));
+  }
+  CHECK_EQUAL(0u, LvglHeapUsed());
+
+  auto bitmapsSize = [&](const std::vector<std::string>& names) {
+    uint32_t size = 0;
+    uint32_t nbGlyphs = 0;
+    for (const auto& name : names) {
+      for (size_t i = 0; i < fonts.size(); i++) {
+        if (fonts[i] == name) {
+          size += bitmapsSizes[i];
+          nbGlyphs += GlyphsCount(name);
+        }
+      }
+    }
+    return std::make_pair(size, nbGlyphs);
+  };
+
+  const Area screen {0, 0, screenSize - 1, screenSize - 1};
+
+  // WatchFaceCasioStyleG7710
+  Face casio {"Casio", {"lv_font_dots_40", "7segments_40", "7segments_115"}, std::vector<lv_font_t*>(3), {}, 0, {}};
+  lv_font_t* const* dots40 = &casio.loaded[0];
+  lv_font_t* const* segments40 = &casio.loaded[1];
+  lv_font_t* const* segments115 = &casio.loaded[2];
+  casio.labels = {
+    {segments115, "12:34", screen, Align::Center, 0, 40, {}},
+    {dots40, "MON", screen, Align::InTopLeft, 10, 64, {}},
+    {dots40, "WK42", screen, Align::InTopLeft, 5, 22, {}},
+    {segments40, "123-242", screen, Align::InTopLeft, 100, 30, {}},
+    {segments40, " 21- 8", screen, Align::InTopLeft, 100, 70, {}},
+  };
+  casio.times = {"12:35", "12:36", "12:37", "12:38", "12:39", "12:40", "12:41", "12:42", "12:43", "12:44"};
+  const auto casioSizes = bitmapsSize(casio.fonts);
+  DrawFace(casio, casioSizes.first, casioSizes.second);
+
+  // WatchFaceInfineat
+  Face infineat {"Infineat", {"teko", "bebas"}, std::vector<lv_font_t*>(2), {}, 1, {}};
+  lv_font_t* const* teko = &infineat.loaded[0];
+  lv_font_t* const* bebas = &infineat.loaded[1];
+  const Area timeContainer {27, 17, 27 + 185 - 1, 17 + 185 - 1};
+  const Area dateContainer {180, 110, 180 + 60 - 1, 110 + 30 - 1};
+  infineat.labels = {
+    {bebas, "12", timeContainer, Align::InTopMid, 0, 0, {}},
+    {bebas, "34", timeContainer, Align::InBottomMid, 0, 0, {}},
+    {teko, "Mon 01", dateContainer, Align::InTopMid, 0, 0, {}},
+    {teko, "4242", screen, Align::InBottomMid, 10, 0, {}},
+  };
+  infineat.times = {"35", "36", "37", "38", "39", "40", "41", "42", "43", "44"};
+  const auto infineatSizes = bitmapsSize(infineat.fonts);
+  DrawFace(infineat, infineatSizes.first, infineatSizes.second);
+
+  std::printf("since boot: cache hit rate %u%%\n", LazyFont::CacheHitRate());
+  return Failures() != 0;
+}
@@ -0,0 +1,458 @@
+#!/usr/bin/env python3
+
+"""Generates the external fonts of src/resources/fonts.json in the binary format of lv_font_conv, for lazy-font-test.
+
+lv_font_conv is a node.js tool that the host tests don't depend on. The glyphs of the TrueType and WOFF sources
+are rasterized here at the size of fonts.json, with the advance widths and the kerning ('kern' table) of the
+source, and written like lv_font_conv --format bin --no-compress does. Pixels are set when their center is inside
+the outline, without hinting: the bitmaps are close to, not equal to, those of lv_font_conv.
+
+Next to every <name>.bin, <name>.txt lists what LVGL returns for the font, one item per line:
+  font <line height> <base line>
+  glyph <letter> <adv_w> <box_w> <box_h> <ofs_x> <ofs_y> <bitmap bytes in hexadecimal, or - if empty>
+  missing <letter>
+  pair <letter> <next letter> <adv_w>
+Letters are code points. adv_w is in pixels and includes the kerning with the next letter, as computed by
+lv_font_get_glyph_dsc_fmt_txt().
+"""
+
+import argparse
+import json
+import math
+import os.path
+import struct
+import zlib
+
+# None of the sources kerns its symbols, so lv_font_conv writes no kerning table. These fonts add the kerning of a
+# tight colon to a font of fonts.json, in each of the 2 formats of lv_font_conv (in font units).
+KERNED_FONTS = {
+  "kerning_pairs": ("7segments_40", "pairs"),
+  "kerning_classes": ("7segments_40", "classes"),
+}
+# Kerning of the digits before and after the colon. The first one needs a scale of the kerning values.
+COLON_KERNING = (-300, -50)
+
+# Code point that none of the fonts has
+MISSING_LETTER = 0x263A
+
+# Steps of the line segments drawn for every quadratic curve
+CURVE_STEPS = 8
+
+
+def read_tables(path):
+    with open(path, "rb") as source:
+        data = source.read()
+    tables = {}
+    if data[:4] == b"wOFF":
+        count = struct.unpack(">H", data[12:14])[0]
+        for index in range(count):
+            tag, offset, compressed, original, _ = struct.unpack(">4sIIII", data[44 + 20 * index:64 + 20 * index])
+            table = data[offset:offset + compressed]
+            tables[tag.decode()] = zlib.decompress(table) if compressed < original else table
+    else:
+        count = struct.unpack(">H", data[4:6])[0]
+        for index in range(count):
+            tag, _, offset, length = struct.unpack(">4sIII", data[12 + 16 * index:28 + 16 * index])
+            tables[tag.decode()] = data[offset:offset + length]
+    return tables
+
+
+class TrueTypeFont:
+    def __init__(self, path):
+        self.tables = read_tables(path)
+        head = self.tables["head"]
+        self.units_per_em = struct.unpack(">H", head[18:20])[0]
+        long_offsets = struct.unpack(">h", head[50:52])[0] != 0
+        glyph_count = struct.unpack(">H", self.tables["maxp"][4:6])[0]
+        loca = self.tables["loca"]
+        if long_offsets:
+            self.offsets = struct.unpack(">{}I".format(glyph_count + 1), loca[:4 * (glyph_count + 1)])
+        else:
+            self.offsets = [offset * 2 for offset in struct.unpack(">{}H".format(glyph_count + 1), loca[:2 * (glyph_count + 1)])]
+        hhea = self.tables["hhea"]
+        self.ascender, self.descender = struct.unpack(">hh", hhea[4:8])
+        self.metrics_count = struct.unpack(">H", hhea[34:36])[0]
+        self.cmap = self.read_cmap()
+        self.kerning = self.read_kerning()
+
+    def read_cmap(self):
+        cmap = self.tables["cmap"]
+        count = struct.unpack(">H", cmap[2:4])[0]
+        for index in range(count):
+            _, _, offset = struct.unpack(">HHI", cmap[4 + 8 * index:12 + 8 * index])
+            if struct.unpack(">H", cmap[offset:offset + 2])[0] != 4:
+                continue
+            segments = struct.unpack(">H", cmap[offset + 6:offset + 8])[0] // 2
+            position = offset + 14
+
+            def array(signed=False):
+                nonlocal position
+                values = struct.unpack(">{}{}".format(segments, "h" if signed else "H"), cmap[position:position + 2 * segments])
+                position += 2 * segments
+                return values
+
+            ends = array()
+            position += 2
+            starts = array()
+            deltas = array(signed=True)
+            range_offsets_start = position
+            range_offsets = array()
+            mapping = {}
+            for segment in range(segments):
+                for letter in range(starts[segment], ends[segment] + 1):
+                    if letter == 0xFFFF:
+                        continue
+                    if range_offsets[segment] == 0:
+                        glyph = (letter + deltas[segment]) & 0xFFFF
+                    else:
+                        address = range_offsets_start + 2 * segment + range_offsets[segment] + 2 * (letter - starts[segment])
+                        glyph = struct.unpack(">H", cmap[address:address + 2])[0]
+                        if glyph != 0:
+                            glyph = (glyph + deltas[segment]) & 0xFFFF
+                    mapping[letter] = glyph
+            return mapping
+        raise ValueError("no cmap subtable of format 4")
+
+    def read_kerning(self):
+        kerning = {}
+        kern = self.tables.get("kern")
+        if kern is None or struct.unpack(">H", kern[0:2])[0] != 0:
+            return kerning
+        position = 4
+        for _ in range(struct.unpack(">H", kern[2:4])[0]):
+            _, length, coverage = struct.unpack(">HHH", kern[position:position + 6])
+            # Horizontal pairs
+            if coverage >> 8 == 0 and coverage & 0x01 != 0:
+                count = struct.unpack(">H", kern[position + 6:position + 8])[0]
+                for pair in range(count):
+                    start = position + 14 + 6 * pair
+                    left, right, value = struct.unpack(">HHh", kern[start:start + 6])
+                    kerning[(left, right)] = value
+            position += length
+        return kerning
+
+    def advance(self, glyph):
+        index = min(glyph, self.metrics_count - 1)
+        return struct.unpack(">H", self.tables["hmtx"][4 * index:4 * index + 2])[0]
+
+    def contours(self, glyph, transform=(1, 0, 0, 1, 0, 0)):
+        """Contours of the glyph in font units, lists of (x, y, on curve)"""
+        data = self.tables["glyf"][self.offsets[glyph]:self.offsets[glyph + 1]]
+        if not data:
+            return []
+        count = struct.unpack(">h", data[0:2])[0]
+        if count < 0:
+            return self.composite_contours(data, transform)
+
+        ends = struct.unpack(">{}H".format(count), data[10:10 + 2 * count])
+        position = 10 + 2 * count
+        position += 2 + struct.unpack(">H", data[position:position + 2])[0]
+        points = ends[-1] + 1
+        flags = []
+        while len(flags) < points:
+            flag = data[position]
+            position += 1
+            repeat = 0
+            if flag & 0x08:
+                repeat = data[position]
+                position += 1
+            flags.extend([flag] * (repeat + 1))
+
+        def coordinates(short, same):
+            nonlocal position
+            values = []
+            value = 0
+            for flag in flags:
+                if flag & short:
+                    delta = data[position]
+                    position += 1
+                    value += delta if flag & same else -delta
+                elif not flag & same:
+                    value += struct.unpack(">h", data[position:position + 2])[0]
+                    position += 2
+                values.append(value)
+            return values
+
+        xs = coordinates(0x02, 0x10)
+        ys = coordinates(0x04, 0x20)
+        a, b, c, d, e, f = transform
+        result = []
+        start = 0
+        for end in ends:
+            result.append([(a * xs[i] + c * ys[i] + e, b * xs[i] + d * ys[i] + f, flags[i] & 0x01 != 0) for i in range(start, end + 1)])
+            start = end + 1
+        return result
+
+    def composite_contours(self, data, transform):
+        result = []
+        position = 10
+        more = True
+        while more:
+            flags, glyph = struct.unpack(">HH", data[position:position + 4])
+            position += 4
+            if not flags & 0x0002:
+                raise ValueError("composite glyphs positioned by points are not supported")
+            if flags & 0x0001:
+                dx, dy = struct.unpack(">hh", data[position:position + 4])
+                position += 4
+            else:
+                dx, dy = struct.unpack(">bb", data[position:position + 2])
+                position += 2
+            a, b, c, d = 1, 0, 0, 1
+            if flags & 0x0008:
+                a = d = struct.unpack(">h", data[position:position + 2])[0] / 16384
+                position += 2
+            elif flags & 0x0040:
+                a, d = (value / 16384 for value in struct.unpack(">hh", data[position:position + 4]))
+                position += 4
+            elif flags & 0x0080:
+                a, b, c, d = (value / 16384 for value in struct.unpack(">hhhh", data[position:position + 8]))
+                position += 8
+            pa, pb, pc, pd, pe, pf = transform
+            combined = (pa * a + pc * b, pb * a + pd * b, pa * c + pc * d, pb * c + pd * d, pa * dx + pc * dy + pe, pb * dx + pd * dy + pf)
+            result.extend(self.contours(glyph, combined))
+            more = flags & 0x0020 != 0
+        return result
+
+
+def polygon(contour):
+    """Line segments of a contour: the implied on curve points are added and the curves are flattened"""
+    points = []
+    for index, point in enumerate(contour):
+        previous = contour[index - 1]
+        if not point[2] and not previous[2]:
+            points.append(((point[0] + previous[0]) / 2, (point[1] + previous[1]) / 2, True))
+        points.append(point)
+    start = next(index for index, point in enumerate(points) if point[2])
+    points = points[start:] + points[:start]
+    result = []
+    for index, (x, y, on_curve) in enumerate(points):
+        if on_curve:
+            result.append((x, y))
+            continue
+        x0, y0, _ = points[index - 1]
+        x2, y2, _ = points[(index + 1) % len(points)]
+        for step in range(1, CURVE_STEPS):
+            t = step / CURVE_STEPS
+            result.append(((1 - t) ** 2 * x0 + 2 * (1 - t) * t * x + t ** 2 * x2, (1 - t) ** 2 * y0 + 2 * (1 - t) * t * y + t ** 2 * y2))
+    return result
+
+
+def rasterize(contours, scale):
+    """Returns ofs_x, ofs_y and the rows of pixels, top to bottom, of the smallest box holding the glyph"""
+    edges = []
+    for contour in contours:
+        points = [(x * scale, y * scale) for x, y in polygon(contour)]
+        for (x0, y0), (x1, y1) in zip(points, points[1:] + points[:1]):
+            if y0 != y1:
+                edges.append((x0, y0, x1, y1))
+    if not edges:
+        return 0, 0, []
+    left = math.floor(min(min(edge[0], edge[2]) for edge in edges))
+    right = math.ceil(max(max(edge[0], edge[2]) for edge in edges))
+    bottom = math.floor(min(min(edge[1], edge[3]) for edge in edges))
+    top = math.ceil(max(max(edge[1], edge[3]) for edge in edges))
+
+    rows = []
+    for row in range(top - 1, bottom - 1, -1):
+        center = row + 0.5
+        crossings = []
+        for x0, y0, x1, y1 in edges:
+            if y0 <= center < y1 or y1 <= center < y0:
+                crossings.append((x0 + (center - y0) * (x1 - x0) / (y1 - y0), 1 if y1 > y0 else -1))
+        crossings.sort()
+        line = [0] * (right - left)
+        winding = 0
+        for (x, direction), (next_x, _) in zip(crossings, crossings[1:]):
+            winding += direction
+            if winding != 0:
+                for column in range(max(math.ceil(x - left - 0.5), 0), min(math.ceil(next_x - left - 0.5), len(line))):
+                    line[column] = 1
+        rows.append(line)
+
+    used_rows = [index for index, line in enumerate(rows) if any(line)]
+    if not used_rows:
+        return 0, 0, []
+    used_columns = [column for column in range(right - left) if any(line[column] for line in rows)]
+    first_column, last_column = used_columns[0], used_columns[-1] + 1
+    rows = [line[first_column:last_column] for line in rows[used_rows[0]:used_rows[-1] + 1]]
+    return left + first_column, top - 1 - used_rows[-1], rows
+
+
+class BitWriter:
+    def __init__(self):
+        self.bits = []
+
+    def write(self, value, count):
+        self.bits.extend((value >> (count - 1 - bit)) & 0x01 for bit in range(count))
+
+    def data(self):
+        bits = self.bits + [0] * (-len(self.bits) % 8)
+        return bytes(int("".join(str(bit) for bit in bits[index:index + 8]), 2) for index in range(0, len(bits), 8))
+
+
+def signed_bits(values):
+    return max(1, max((value if value >= 0 else ~value).bit_length() + 1 for value in values))
+
+
+def table(label, data):
+    data += bytes(-len(data) % 4)
+    return struct.pack("<I4s", 8 + len(data), label.encode()) + data
+
+
+def generate(config, resources_dir, kerning_format=None):
+    source = config["sources"][0]
+    if len(config["sources"]) != 1 or config["bpp"] != 1:
+        raise ValueError("{}: only fonts with one source and 1 bpp are supported".format(name))
+    font = TrueTypeFont(os.path.join(resources_dir, source["file"]))
+    scale = config["size"] / font.units_per_em
+    letters = sorted({ord(symbol) for symbol in source["symbols"]})
+
+    # Glyph 0 is reserved, the others follow the order of the code points
+    glyphs = [dict(letter=0, adv_w=0, ofs_x=0, ofs_y=0, rows=[])]
+    for letter in letters:
+        source_glyph = font.cmap[letter]
+        ofs_x, ofs_y, rows = rasterize(font.contours(source_glyph), scale)
+        glyphs.append(dict(letter=letter, source=source_glyph, adv_w=round(font.advance(source_glyph) * scale * 16), ofs_x=ofs_x,
+                           ofs_y=ofs_y, rows=rows))
+    for glyph in glyphs:
+        glyph["box_w"] = len(glyph["rows"][0]) if glyph["rows"] else 0
+        glyph["box_h"] = len(glyph["rows"])
+
+    advance_bits = max(glyph["adv_w"] for glyph in glyphs).bit_length()
+    xy_bits = signed_bits([glyph["ofs_x"] for glyph in glyphs] + [glyph["ofs_y"] for glyph in glyphs])
+    wh_bits = max(1, max(max(glyph["box_w"], glyph["box_h"]) for glyph in glyphs).bit_length())
+
+    # Glyph descriptions and bitmaps, their offsets include the header of the table
+    glyph_data = b""
+    offsets = []
+    for glyph in glyphs:
+        offsets.append(8 + len(glyph_data))
+        writer = BitWriter()
+        writer.write(glyph["adv_w"], advance_bits)
+        writer.write(glyph["ofs_x"] & ((1 << xy_bits) - 1), xy_bits)
+        writer.write(glyph["ofs_y"] & ((1 << xy_bits) - 1), xy_bits)
+        writer.write(glyph["box_w"], wh_bits)
+        writer.write(glyph["box_h"], wh_bits)
+        for row in glyph["rows"]:
+            for pixel in row:
+                writer.write(pixel, 1)
+        glyph_data += writer.data()
+    glyf = table("glyf", glyph_data)
+    long_offsets = len(glyf) >= 0x10000
+    loca = table("loca", struct.pack("<I", len(glyphs)) + struct.pack("<{}{}".format(len(offsets), "I" if long_offsets else "H"), *offsets))
+
+    # Runs of at least 3 consecutive code points are "format 0 tiny" subtables, the letters between them "sparse tiny"
+    subtables = []
+    index = 0
+    while index < len(letters):
+        end = index + 1
+        while end < len(letters) and letters[end] == letters[end - 1] + 1:
+            end += 1
+        if end - index >= 3:
+            subtables.append((2, letters[index:end], index + 1))
+            index = end
+            continue
+        end = index + 1
+        while end < len(letters) and not (end + 2 < len(letters) and letters[end + 2] == letters[end] + 2):
+            end += 1
+        subtables.append((3, letters[index:end], index + 1))
+        index = end
+    headers = b""
+    cmap_data = b""
+    data_start = 12 + 16 * len(subtables)
+    for format_type, run, glyph_start in subtables:
+        entries = b"" if format_type == 2 else struct.pack("<{}H".format(len(run)), *(letter - run[0] for letter in run))
+        headers += struct.pack("<IIHHHBB", data_start + len(cmap_data), run[0], run[-1] - run[0] + 1, glyph_start,
+                               0 if format_type == 2 else len(run), format_type, 0)
+        cmap_data += entries + bytes(-len(entries) % 4)
+    cmap = table("cmap", struct.pack("<I", len(subtables)) + headers + cmap_data)
+
+    # Kerning in 1/16 px, scaled to fit in int8 values
+    ids = {glyph["source"]: index for index, glyph in enumerate(glyphs) if index > 0}
+    source_kerning = dict(font.kerning)
+    if kerning_format is not None:
+        for digit in "0123456789":
+            source_kerning[(font.cmap[ord(digit)], font.cmap[ord(":")])] = COLON_KERNING[0]
+            source_kerning[(font.cmap[ord(":")], font.cmap[ord(digit)])] = COLON_KERNING[1]
+    kerning = {}
+    for (left, right), value in source_kerning.items():
+        scaled = round(value * scale * 16)
+        if left in ids and right in ids and scaled != 0:
+            kerning[(ids[left], ids[right])] = scaled
+    kerning_scale = 16
+    if kerning:
+        kerning_scale = max(16, math.ceil(max(abs(value) for value in kerning.values()) * 16 / 127))
+        kerning = {pair: max(-127, min(127, round(value * 16 / kerning_scale))) for pair, value in kerning.items()}
+    wide_ids = len(glyphs) > 255
+    tables = [cmap, loca, glyf]
+    if kerning and kerning_format == "classes":
+        left_classes = sorted({tuple(kerning.get((left, right), 0) for right in range(len(glyphs))) for left in range(len(glyphs))})
+        right_classes = sorted({tuple(kerning.get((left, right), 0) for left in range(len(glyphs))) for right in range(len(glyphs))})
+        left_mapping = [left_classes.index(tuple(kerning.get((left, right), 0) for right in range(len(glyphs)))) + 1 for left in range(len(glyphs))]
+        right_mapping = [right_classes.index(tuple(kerning.get((left, right), 0) for left in range(len(glyphs)))) + 1
+                         for right in range(len(glyphs))]
+        values = [0] * (len(left_classes) * len(right_classes))
+        for (left, right), value in kerning.items():
+            values[(left_mapping[left] - 1) * len(right_classes) + right_mapping[right] - 1] = value
+        tables.append(table("kern", struct.pack("<B3xHBB", 3, len(glyphs), len(left_classes), len(right_classes)) + bytes(left_mapping) +
+                            bytes(right_mapping) + struct.pack("<{}b".format(len(values)), *values)))
+    elif kerning:
+        pairs = sorted(kerning)
+        ids_format = "<{}{}".format(2 * len(pairs), "H" if wide_ids else "B")
+        tables.append(table("kern", struct.pack("<B3xI", 0, len(pairs)) + struct.pack(ids_format, *(id for pair in pairs for id in pair)) +
+                            struct.pack("<{}b".format(len(pairs)), *(kerning[pair] for pair in pairs))))
+
+    ascent = round(font.ascender * scale)
+    descent = round(font.descender * scale)
+    drawn = [glyph for glyph in glyphs if glyph["box_h"] > 0]
+    min_y = min(glyph["ofs_y"] for glyph in drawn)
+    max_y = max(glyph["ofs_y"] + glyph["box_h"] for glyph in drawn)
+    head = table("head", struct.pack("<IHHHhHhHhhHHBBBBBBBBBB", 1, len(tables), config["size"], ascent, descent, ascent, descent, 0, min_y,
+                                     max_y, 0, kerning_scale, 1 if long_offsets else 0, 1 if wide_ids else 0, 1, config["bpp"], xy_bits,
+                                     wh_bits, advance_bits, 0, 0, 0))
+    binary = head + b"".join(tables)
+
+    lines = ["font {} {}".format(ascent - descent, -descent)]
+    by_letter = {glyph["letter"]: glyph for glyph in glyphs[1:]}
+    for glyph in glyphs[1:]:
+        bits = BitWriter()
+        for row in glyph["rows"]:
+            for pixel in row:
+                bits.write(pixel, 1)
+        bitmap = bits.data().hex() if glyph["rows"] else "-"
+        lines.append("glyph {} {} {} {} {} {} {}".format(glyph["letter"], (glyph["adv_w"] + 8) >> 4, glyph["box_w"], glyph["box_h"],
+                                                         glyph["ofs_x"], glyph["ofs_y"], bitmap))
+    # Tabs are drawn as 2 spaces
+    if ord(" ") in by_letter:
+        space = by_letter[ord(" ")]
+        lines.append("glyph 9 {} {} {} {} {} -".format((2 * space["adv_w"] + 8) >> 4, 2 * space["box_w"], space["box_h"], space["ofs_x"],
+                                                        space["ofs_y"]))
+    lines.append("missing {}".format(MISSING_LETTER))
+    for left in range(1, len(glyphs)):
+        for right in range(1, len(glyphs)):
+            value = (kerning.get((left, right), 0) * kerning_scale) >> 4
+            lines.append("pair {} {} {}".format(glyphs[left]["letter"], glyphs[right]["letter"], (glyphs[left]["adv_w"] + value + 8) >> 4))
+    return binary, "\n".join(lines) + "\n"
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("config", help="fonts.json of the resources")
+    parser.add_argument("--output", required=True, help="Output directory")
+    args = parser.parse_args()
+    with open(args.config) as config_file:
+        configs = json.load(config_file)
+    os.makedirs(args.output, exist_ok=True)
+    fonts = {name: (config, None) for name, config in configs.items()}
+    fonts.update({name: (configs[source], kerning_format) for name, (source, kerning_format) in KERNED_FONTS.items()})
+    for name, (config, kerning_format) in fonts.items():
+        binary, expected = generate(config, os.path.dirname(os.path.abspath(args.config)), kerning_format)
+        with open(os.path.join(args.output, name + ".bin"), "wb") as output:
+            output.write(binary)
+        with open(os.path.join(args.output, name + ".txt"), "w") as output:
+            output.write(expected)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,158 @@
+// SPI bus arbitration: LCD flushes of the display task mixed with flash reads, page programs and erases of higher
+// priority tasks. Once it asks for the bus, a display transaction must not wait for more than one flash transaction.
+#include <cstring>
+#include <vector>
+#include "Check.h"
+#include "FlashHarness.h"
+#include "drivers/St7789.h"
+
+using namespace Pinetime::Drivers;
+using namespace Pinetime::Host;
+
+namespace {
+  constexpr uint8_t pinLcdCsn = 25;
+  constexpr uint8_t pinLcdDataCommand = 18;
+  constexpr uint8_t pinLcdReset = 26;
+
+  class LcdModel : public SpiDevice {
+  public:
+    uint8_t Transfer(uint8_t /*mosi*/) override {
+      return 0xFF;
+    }
+  };
+
+  FlashHarness harness;
+  Spi lcdSpi {harness.spiMaster, pinLcdCsn};
+  St7789 lcd {lcdSpi, pinLcdDataCommand, pinLcdReset};
+  LcdModel lcdModel;
+  SemaphoreHandle_t initialized;
+
+  // 240x4 lines of RGB565, the LVGL draw buffer of DisplayApp
+  uint8_t lines[240 * 4 * 2];
+  constexpr uint32_t frames = 100;
+  constexpr uint32_t flushesPerFrame = 10;
+  bool drawing = false;
+  bool displayDone = false;
+
+  // Display transactions wait from the end of the previous one of the same flush (or from the call to
+  // DrawBuffer()) until the LCD is selected. This includes the time the display task doesn't run because the flash
+  // tasks have a higher priority. No flash transaction may start while it waits for the bus: it only waits for the
+  // one in progress.
+  Task* displayTask = nullptr;
+  Time displayReady = 0;
+  uint32_t flashTransactionsWhileWaiting = 0;
+  Latency displayWait;
+  uint32_t worstFlashTransactionsWhileWaiting = 0;
+  Time flashSelected = 0;
+  Latency flashTransaction;
+
+  void OnChipSelect(uint32_t pin, bool level) {
+    if (pin == pinLcdCsn) {
+      if (!level && drawing) {
+        displayWait.Add(Now() - displayReady);
+        worstFlashTransactionsWhileWaiting = std::max(worstFlashTransactionsWhileWaiting, flashTransactionsWhileWaiting);
+      } else {
+        displayReady = Now();
+      }
+      flashTransactionsWhileWaiting = 0;
+    } else if (pin == FlashHarness::pinSpiFlashCsn) {
+      if (!level) {
+        flashSelected = Now();
+        if (drawing && WaitingForSemaphore(displayTask)) {
+          flashTransactionsWhileWaiting++;
+        }
+      } else {
+        flashTransaction.Add(Now() - flashSelected);
+      }
+    }
+  }
+
+  void Display() {
+    harness.Init();
+    lcd.Init();
+    xSemaphoreGive(initialized);
+    xSemaphoreGive(initialized);
+
+    TaskHandle_t task = xTaskGetCurrentTaskHandle();
+    drawing = true;
+    for (uint32_t frame = 0; frame < frames; frame++) {
+      for (uint16_t flush = 0; flush < flushesPerFrame; flush++) {
+        displayReady = Now();
+        flashTransactionsWhileWaiting = 0;
+        lcd.DrawBuffer(0, flush * 4, 240, 4, lines, sizeof(lines), [task]() {
+          BaseType_t woken = pdFALSE;
+          vTaskNotifyGiveFromISR(task, &woken);
+        });
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+      }
+      vTaskDelay(pdMS_TO_TICKS(20));
+    }
+    drawing = false;
+    displayDone = true;
+  }
+
+  // Loads resources: 4KB reads, split in 1KB transactions by the driver
+  void FlashReader() {
+    static uint8_t buffer[4096];
+    xSemaphoreTake(initialized, portMAX_DELAY);
+    uint32_t address = 0x200000;
+    while (!displayDone) {
+      harness.spiNorFlash.Read(address, buffer, sizeof(buffer));
+      CHECK(std::memcmp(buffer, harness.flash.memory.data() + address, sizeof(buffer)) == 0);
+      address = 0x200000 + (address + sizeof(buffer)) % 0x40000;
+      vTaskDelay(1);
+    }
+  }
+
+  // Saves settings and logs: erases a sector and programs it page by page
+  void FlashWriter() {
+    static uint8_t page[256];
+    xSemaphoreTake(initialized, portMAX_DELAY);
+    uint32_t sector = 0x300000;
+    while (!displayDone) {
+      harness.spiNorFlash.SectorErase(sector);
+      for (uint32_t offset = 0; offset < NorFlash::sectorSize && !displayDone; offset += sizeof(page)) {
+        std::memset(page, static_cast<uint8_t>(offset >> 8), sizeof(page));
+        harness.spiNorFlash.Write(sector + offset, page, sizeof(page));
+        CHECK(!harness.spiNorFlash.ProgramFailed());
+      }
+      CHECK(!harness.spiNorFlash.EraseFailed());
+      sector += NorFlash::sectorSize;
+    }
+  }
+}
+
+int main() {
+  for (size_t i = 0; i < sizeof(lines); i++) {
+    lines[i] = static_cast<uint8_t>(i);
+  }
+  for (size_t i = 0; i < harness.flash.memory.size(); i++) {
+    harness.flash.memory[i] = static_cast<uint8_t>(i * 13 + (i >> 10));
+  }
+  initialized = xSemaphoreCreateCounting(2, 0);
+  AttachSpiDevice(pinLcdCsn, lcdModel);
+  OnPinChange(OnChipSelect);
+
+  // Priorities of DisplayApp and of the tasks that use the file system (SystemTask, NimBLE)
+  displayTask = Spawn("displayapp", 0, Display);
+  Spawn("reader", 1, FlashReader);
+  Spawn("writer", 2, FlashWriter);
+  Run();
+
+  std::printf("display transactions: %u, wait average %llu us, worst %llu us, %u flash transactions started while waiting\n",
+              displayWait.count,
+              static_cast<unsigned long long>(displayWait.Average() / 1000),
+              static_cast<unsigned long long>(displayWait.worst / 1000),
+              worstFlashTransactionsWhileWaiting);
+  std::printf("flash transactions: %u, worst %llu us\n",
+              flashTransaction.count,
+              static_cast<unsigned long long>(flashTransaction.worst / 1000));
+
+  CHECK_EQUAL(0u, worstFlashTransactionsWhileWaiting);
+  CHECK(displayWait.worst <= flashTransaction.worst);
+  CHECK_EQUAL(0u, spim0.statistics.busContentions);
+  CHECK_EQUAL(0u, spim0.statistics.startsWhileBusy);
+  CHECK_EQUAL(0u, harness.flash.statistics.busyViolations);
+  CHECK_EQUAL(0u, harness.flash.statistics.writeEnableViolations);
+  return Failures() != 0;
+}
@@ -0,0 +1,118 @@
+// Interrupts per LCD flush: EasyDMA list transfers must only interrupt the CPU once per buffer
+#include <cstring>
+#include <vector>
+#include "Check.h"
+#include "Peripherals.h"
+#include "drivers/Spi.h"
+#include "drivers/SpiMaster.h"
+#include "drivers/St7789.h"
+
+using namespace Pinetime::Drivers;
+using namespace Pinetime::Host;
+
+namespace {
+  constexpr uint8_t pinSck = 2;
+  constexpr uint8_t pinMosi = 3;
+  constexpr uint8_t pinMiso = 4;
+  constexpr uint8_t pinLcdCsn = 25;
+  constexpr uint8_t pinLcdDataCommand = 18;
+  constexpr uint8_t pinLcdReset = 26;
+
+  // Collects the pixel data sent after a WriteToRam command
+  class LcdModel : public SpiDevice {
+  public:
+    uint8_t Transfer(uint8_t mosi) override {
+      if (!GetPin(pinLcdDataCommand)) {
+        lastCommand = mosi;
+      } else if (lastCommand == writeToRam) {
+        pixels.push_back(mosi);
+      }
+      return 0xFF;
+    }
+
+    std::vector<uint8_t> pixels;
+
+  private:
+    static constexpr uint8_t writeToRam = 0x2c;
+    uint8_t lastCommand = 0;
+  };
+
+  SpiMaster spiMaster {SpiMaster::SpiModule::SPI0,
+                       {SpiMaster::BitOrder::Msb_Lsb, SpiMaster::Modes::Mode3, SpiMaster::Frequencies::Freq8Mhz, pinSck, pinMosi, pinMiso}};
+  Spi lcdSpi {spiMaster, pinLcdCsn};
+  St7789 lcd {lcdSpi, pinLcdDataCommand, pinLcdReset};
+  LcdModel lcdModel;
+
+  // Globals are in the low 4 GB, like the RAM of the nRF52
+  uint8_t frame[240 * 240 * 2];
+
+  struct Flush {
+    size_t size;
+    // Interrupts of the pixel data, without the 2 writes of the address window (2 interrupts each: STARTED and END)
+    uint32_t expectedSpimInterrupts;
+    uint32_t expectedTimerInterrupts;
+  };
+
+  void CheckFlush(const Flush& flush) {
+    constexpr uint32_t addressWindowInterrupts = 4;
+    lcdModel.pixels.clear();
+    const uint32_t spimInterrupts = InterruptCount(SPIM0_SPIS0_TWIM0_TWIS0_SPI0_TWI0_IRQn);
+    const uint32_t timerInterrupts = InterruptCount(TIMER3_IRQn);
+    const Time start = Now();
+
+    TaskHandle_t task = xTaskGetCurrentTaskHandle();
+    lcd.DrawBuffer(0, 0, 240, 1, frame, flush.size, [task]() {
+      BaseType_t woken = pdFALSE;
+      vTaskNotifyGiveFromISR(task, &woken);
+    });
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+    const uint32_t pixelSpimInterrupts = InterruptCount(SPIM0_SPIS0_TWIM0_TWIS0_SPI0_TWI0_IRQn) - spimInterrupts - addressWindowInterrupts;
+    const uint32_t pixelTimerInterrupts = InterruptCount(TIMER3_IRQn) - timerInterrupts;
+    std::printf("flush %6zu bytes: %3u SPIM + %u TIMER3 interrupts for the pixels, %llu us\n",
+                flush.size,
+                pixelSpimInterrupts,
+                pixelTimerInterrupts,
+                static_cast<unsigned long long>((Now() - start) / 1000));
+
+    CHECK_EQUAL(flush.expectedSpimInterrupts, pixelSpimInterrupts);
+    CHECK_EQUAL(flush.expectedTimerInterrupts, pixelTimerInterrupts);
+    CHECK_EQUAL(flush.size, lcdModel.pixels.size());
+    CHECK(std::memcmp(lcdModel.pixels.data(), frame, std::min(flush.size, lcdModel.pixels.size())) == 0);
+  }
+}
+
+int main() {
+  for (size_t i = 0; i < sizeof(frame); i++) {
+    frame[i] = static_cast<uint8_t>(i * 7);
+  }
+  AttachSpiDevice(pinLcdCsn, lcdModel);
+  ConnectInterrupts(spiMaster);
+
+  Spawn("disp", 2, []() {
+    spiMaster.Init();
+    lcd.Init();
+
+    // 240x4 lines of RGB565, one LVGL flush: 8 chunks of 240 bytes, one interrupt instead of 8 x 2
+    CheckFlush({240 * 4 * 2, 0, 1});
+    // 240x4 lines in the 12 bits always on display format
+    CheckFlush({240 * 4 * 3 / 2, 0, 1});
+    // Whole screen: 480 chunks
+    CheckFlush({240 * 240 * 2, 0, 1});
+    // 3 x 255 bytes as a list, then 2 bytes as a regular transfer (STARTED and END)
+    CheckFlush({767, 2, 1});
+    // 2 x 128 bytes
+    CheckFlush({256, 0, 1});
+    // No divisor between 128 and 255, and a list of a single chunk would never end: 2 regular transfers
+    CheckFlush({257, 4, 0});
+    CheckFlush({509, 4, 0});
+    // Small writes are never lists
+    CheckFlush({200, 2, 0});
+  });
+  Run();
+
+  CHECK_EQUAL(0u, spim0.statistics.startsWhileBusy);
+  CHECK_EQUAL(0u, spim0.statistics.maxCountOverflows);
+  CHECK_EQUAL(0u, spim0.statistics.busContentions);
+  return Failures() != 0;
+}
@@ -0,0 +1,89 @@
+// Loading a resource file the way littlefs reads it (16 bytes at a time), with and without the read-ahead window
+#include <cstring>
+#include "Check.h"
+#include "NorFlash.h"
+#include "Peripherals.h"
+#include "drivers/Spi.h"
+#include "drivers/SpiMaster.h"
+#include "drivers/SpiNorFlash.h"
+
+using namespace Pinetime::Drivers;
+using namespace Pinetime::Host;
+
+namespace {
+  constexpr uint8_t pinSck = 2;
+  constexpr uint8_t pinMosi = 3;
+  constexpr uint8_t pinMiso = 4;
+  constexpr uint8_t pinSpiFlashCsn = 5;
+
+  SpiMaster spiMaster {SpiMaster::SpiModule::SPI0,
+                       {SpiMaster::BitOrder::Msb_Lsb, SpiMaster::Modes::Mode3, SpiMaster::Frequencies::Freq8Mhz, pinSck, pinMosi, pinMiso}};
+  Spi flashSpi {spiMaster, pinSpiFlashCsn};
+  SpiNorFlash spiNorFlash {flashSpi};
+  NorFlash flashModel;
+
+  // About the size of fonts/bebas.bin (120px, 1 bpp, 11 glyphs)
+  constexpr size_t fileSize = 8 * 1024;
+  constexpr size_t readSize = 16;
+  uint8_t file[fileSize];
+
+  struct Result {
+    Time time;
+    uint32_t flashReads;
+    uint64_t busBytes;
+  };
+
+  template <class Order>
+  Result Load(uint32_t address, Order order) {
+    const Time start = Now();
+    const uint32_t reads = flashModel.statistics.reads;
+    const uint64_t bytes = spim0.statistics.bytes;
+    for (size_t i = 0; i < fileSize / readSize; i++) {
+      const size_t offset = order(i) * readSize;
+      spiNorFlash.Read(address + offset, file + offset, readSize);
+    }
+    CHECK(std::memcmp(file, flashModel.memory.data() + address, fileSize) == 0);
+    return {Now() - start, flashModel.statistics.reads - reads, spim0.statistics.bytes - bytes};
+  }
+
+  void Report(const char* name, const Result& result) {
+    std::printf("%-28s %6llu us, %4u flash reads, %6llu bytes on the bus\n",
+                name,
+                static_cast<unsigned long long>(result.time / 1000),
+                result.flashReads,
+                static_cast<unsigned long long>(result.busBytes));
+  }
+}
+
+int main() {
+  for (size_t i = 0; i < flashModel.memory.size(); i++) {
+    flashModel.memory[i] = static_cast<uint8_t>(i * 7 + (i >> 12));
+  }
+  AttachSpiDevice(pinSpiFlashCsn, flashModel);
+  ConnectInterrupts(spiMaster);
+
+  Spawn("flash", 1, []() {
+    spiMaster.Init();
+    flashSpi.Init();
+    spiNorFlash.Init();
+
+    // Sequential: served from the 256 bytes window
+    const Result readAhead = Load(0x100000, [](size_t i) {
+      return i;
+    });
+    // Backwards: every read is a separate transaction, like before the read-ahead window
+    const Result direct = Load(0x200000, [](size_t i) {
+      return fileSize / readSize - 1 - i;
+    });
+    Report("16 byte reads, read-ahead", readAhead);
+    Report("16 byte reads, direct", direct);
+    std::printf("speedup: %.2f\n", static_cast<double>(direct.time) / static_cast<double>(readAhead.time));
+
+    // Only the bus time is simulated: the interrupts and context switches saved by the 16x fewer transactions come on top
+    CHECK(readAhead.flashReads <= fileSize / 256 + 1);
+    CHECK(readAhead.time < direct.time);
+  });
+  Run();
+
+  return Failures() != 0;
+}
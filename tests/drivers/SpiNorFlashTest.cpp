@@ -0,0 +1,111 @@
+// SpiNorFlash reads: data, ordering with the pending page program, and the CPU left to other tasks during a read
+#include <cstring>
+#include "Check.h"
+#include "NorFlash.h"
+#include "Peripherals.h"
+#include "drivers/Spi.h"
+#include "drivers/SpiMaster.h"
+#include "drivers/SpiNorFlash.h"
+
+using namespace Pinetime::Drivers;
+using namespace Pinetime::Host;
+
+namespace {
+  constexpr uint8_t pinSck = 2;
+  constexpr uint8_t pinMosi = 3;
+  constexpr uint8_t pinMiso = 4;
+  constexpr uint8_t pinSpiFlashCsn = 5;
+
+  SpiMaster spiMaster {SpiMaster::SpiModule::SPI0,
+                       {SpiMaster::BitOrder::Msb_Lsb, SpiMaster::Modes::Mode3, SpiMaster::Frequencies::Freq8Mhz, pinSck, pinMosi, pinMiso}};
+  Spi flashSpi {spiMaster, pinSpiFlashCsn};
+  SpiNorFlash spiNorFlash {flashSpi};
+  NorFlash flashModel;
+
+  uint8_t buffer[4096];
+  bool done = false;
+  Time idleTime = 0;
+
+  void CheckRead(uint32_t address, size_t size) {
+    std::memset(buffer, 0, sizeof(buffer));
+    spiNorFlash.Read(address, buffer, size);
+    CHECK(std::memcmp(buffer, flashModel.memory.data() + address, size) == 0);
+  }
+
+  void TestSequentialReads() {
+    const uint32_t reads = flashModel.statistics.reads;
+    // littlefs reads 16 bytes at a time: one flash read per 256 bytes window, after a first read that is
+    // not known to be sequential yet
+    for (uint32_t address = 0x20000; address < 0x20000 + 1024; address += 16) {
+      CheckRead(address, 16);
+    }
+    CHECK_EQUAL(5u, flashModel.statistics.reads - reads);
+  }
+
+  void TestLongReads() {
+    CheckRead(0x1234, 255);
+    CheckRead(0x30001, 3000);
+    CheckRead(0x40000, sizeof(buffer));
+  }
+
+  void TestReadAfterWrite() {
+    // The write stays in the page buffer until the page is read back
+    const uint8_t data[] = {0x12, 0x34, 0x56, 0x78, 0x9A};
+    const uint32_t pagePrograms = flashModel.statistics.pagePrograms;
+    spiNorFlash.SectorErase(0x50000);
+    spiNorFlash.Write(0x50005, data, sizeof(data));
+    CHECK_EQUAL(pagePrograms, flashModel.statistics.pagePrograms);
+
+    CheckRead(0x50000, 32);
+    CHECK_EQUAL(pagePrograms + 1, flashModel.statistics.pagePrograms);
+    CHECK(std::memcmp(buffer + 5, data, sizeof(data)) == 0);
+  }
+
+  void TestCpuDuringRead() {
+    // The reading task sleeps until the SPI interrupt, a lower priority task gets the CPU meanwhile
+    const Time idleStart = idleTime;
+    const Time start = Now();
+    CheckRead(0x60000, sizeof(buffer));
+    const Time readTime = Now() - start;
+    const Time idle = idleTime - idleStart;
+    std::printf("read %zu bytes: %llu us, %llu us left to the idle task\n",
+                sizeof(buffer),
+                static_cast<unsigned long long>(readTime / 1000),
+                static_cast<unsigned long long>(idle / 1000));
+    CHECK(idle * 10 >= readTime * 9);
+  }
+}
+
+int main() {
+  for (size_t i = 0; i < flashModel.memory.size(); i++) {
+    flashModel.memory[i] = static_cast<uint8_t>((i * 131) ^ (i >> 8));
+  }
+  AttachSpiDevice(pinSpiFlashCsn, flashModel);
+  ConnectInterrupts(spiMaster);
+
+  Spawn("flash", 1, []() {
+    spiMaster.Init();
+    flashSpi.Init();
+    spiNorFlash.Init();
+    CHECK_EQUAL(0x0B, spiNorFlash.GetIdentification().manufacturer);
+
+    TestSequentialReads();
+    TestLongReads();
+    TestReadAfterWrite();
+    TestCpuDuringRead();
+    done = true;
+  });
+  Spawn("idle", 0, []() {
+    while (!done) {
+      Busy(Microseconds(10));
+      idleTime += Microseconds(10);
+    }
+  });
+  Run();
+
+  CHECK_EQUAL(0u, spim0.statistics.startsWhileBusy);
+  CHECK_EQUAL(0u, spim0.statistics.maxCountOverflows);
+  CHECK_EQUAL(0u, flashModel.statistics.busyViolations);
+  CHECK_EQUAL(0u, flashModel.statistics.writeEnableViolations);
+  return Failures() != 0;
+}
@@ -0,0 +1,86 @@
+// Waits for the end of page programs and sector erases: timeouts, and no false failure when the task is preempted
+#include <vector>
+#include "Check.h"
+#include "FlashHarness.h"
+
+using namespace Pinetime::Host;
+
+namespace {
+  constexpr uint8_t readStatusRegister = 0x05;
+
+  FlashHarness harness;
+  SemaphoreHandle_t preempt;
+  bool preemptOnBusyStatus = false;
+
+  std::vector<uint8_t> page(256, 0x5A);
+
+  void TestProgram() {
+    harness.spiNorFlash.Write(0x10000, page.data(), page.size());
+    CHECK(!harness.spiNorFlash.ProgramFailed());
+  }
+
+  void TestProgramPreempted() {
+    // A higher priority task runs for 20ms right after a status read that saw the flash busy. The program is done
+    // long before the task polls again, and the 10ms timeout must not have expired.
+    harness.flash.programTime = Microseconds(1500);
+    preemptOnBusyStatus = true;
+    const Time start = Now();
+    harness.spiNorFlash.Write(0x10100, page.data(), page.size());
+    std::printf("page program preempted for 20ms: %llu us\n", static_cast<unsigned long long>((Now() - start) / 1000));
+    CHECK(!preemptOnBusyStatus);
+    CHECK(!harness.spiNorFlash.ProgramFailed());
+    harness.flash.programTime = Microseconds(700);
+  }
+
+  void TestEraseTimeout() {
+    // An erase that never ends fails after 500ms of polling
+    harness.flash.eraseTime = Milliseconds(2000);
+    const Time start = Now();
+    harness.spiNorFlash.SectorErase(0x20000);
+    const Time duration = Now() - start;
+    std::printf("stuck sector erase: failed after %llu ms, %u status polls\n",
+                static_cast<unsigned long long>(duration / 1000000),
+                harness.flash.statistics.statusPolls);
+    CHECK(harness.spiNorFlash.EraseFailed());
+    CHECK(duration >= Milliseconds(500) && duration < Milliseconds(520));
+    // Let the flash finish before going on
+    vTaskDelay(pdMS_TO_TICKS(1600));
+    harness.flash.eraseTime = Milliseconds(45);
+  }
+
+  void TestErase() {
+    const Time start = Now();
+    harness.spiNorFlash.SectorErase(0x30000);
+    std::printf("sector erase: %llu us\n", static_cast<unsigned long long>((Now() - start) / 1000));
+    CHECK(!harness.spiNorFlash.EraseFailed());
+  }
+}
+
+int main() {
+  preempt = xSemaphoreCreateBinary();
+  OnPinChange([](uint32_t pin, bool level) {
+    if (pin == FlashHarness::pinSpiFlashCsn && level && preemptOnBusyStatus &&
+        harness.flash.LastCommand() == readStatusRegister && harness.flash.Busy()) {
+      preemptOnBusyStatus = false;
+      xSemaphoreGive(preempt);
+    }
+  });
+
+  Spawn("flash", 1, []() {
+    harness.Init();
+    TestProgram();
+    TestProgramPreempted();
+    TestErase();
+    TestEraseTimeout();
+    TestErase();
+  });
+  Spawn("hog", 2, []() {
+    if (xSemaphoreTake(preempt, pdMS_TO_TICKS(10000)) == pdTRUE) {
+      Busy(Milliseconds(20));
+    }
+  });
+  Run();
+
+  CHECK_EQUAL(0u, harness.flash.statistics.busyViolations);
+  return Failures() != 0;
+}
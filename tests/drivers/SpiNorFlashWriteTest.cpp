@@ -0,0 +1,101 @@
+// SpiNorFlash write coalescing: page programs of the DFU and littlefs write patterns, and the data they leave in flash
+#include <cstring>
+#include <vector>
+#include "Check.h"
+#include "FlashHarness.h"
+
+using namespace Pinetime::Host;
+
+namespace {
+  FlashHarness harness;
+
+  std::vector<uint8_t> Data(size_t size, uint8_t seed) {
+    std::vector<uint8_t> data(size);
+    for (size_t i = 0; i < size; i++) {
+      data[i] = static_cast<uint8_t>(i * 17 + seed);
+    }
+    return data;
+  }
+
+  bool InFlash(uint32_t address, const std::vector<uint8_t>& data) {
+    return std::memcmp(harness.flash.memory.data() + address, data.data(), data.size()) == 0;
+  }
+
+  uint32_t PagePrograms() {
+    return harness.flash.statistics.pagePrograms;
+  }
+
+  // Writes size bytes at address, writeSize bytes at a time. Returns the page programs until Flush() and after it.
+  std::pair<uint32_t, uint32_t> Write(uint32_t address, const std::vector<uint8_t>& data, size_t writeSize) {
+    const uint32_t before = PagePrograms();
+    for (size_t offset = 0; offset < data.size(); offset += writeSize) {
+      harness.spiNorFlash.Write(address + offset, data.data() + offset, std::min(writeSize, data.size() - offset));
+    }
+    const uint32_t written = PagePrograms() - before;
+    harness.spiNorFlash.Flush();
+    return {written, PagePrograms() - before - written};
+  }
+
+  void TestDfuChunks() {
+    // DfuImage::Append() writes 200 bytes at a time: one program per page instead of 2 per chunk
+    const auto image = Data(2000, 1);
+    harness.spiNorFlash.SectorErase(0x40000);
+    const auto programs = Write(0x40000, image, 200);
+    std::printf("DFU, 2000 bytes in 200 byte writes: %u + %u page programs\n", programs.first, programs.second);
+    CHECK_EQUAL(7u, programs.first);
+    // The last page is only programmed by Flush(): DfuImage::Append() must call it when the image is complete
+    CHECK_EQUAL(1u, programs.second);
+    CHECK(InFlash(0x40000, image));
+  }
+
+  void TestLittlefsProgs() {
+    // littlefs programs 8 bytes at a time (prog_size), then syncs
+    const auto block = Data(1000, 2);
+    harness.spiNorFlash.SectorErase(0x100000);
+    const auto programs = Write(0x100000, block, 8);
+    std::printf("littlefs, 1000 bytes in 8 byte programs: %u + %u page programs\n", programs.first, programs.second);
+    CHECK_EQUAL(3u, programs.first);
+    CHECK_EQUAL(1u, programs.second);
+    CHECK(InFlash(0x100000, block));
+  }
+
+  void TestWholePages() {
+    // Whole pages bypass the buffer. 256 bytes don't fit in the 8 bits MAXCNT: 2 transfers in a single program.
+    const auto pages = Data(1024, 3);
+    harness.spiNorFlash.SectorErase(0x101000);
+    const auto programs = Write(0x101000, pages, 256);
+    std::printf("whole pages, 1024 bytes in 256 byte writes: %u + %u page programs\n", programs.first, programs.second);
+    CHECK_EQUAL(4u, programs.first);
+    CHECK_EQUAL(0u, programs.second);
+    CHECK(InFlash(0x101000, pages));
+  }
+
+  void TestUnalignedWrite() {
+    // Spans 3 pages, bytes around the written area stay erased
+    const auto data = Data(300, 4);
+    harness.spiNorFlash.SectorErase(0x102000);
+    const auto programs = Write(0x102000 + 250, data, 300);
+    CHECK_EQUAL(2u, programs.first);
+    CHECK_EQUAL(1u, programs.second);
+    CHECK(InFlash(0x102000 + 250, data));
+    CHECK_EQUAL(0xFF, harness.flash.memory[0x102000 + 249]);
+    CHECK_EQUAL(0xFF, harness.flash.memory[0x102000 + 550]);
+  }
+}
+
+int main() {
+  Spawn("flash", 1, []() {
+    harness.Init();
+    TestDfuChunks();
+    TestLittlefsProgs();
+    TestWholePages();
+    TestUnalignedWrite();
+  });
+  Run();
+
+  CHECK_EQUAL(0u, spim0.statistics.maxCountOverflows);
+  CHECK_EQUAL(0u, harness.flash.statistics.busyViolations);
+  CHECK_EQUAL(0u, harness.flash.statistics.writeEnableViolations);
+  CHECK_EQUAL(0u, harness.flash.statistics.pageWraps);
+  return Failures() != 0;
+}
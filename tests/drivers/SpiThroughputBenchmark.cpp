@@ -0,0 +1,106 @@
+// Bytes per second of the LCD and the NOR flash sharing SPIM0, as shown by the System Information screen
+// (Spi::Throughput()), with the LCD at its normal clock and in the always on display mode.
+#include "Check.h"
+#include "NorFlash.h"
+#include "Peripherals.h"
+#include "drivers/Spi.h"
+#include "drivers/SpiMaster.h"
+#include "drivers/SpiNorFlash.h"
+#include "drivers/St7789.h"
+
+using namespace Pinetime::Drivers;
+using namespace Pinetime::Host;
+
+namespace {
+  constexpr uint8_t pinSck = 2;
+  constexpr uint8_t pinMosi = 3;
+  constexpr uint8_t pinMiso = 4;
+  constexpr uint8_t pinSpiFlashCsn = 5;
+  constexpr uint8_t pinLcdCsn = 25;
+  constexpr uint8_t pinLcdDataCommand = 18;
+  constexpr uint8_t pinLcdReset = 26;
+
+  class LcdModel : public SpiDevice {
+  public:
+    uint8_t Transfer(uint8_t /*mosi*/) override {
+      return 0xFF;
+    }
+  };
+
+  SpiMaster spiMaster {SpiMaster::SpiModule::SPI0,
+                       {SpiMaster::BitOrder::Msb_Lsb, SpiMaster::Modes::Mode3, SpiMaster::Frequencies::Freq8Mhz, pinSck, pinMosi, pinMiso}};
+  Spi lcdSpi {spiMaster, pinLcdCsn};
+  St7789 lcd {lcdSpi, pinLcdDataCommand, pinLcdReset};
+  Spi flashSpi {spiMaster, pinSpiFlashCsn};
+  SpiNorFlash spiNorFlash {flashSpi};
+  LcdModel lcdModel;
+  NorFlash flashModel;
+
+  // One LVGL buffer: 240x4 lines of RGB565
+  uint8_t frame[240 * 4 * 2];
+  uint8_t resource[1024];
+
+  void Flush(size_t size) {
+    TaskHandle_t task = xTaskGetCurrentTaskHandle();
+    lcd.DrawBuffer(0, 0, 240, 4, frame, size, [task]() {
+      BaseType_t woken = pdFALSE;
+      vTaskNotifyGiveFromISR(task, &woken);
+    });
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+  }
+
+  // A full screen (60 buffers) interleaved with 1 KB resource reads, like a watch face loading its fonts and images
+  // while it is drawn. Returns the bytes per second of the LCD over that time.
+  uint64_t DrawScreen(size_t bufferSize) {
+    const Time start = Now();
+    for (uint32_t buffer = 0; buffer < 60; buffer++) {
+      Flush(bufferSize);
+      spiNorFlash.Read(0x100000 + (buffer * sizeof(resource)), resource, sizeof(resource));
+    }
+    return 60 * bufferSize * 1000000000ULL / (Now() - start);
+  }
+}
+
+int main() {
+  AttachSpiDevice(pinLcdCsn, lcdModel);
+  AttachSpiDevice(pinSpiFlashCsn, flashModel);
+  ConnectInterrupts(spiMaster);
+
+  Spawn("disp", 2, []() {
+    spiMaster.Init();
+    lcd.Init();
+    flashSpi.Init();
+    spiNorFlash.Init();
+
+    const uint64_t normal = DrawScreen(sizeof(frame));
+    std::printf("normal mode:    LCD %6u B/s while selected since boot, flash %6u B/s, screen drawn at %6llu B/s\n",
+                lcd.SpiThroughput(),
+                spiNorFlash.SpiThroughput(),
+                static_cast<unsigned long long>(normal));
+    CHECK(lcd.SpiThroughput() > 900 * 1024);
+    CHECK(spiNorFlash.SpiThroughput() > 900 * 1024);
+
+    // The always on display mode may be entered again while it is already on
+    lcd.LowPowerOn();
+    lcd.LowPowerOn();
+    CHECK(lcdSpi.GetFrequency() == SpiMaster::Frequencies::Freq2Mhz);
+    // 12 bit pixels
+    const uint64_t lowPower = DrawScreen(sizeof(frame) * 3 / 4);
+    std::printf("always on mode: LCD %6u B/s while selected since boot, flash %6u B/s, screen drawn at %6llu B/s\n",
+                lcd.SpiThroughput(),
+                spiNorFlash.SpiThroughput(),
+                static_cast<unsigned long long>(lowPower));
+    // The flash keeps its own clock
+    CHECK(spiNorFlash.SpiThroughput() > 900 * 1024);
+
+    lcd.LowPowerOff();
+    CHECK(lcdSpi.GetFrequency() == SpiMaster::Frequencies::Freq8Mhz);
+    const uint64_t restored = DrawScreen(sizeof(frame));
+    std::printf("normal again:   screen drawn at %6llu B/s\n", static_cast<unsigned long long>(restored));
+    CHECK(restored * 10 > normal * 9);
+  });
+  Run();
+
+  CHECK_EQUAL(0u, spim0.statistics.busContentions);
+  return Failures() != 0;
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdio>
+
+namespace Pinetime {
+  namespace Host {
+    inline int& Failures() {
+      static int failures = 0;
+      return failures;
+    }
+  }
+}
+
+// Reports the failure and carries on, main() returns Pinetime::Host::Failures() != 0
+#define CHECK(condition)                                                                                                                   \
+  do {                                                                                                                                     \
+    if (!(condition)) {                                                                                                                    \
+      std::fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition);                                                  \
+      Pinetime::Host::Failures()++;                                                                                                        \
+    }                                                                                                                                      \
+  } while (0)
+
+#define CHECK_EQUAL(expected, actual)                                                                                                      \
+  do {                                                                                                                                     \
+    const auto expectedValue = (expected);                                                                                                 \
+    const auto actualValue = (actual);                                                                                                     \
+    if (!(expectedValue == actualValue)) {                                                                                                 \
+      std::fprintf(stderr,                                                                                                                 \
+                   "%s:%d: check failed: %s == %s (%lld != %lld)\n",                                                                      \
+                   __FILE__,                                                                                                               \
+                   __LINE__,                                                                                                               \
+                   #expected,                                                                                                              \
+                   #actual,                                                                                                                \
+                   static_cast<long long>(expectedValue),                                                                                  \
+                   static_cast<long long>(actualValue));                                                                                   \
+      Pinetime::Host::Failures()++;                                                                                                        \
+    }                                                                                                                                      \
+  } while (0)
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <algorithm>
+#include "NorFlash.h"
+#include "Peripherals.h"
+#include "drivers/Spi.h"
+#include "drivers/SpiMaster.h"
+#include "drivers/SpiNorFlash.h"
+
+namespace Pinetime {
+  namespace Host {
+    // SpiNorFlash driver on SPIM0, connected to the NOR flash model. Must be a global: EasyDMA buffers are in
+    // the low 4 GB, see Simulation.h.
+    class FlashHarness {
+    public:
+      static constexpr uint8_t pinSck = 2;
+      static constexpr uint8_t pinMosi = 3;
+      static constexpr uint8_t pinMiso = 4;
+      static constexpr uint8_t pinSpiFlashCsn = 5;
+
+      // Must be called from a task
+      void Init() {
+        AttachSpiDevice(pinSpiFlashCsn, flash);
+        ConnectInterrupts(spiMaster);
+        spiMaster.Init();
+        flashSpi.Init();
+        spiNorFlash.Init();
+      }
+
+      Drivers::SpiMaster spiMaster {
+        Drivers::SpiMaster::SpiModule::SPI0,
+        {Drivers::SpiMaster::BitOrder::Msb_Lsb, Drivers::SpiMaster::Modes::Mode3, Drivers::SpiMaster::Frequencies::Freq8Mhz, pinSck, pinMosi, pinMiso}};
+      Drivers::Spi flashSpi {spiMaster, pinSpiFlashCsn};
+      Drivers::SpiNorFlash spiNorFlash {flashSpi};
+      NorFlash flash;
+    };
+
+    // Count, average and worst case of a duration
+    struct Latency {
+      uint32_t count = 0;
+      Time total = 0;
+      Time worst = 0;
+
+      void Add(Time duration) {
+        count++;
+        total += duration;
+        worst = std::max(worst, duration);
+      }
+
+      Time Average() const {
+        return (count == 0) ? 0 : total / count;
+      }
+    };
+
+    // Bytes per second
+    inline uint64_t Throughput(uint64_t bytes, Time duration) {
+      return (duration == 0) ? 0 : bytes * 1000000000ULL / duration;
+    }
+  }
+}
@@ -0,0 +1,408 @@
+#include <lvgl/lvgl.h>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <list>
+#include <map>
+
+namespace {
+  // Keeps the blocks aligned like malloc()
+  constexpr size_t heapHeaderSize = alignof(std::max_align_t);
+  size_t heapUsed = 0;
+  size_t heapPeak = 0;
+
+  std::map<char, lv_fs_drv_t>& Drivers() {
+    static std::map<char, lv_fs_drv_t> drivers;
+    return drivers;
+  }
+
+  lv_fs_drv_t* Driver(const char* path) {
+    auto driver = Drivers().find(path[0]);
+    return (driver == Drivers().end()) ? nullptr : &driver->second;
+  }
+
+  // "F:/images/a.bin" -> "images/a.bin", like lv_fs_get_real_path()
+  const char* RealPath(const char* path) {
+    path++;
+    while (*path == ':' || *path == '\\' || *path == '/') {
+      path++;
+    }
+    return path;
+  }
+
+  /* LVGL's built-in decoder for raw image files (lv_img_decoder_built_in_*() of lv_img_decoder.c): every line
+   * read is a seek and a read of the file. Only the formats of the external resources are supported. */
+  struct BuiltInSession {
+    lv_fs_file_t file;
+    lv_color_t palette[2];
+    lv_opa_t opa[2];
+  };
+
+  lv_res_t BuiltInInfo(lv_img_decoder_t* /*decoder*/, const void* src, lv_img_header_t* header) {
+    if (lv_img_src_get_type(src) != LV_IMG_SRC_FILE) {
+      return LV_RES_INV;
+    }
+    lv_fs_file_t file;
+    if (lv_fs_open(&file, static_cast<const char*>(src), LV_FS_MODE_RD) != LV_FS_RES_OK) {
+      return LV_RES_INV;
+    }
+    uint32_t read = 0;
+    const lv_fs_res_t res = lv_fs_read(&file, header, sizeof(*header), &read);
+    lv_fs_close(&file);
+    if (res != LV_FS_RES_OK || read != sizeof(*header)) {
+      return LV_RES_INV;
+    }
+    return (header->cf >= LV_IMG_CF_TRUE_COLOR && header->cf <= LV_IMG_CF_ALPHA_8BIT) ? LV_RES_OK : LV_RES_INV;
+  }
+
+  lv_res_t BuiltInOpen(lv_img_decoder_t* /*decoder*/, lv_img_decoder_dsc_t* dsc) {
+    const lv_img_cf_t cf = dsc->header.cf;
+    if (dsc->src_type != LV_IMG_SRC_FILE ||
+        (cf != LV_IMG_CF_TRUE_COLOR && cf != LV_IMG_CF_TRUE_COLOR_ALPHA && cf != LV_IMG_CF_INDEXED_1BIT)) {
+      return LV_RES_INV;
+    }
+    auto* session = static_cast<BuiltInSession*>(lv_mem_alloc(sizeof(BuiltInSession)));
+    if (lv_fs_open(&session->file, static_cast<const char*>(dsc->src), LV_FS_MODE_RD) != LV_FS_RES_OK) {
+      lv_mem_free(session);
+      return LV_RES_INV;
+    }
+    dsc->user_data = session;
+    if (cf == LV_IMG_CF_INDEXED_1BIT) {
+      lv_color32_t palette[2];
+      lv_fs_seek(&session->file, sizeof(lv_img_header_t));
+      lv_fs_read(&session->file, palette, sizeof(palette), nullptr);
+      for (int i = 0; i < 2; i++) {
+        session->palette[i] = lv_color_make(palette[i].ch.red, palette[i].ch.green, palette[i].ch.blue);
+        session->opa[i] = palette[i].ch.alpha;
+      }
+    }
+    dsc->img_data = nullptr;
+    return LV_RES_OK;
+  }
+
+  lv_res_t BuiltInReadLine(lv_img_decoder_t* /*decoder*/,
+                           lv_img_decoder_dsc_t* dsc,
+                           lv_coord_t x,
+                           lv_coord_t y,
+                           lv_coord_t len,
+                           uint8_t* buf) {
+    auto* session = static_cast<BuiltInSession*>(dsc->user_data);
+    const uint8_t pxSize = lv_img_cf_get_px_size(dsc->header.cf);
+    if (dsc->header.cf != LV_IMG_CF_INDEXED_1BIT) {
+      const uint32_t position = sizeof(lv_img_header_t) + (((y * dsc->header.w + x) * pxSize) >> 3);
+      lv_fs_seek(&session->file, position);
+      uint32_t read = 0;
+      const lv_fs_res_t res = lv_fs_read(&session->file, buf, (len * pxSize) >> 3, &read);
+      return (res == LV_FS_RES_OK && read == static_cast<uint32_t>((len * pxSize) >> 3)) ? LV_RES_OK : LV_RES_INV;
+    }
+
+    // The whole line is read whatever len is. Images are at most 2048 pixels wide.
+    const uint32_t lineSize = (dsc->header.w + 7) >> 3;
+    uint8_t line[2048 / 8];
+    lv_fs_seek(&session->file, sizeof(lv_img_header_t) + 2 * sizeof(lv_color32_t) + (lineSize * y) + (x >> 3));
+    lv_fs_read(&session->file, line, lineSize, nullptr);
+    const uint8_t* data = line;
+    int8_t position = 7 - (x & 0x07);
+    for (lv_coord_t i = 0; i < len; i++) {
+      const uint8_t index = (*data >> position) & 0x01;
+      std::memcpy(buf, &session->palette[index], sizeof(lv_color_t));
+      buf[sizeof(lv_color_t)] = session->opa[index];
+      buf += LV_IMG_PX_SIZE_ALPHA_BYTE;
+      position--;
+      if (position < 0) {
+        position = 7;
+        data++;
+      }
+    }
+    return LV_RES_OK;
+  }
+
+  void BuiltInClose(lv_img_decoder_t* /*decoder*/, lv_img_decoder_dsc_t* dsc) {
+    auto* session = static_cast<BuiltInSession*>(dsc->user_data);
+    if (session != nullptr) {
+      lv_fs_close(&session->file);
+      lv_mem_free(session);
+      dsc->user_data = nullptr;
+    }
+  }
+
+  std::list<lv_img_decoder_t>& Decoders() {
+    static std::list<lv_img_decoder_t> decoders {{BuiltInInfo, BuiltInOpen, BuiltInReadLine, BuiltInClose, nullptr}};
+    return decoders;
+  }
+}
+
+lv_color_t lv_color_make(uint8_t r, uint8_t g, uint8_t b) {
+  lv_color_t color;
+  color.ch.red = r >> 3;
+  color.ch.green_h = g >> 5;
+  color.ch.green_l = (g >> 2) & 0x07;
+  color.ch.blue = b >> 3;
+  return color;
+}
+
+void* lv_mem_alloc(size_t size) {
+  // The size of every block is stored before it
+  auto* block = static_cast<uint8_t*>(std::malloc(size + heapHeaderSize));
+  if (block == nullptr) {
+    return nullptr;
+  }
+  std::memcpy(block, &size, sizeof(size));
+  heapUsed += size;
+  heapPeak = std::max(heapPeak, heapUsed);
+  return block + heapHeaderSize;
+}
+
+void lv_mem_free(const void* data) {
+  if (data == nullptr) {
+    return;
+  }
+  auto* block = static_cast<uint8_t*>(const_cast<void*>(data)) - heapHeaderSize;
+  size_t size;
+  std::memcpy(&size, block, sizeof(size));
+  heapUsed -= size;
+  std::free(block);
+}
+
+size_t Pinetime::Host::LvglHeapUsed() {
+  return heapUsed;
+}
+
+size_t Pinetime::Host::LvglHeapPeak() {
+  return heapPeak;
+}
+
+void Pinetime::Host::ResetLvglHeapPeak() {
+  heapPeak = heapUsed;
+}
+
+bool lv_font_get_glyph_dsc(const lv_font_t* font_p, lv_font_glyph_dsc_t* dsc_out, uint32_t letter, uint32_t letter_next) {
+  return font_p->get_glyph_dsc(font_p, dsc_out, letter, letter_next);
+}
+
+const uint8_t* lv_font_get_glyph_bitmap(const lv_font_t* font_p, uint32_t letter) {
+  return font_p->get_glyph_bitmap(font_p, letter);
+}
+
+void lv_fs_drv_init(lv_fs_drv_t* drv) {
+  std::memset(drv, 0, sizeof(*drv));
+}
+
+void lv_fs_drv_register(lv_fs_drv_t* drv) {
+  Drivers()[drv->letter] = *drv;
+}
+
+lv_fs_res_t lv_fs_open(lv_fs_file_t* file_p, const char* path, lv_fs_mode_t mode) {
+  file_p->drv = Driver(path);
+  file_p->file_d = nullptr;
+  if (file_p->drv == nullptr || file_p->drv->open_cb == nullptr) {
+    return LV_FS_RES_NOT_EX;
+  }
+  file_p->file_d = lv_mem_alloc(file_p->drv->file_size);
+  const lv_fs_res_t res = file_p->drv->open_cb(file_p->drv, file_p->file_d, RealPath(path), mode);
+  if (res != LV_FS_RES_OK) {
+    lv_mem_free(file_p->file_d);
+    file_p->file_d = nullptr;
+    file_p->drv = nullptr;
+  }
+  return res;
+}
+
+lv_fs_res_t lv_fs_close(lv_fs_file_t* file_p) {
+  if (file_p->drv == nullptr) {
+    return LV_FS_RES_INV_PARAM;
+  }
+  lv_fs_res_t res = LV_FS_RES_NOT_IMP;
+  if (file_p->drv->close_cb != nullptr) {
+    res = file_p->drv->close_cb(file_p->drv, file_p->file_d);
+  }
+  lv_mem_free(file_p->file_d);
+  file_p->file_d = nullptr;
+  file_p->drv = nullptr;
+  return res;
+}
+
+lv_fs_res_t lv_fs_read(lv_fs_file_t* file_p, void* buf, uint32_t btr, uint32_t* br) {
+  if (br != nullptr) {
+    *br = 0;
+  }
+  if (file_p->drv == nullptr) {
+    return LV_FS_RES_INV_PARAM;
+  }
+  if (file_p->drv->read_cb == nullptr) {
+    return LV_FS_RES_NOT_IMP;
+  }
+  uint32_t read = 0;
+  const lv_fs_res_t res = file_p->drv->read_cb(file_p->drv, file_p->file_d, buf, btr, &read);
+  if (br != nullptr) {
+    *br = read;
+  }
+  return res;
+}
+
+lv_fs_res_t lv_fs_seek(lv_fs_file_t* file_p, uint32_t pos) {
+  if (file_p->drv == nullptr) {
+    return LV_FS_RES_INV_PARAM;
+  }
+  if (file_p->drv->seek_cb == nullptr) {
+    return LV_FS_RES_NOT_IMP;
+  }
+  return file_p->drv->seek_cb(file_p->drv, file_p->file_d, pos);
+}
+
+lv_fs_res_t lv_fs_tell(lv_fs_file_t* file_p, uint32_t* pos) {
+  if (file_p->drv == nullptr) {
+    return LV_FS_RES_INV_PARAM;
+  }
+  if (file_p->drv->tell_cb == nullptr) {
+    return LV_FS_RES_NOT_IMP;
+  }
+  return file_p->drv->tell_cb(file_p->drv, file_p->file_d, pos);
+}
+
+lv_fs_res_t lv_fs_size(lv_fs_file_t* file_p, uint32_t* size) {
+  if (file_p->drv == nullptr) {
+    return LV_FS_RES_INV_PARAM;
+  }
+  if (file_p->drv->size_cb == nullptr) {
+    return LV_FS_RES_NOT_IMP;
+  }
+  return file_p->drv->size_cb(file_p->drv, file_p->file_d, size);
+}
+
+lv_fs_res_t lv_fs_dir_open(lv_fs_dir_t* rddir_p, const char* path) {
+  rddir_p->drv = Driver(path);
+  rddir_p->dir_d = nullptr;
+  if (rddir_p->drv == nullptr || rddir_p->drv->dir_open_cb == nullptr) {
+    return LV_FS_RES_NOT_EX;
+  }
+  rddir_p->dir_d = lv_mem_alloc(rddir_p->drv->rddir_size);
+  const lv_fs_res_t res = rddir_p->drv->dir_open_cb(rddir_p->drv, rddir_p->dir_d, RealPath(path));
+  if (res != LV_FS_RES_OK) {
+    lv_mem_free(rddir_p->dir_d);
+    rddir_p->dir_d = nullptr;
+    rddir_p->drv = nullptr;
+  }
+  return res;
+}
+
+lv_fs_res_t lv_fs_dir_read(lv_fs_dir_t* rddir_p, char* fn) {
+  fn[0] = '\0';
+  if (rddir_p->drv == nullptr) {
+    return LV_FS_RES_INV_PARAM;
+  }
+  if (rddir_p->drv->dir_read_cb == nullptr) {
+    return LV_FS_RES_NOT_IMP;
+  }
+  return rddir_p->drv->dir_read_cb(rddir_p->drv, rddir_p->dir_d, fn);
+}
+
+lv_fs_res_t lv_fs_dir_close(lv_fs_dir_t* rddir_p) {
+  if (rddir_p->drv == nullptr) {
+    return LV_FS_RES_INV_PARAM;
+  }
+  lv_fs_res_t res = LV_FS_RES_NOT_IMP;
+  if (rddir_p->drv->dir_close_cb != nullptr) {
+    res = rddir_p->drv->dir_close_cb(rddir_p->drv, rddir_p->dir_d);
+  }
+  lv_mem_free(rddir_p->dir_d);
+  rddir_p->dir_d = nullptr;
+  rddir_p->drv = nullptr;
+  return res;
+}
+
+lv_img_src_t lv_img_src_get_type(const void* src) {
+  const auto first = *static_cast<const uint8_t*>(src);
+  if (first >= 0x20 && first <= 0x7F) {
+    return LV_IMG_SRC_FILE;
+  }
+  return (first >= 0x80) ? LV_IMG_SRC_SYMBOL : LV_IMG_SRC_VARIABLE;
+}
+
+uint8_t lv_img_cf_get_px_size(lv_img_cf_t cf) {
+  switch (cf) {
+    case LV_IMG_CF_TRUE_COLOR:
+    case LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED:
+      return LV_COLOR_DEPTH;
+    case LV_IMG_CF_TRUE_COLOR_ALPHA:
+      return LV_IMG_PX_SIZE_ALPHA_BYTE << 3;
+    case LV_IMG_CF_INDEXED_1BIT:
+    case LV_IMG_CF_ALPHA_1BIT:
+      return 1;
+    case LV_IMG_CF_INDEXED_2BIT:
+    case LV_IMG_CF_ALPHA_2BIT:
+      return 2;
+    case LV_IMG_CF_INDEXED_4BIT:
+    case LV_IMG_CF_ALPHA_4BIT:
+      return 4;
+    case LV_IMG_CF_INDEXED_8BIT:
+    case LV_IMG_CF_ALPHA_8BIT:
+      return 8;
+    default:
+      return 0;
+  }
+}
+
+lv_img_decoder_t* lv_img_decoder_create() {
+  Decoders().push_front({});
+  return &Decoders().front();
+}
+
+void lv_img_decoder_set_info_cb(lv_img_decoder_t* decoder, lv_img_decoder_info_f_t info_cb) {
+  decoder->info_cb = info_cb;
+}
+
+void lv_img_decoder_set_open_cb(lv_img_decoder_t* decoder, lv_img_decoder_open_f_t open_cb) {
+  decoder->open_cb = open_cb;
+}
+
+void lv_img_decoder_set_read_line_cb(lv_img_decoder_t* decoder, lv_img_decoder_read_line_f_t read_line_cb) {
+  decoder->read_line_cb = read_line_cb;
+}
+
+void lv_img_decoder_set_close_cb(lv_img_decoder_t* decoder, lv_img_decoder_close_f_t close_cb) {
+  decoder->close_cb = close_cb;
+}
+
+lv_res_t lv_img_decoder_get_info(const char* src, lv_img_header_t* header) {
+  for (auto& decoder : Decoders()) {
+    if (decoder.info_cb != nullptr && decoder.info_cb(&decoder, src, header) == LV_RES_OK) {
+      return LV_RES_OK;
+    }
+  }
+  return LV_RES_INV;
+}
+
+lv_res_t lv_img_decoder_open(lv_img_decoder_dsc_t* dsc, const void* src, lv_color_t color) {
+  std::memset(dsc, 0, sizeof(*dsc));
+  dsc->color = color;
+  dsc->src_type = lv_img_src_get_type(src);
+  dsc->src = src;
+  for (auto& decoder : Decoders()) {
+    if (decoder.info_cb == nullptr || decoder.open_cb == nullptr) {
+      continue;
+    }
+    if (decoder.info_cb(&decoder, src, &dsc->header) != LV_RES_OK) {
+      continue;
+    }
+    dsc->decoder = &decoder;
+    if (decoder.open_cb(&decoder, dsc) == LV_RES_OK) {
+      return LV_RES_OK;
+    }
+  }
+  dsc->decoder = nullptr;
+  return LV_RES_INV;
+}
+
+lv_res_t lv_img_decoder_read_line(lv_img_decoder_dsc_t* dsc, lv_coord_t x, lv_coord_t y, lv_coord_t len, uint8_t* buf) {
+  if (dsc->decoder == nullptr || dsc->decoder->read_line_cb == nullptr) {
+    return LV_RES_INV;
+  }
+  return dsc->decoder->read_line_cb(dsc->decoder, dsc, x, y, len, buf);
+}
+
+void lv_img_decoder_close(lv_img_decoder_dsc_t* dsc) {
+  if (dsc->decoder != nullptr && dsc->decoder->close_cb != nullptr) {
+    dsc->decoder->close_cb(dsc->decoder, dsc);
+  }
+}
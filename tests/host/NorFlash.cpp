@@ -0,0 +1,153 @@
+#include "NorFlash.h"
+#include <algorithm>
+
+using namespace Pinetime::Host;
+
+namespace {
+  enum Commands : uint8_t {
+    PageProgram = 0x02,
+    Read = 0x03,
+    ReadStatusRegister = 0x05,
+    WriteEnable = 0x06,
+    FastRead = 0x0B,
+    ReadConfigurationRegister = 0x15,
+    SectorErase = 0x20,
+    ReadSecurityRegister = 0x2B,
+    ReadIdentification = 0x9F,
+    ReleaseFromDeepPowerDown = 0xAB,
+    DeepPowerDown = 0xB9
+  };
+
+  constexpr uint8_t identification[] = {0x0B, 0x40, 0x16};
+
+  uint32_t Address(const std::vector<uint8_t>& command) {
+    return (command[1] << 16) | (command[2] << 8) | command[3];
+  }
+}
+
+NorFlash::NorFlash() : memory(size, 0xFF), sectorErases(size / sectorSize, 0) {
+}
+
+bool NorFlash::Busy() const {
+  return Now() < busyUntil;
+}
+
+uint8_t NorFlash::LastCommand() const {
+  return command.empty() ? 0 : command[0];
+}
+
+void NorFlash::Select() {
+  command.clear();
+  programData.clear();
+}
+
+uint8_t NorFlash::Transfer(uint8_t mosi) {
+  if (command.empty() && Busy() && mosi != ReadStatusRegister) {
+    statistics.busyViolations++;
+  }
+  const size_t index = command.size();
+  command.push_back(mosi);
+
+  switch (command[0]) {
+    case ReadStatusRegister:
+      if (index == 1) {
+        statistics.statusPolls++;
+      }
+      return (Busy() ? 0x01 : 0x00) | (writeEnabled ? 0x02 : 0x00);
+    case ReadIdentification:
+      return (index >= 1 && index <= 3) ? identification[index - 1] : 0xFF;
+    case Read:
+    case FastRead: {
+      const size_t dataStart = (command[0] == FastRead) ? 5 : 4;
+      if (index == 3) {
+        readAddress = Address(command);
+        statistics.reads++;
+      }
+      if (index < dataStart) {
+        return 0xFF;
+      }
+      statistics.bytesRead++;
+      const uint8_t data = memory[readAddress % size];
+      readAddress++;
+      return data;
+    }
+    case PageProgram:
+      if (index >= 4) {
+        programData.push_back(mosi);
+      }
+      return 0xFF;
+    case ReadConfigurationRegister:
+    case ReadSecurityRegister:
+      return 0x00;
+    default:
+      return 0xFF;
+  }
+}
+
+void NorFlash::Deselect() {
+  if (command.empty()) {
+    return;
+  }
+  if (Busy() && command[0] != ReadStatusRegister) {
+    // Ignored by the chip
+    return;
+  }
+  Execute();
+}
+
+void NorFlash::Execute() {
+  switch (command[0]) {
+    case WriteEnable:
+      writeEnabled = true;
+      break;
+    case PageProgram: {
+      if (command.size() < 4) {
+        break;
+      }
+      if (!writeEnabled) {
+        statistics.writeEnableViolations++;
+        break;
+      }
+      const uint32_t address = Address(command);
+      const uint32_t page = address & ~(pageSize - 1);
+      if ((address % pageSize) + programData.size() > pageSize) {
+        statistics.pageWraps++;
+      }
+      for (size_t i = 0; i < programData.size(); i++) {
+        // Programming only clears bits
+        memory[page + ((address + i) % pageSize)] &= programData[i];
+      }
+      statistics.pagePrograms++;
+      statistics.bytesProgrammed += programData.size();
+      writeEnabled = false;
+      busyUntil = Now() + programTime;
+      break;
+    }
+    case SectorErase: {
+      if (command.size() < 4) {
+        break;
+      }
+      if (!writeEnabled) {
+        statistics.writeEnableViolations++;
+        break;
+      }
+      const uint32_t sector = (Address(command) % size) / sectorSize;
+      std::fill_n(memory.begin() + sector * sectorSize, sectorSize, 0xFF);
+      sectorErases[sector]++;
+      statistics.sectorErases++;
+      writeEnabled = false;
+      busyUntil = Now() + eraseTime;
+      break;
+    }
+    default:
+      break;
+  }
+}
+
+uint32_t NorFlash::SectorEraseCount(uint32_t address) const {
+  return sectorErases[(address % size) / sectorSize];
+}
+
+uint32_t NorFlash::MaxSectorEraseCount() const {
+  return *std::max_element(sectorErases.begin(), sectorErases.end());
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "Peripherals.h"
+
+namespace Pinetime {
+  namespace Host {
+    // SPI NOR flash of the PineTime (4MB, 256 bytes pages, 4KB sectors). Programs and erases keep the flash busy
+    // for programTime / eraseTime once the chip select is released, like the real chip.
+    class NorFlash : public SpiDevice {
+    public:
+      static constexpr uint32_t size = 4 * 1024 * 1024;
+      static constexpr uint32_t pageSize = 256;
+      static constexpr uint32_t sectorSize = 4096;
+
+      struct Statistics {
+        uint32_t pagePrograms = 0;
+        uint32_t bytesProgrammed = 0;
+        uint32_t sectorErases = 0;
+        uint32_t reads = 0;
+        uint64_t bytesRead = 0;
+        uint32_t statusPolls = 0;
+        // Errors: command other than a status read while busy, program or erase without write enable,
+        // program crossing the end of a page (the real chip wraps around)
+        uint32_t busyViolations = 0;
+        uint32_t writeEnableViolations = 0;
+        uint32_t pageWraps = 0;
+      };
+
+      NorFlash();
+
+      void Select() override;
+      uint8_t Transfer(uint8_t mosi) override;
+      void Deselect() override;
+
+      bool Busy() const;
+      // First byte of the current or last transaction
+      uint8_t LastCommand() const;
+      uint32_t SectorEraseCount(uint32_t address) const;
+      uint32_t MaxSectorEraseCount() const;
+
+      std::vector<uint8_t> memory;
+      Statistics statistics;
+      Time programTime = Microseconds(700);
+      Time eraseTime = Milliseconds(45);
+
+    private:
+      void Execute();
+
+      std::vector<uint8_t> command;
+      uint32_t readAddress = 0;
+      bool writeEnabled = false;
+      Time busyUntil = 0;
+      std::vector<uint32_t> sectorErases;
+      std::vector<uint8_t> programData;
+    };
+  }
+}
@@ -0,0 +1,373 @@
+#include "Peripherals.h"
+#include <hal/nrf_gpio.h>
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+using namespace Pinetime::Host;
+
+uint32_t SystemCoreClock = Dwt::cpuFrequency;
+
+NRF_SPIM_Type nrfSpim0;
+NRF_SPIM_Type nrfSpim1;
+NRF_TIMER_Type nrfTimer2;
+NRF_TIMER_Type nrfTimer3;
+NRF_PPI_Type nrfPpi;
+NRF_GPIOTE_Type nrfGpiote;
+DWT_Type dwt;
+
+namespace {
+  std::vector<Peripheral*>& Peripherals() {
+    static std::vector<Peripheral*> peripherals;
+    return peripherals;
+  }
+
+  Peripheral* Owner(const Register& reg) {
+    for (auto* peripheral : Peripherals()) {
+      if (peripheral->Owns(reg)) {
+        return peripheral;
+      }
+    }
+    return nullptr;
+  }
+
+  uint32_t Address(const Register& reg) {
+    return static_cast<uint32_t>(reinterpret_cast<uintptr_t>(&reg));
+  }
+
+  std::array<bool, 32> pins {};
+
+  // Drivers::Spi sets its chip select pin in its constructor, which may run before the globals of this file
+  std::map<uint32_t, SpiDevice*>& SpiDevices() {
+    static std::map<uint32_t, SpiDevice*> spiDevices;
+    return spiDevices;
+  }
+  std::vector<std::function<void(uint32_t, bool)>> pinObservers;
+
+  [[noreturn]] void Fail(const char* message) {
+    std::fprintf(stderr, "%s at %llu ns\n", message, static_cast<unsigned long long>(Now()));
+    std::abort();
+  }
+}
+
+Spim Pinetime::Host::spim0 {nrfSpim0, SPIM0_SPIS0_TWIM0_TWIS0_SPI0_TWI0_IRQn};
+Timer Pinetime::Host::timer2 {nrfTimer2, TIMER2_IRQn};
+Timer Pinetime::Host::timer3 {nrfTimer3, TIMER3_IRQn};
+Ppi Pinetime::Host::ppi {nrfPpi};
+Dwt dwtModel {dwt};
+
+Register& Register::operator=(uint32_t newValue) {
+  Peripheral* owner = Owner(*this);
+  if (owner == nullptr) {
+    value = newValue;
+  } else {
+    owner->Write(*this, newValue);
+  }
+  // Interrupts raised by a register write (a task triggering an event through PPI...) preempt the running code
+  if (!InInterrupt()) {
+    ServiceInterrupts();
+  }
+  return *this;
+}
+
+Register::operator uint32_t() const {
+  Peripheral* owner = Owner(*this);
+  return (owner == nullptr) ? value : owner->Read(*this);
+}
+
+Peripheral::Peripheral(void* registers, size_t size, int irq)
+  : begin {reinterpret_cast<uintptr_t>(registers)}, end {reinterpret_cast<uintptr_t>(registers) + size}, irq {irq} {
+  if (end > (1ULL << 32)) {
+    Fail("Registers outside of the 32 bits address space, the host tests must be linked with -no-pie");
+  }
+  Peripherals().push_back(this);
+}
+
+Peripheral::~Peripheral() {
+  auto& peripherals = Peripherals();
+  peripherals.erase(std::find(peripherals.begin(), peripherals.end(), this));
+}
+
+void Peripheral::Write(Register& reg, uint32_t value) {
+  reg.value = value;
+}
+
+uint32_t Peripheral::Read(const Register& reg) {
+  return reg.value;
+}
+
+bool Peripheral::Owns(const Register& reg) const {
+  const auto address = reinterpret_cast<uintptr_t>(&reg);
+  return address >= begin && address < end;
+}
+
+void Peripheral::RaiseEvent(Register& event, uint32_t intenMask) {
+  event.value = 1;
+  ppi.OnEvent(event);
+  if ((inten & intenMask) != 0) {
+    RequestInterrupt(irq);
+  }
+}
+
+Spim::Spim(NRF_SPIM_Type& registers, int irq) : Peripheral {&registers, sizeof(registers), irq}, registers {registers} {
+}
+
+void Spim::Write(Register& reg, uint32_t value) {
+  if (&reg == &registers.TASKS_START) {
+    if (value != 0) {
+      Start();
+    }
+  } else if (&reg == &registers.TASKS_STOP) {
+    if (value != 0) {
+      RaiseEvent(registers.EVENTS_STOPPED, 1 << 1);
+    }
+  } else if (&reg == &registers.INTENSET) {
+    inten |= value;
+  } else if (&reg == &registers.INTENCLR) {
+    inten &= ~value;
+  } else {
+    reg.value = value;
+  }
+}
+
+uint32_t Spim::Read(const Register& reg) {
+  if (&reg == &registers.INTENSET || &reg == &registers.INTENCLR) {
+    return inten;
+  }
+  if (&reg == &registers.EVENTS_END && reg.value == 0 && !InInterrupt()) {
+    // The firmware busy waits for the end of the transfer
+    if (!busy || !Spin()) {
+      Fail("Waiting for SPIM END while no transfer is in progress");
+    }
+  }
+  return reg.value;
+}
+
+Time Spim::TransferTime(size_t size) const {
+  uint64_t frequency;
+  switch (registers.FREQUENCY.value) {
+    case SPIM_FREQUENCY_FREQUENCY_K125:
+      frequency = 125000;
+      break;
+    case SPIM_FREQUENCY_FREQUENCY_K250:
+      frequency = 250000;
+      break;
+    case SPIM_FREQUENCY_FREQUENCY_K500:
+      frequency = 500000;
+      break;
+    case SPIM_FREQUENCY_FREQUENCY_M1:
+      frequency = 1000000;
+      break;
+    case SPIM_FREQUENCY_FREQUENCY_M2:
+      frequency = 2000000;
+      break;
+    case SPIM_FREQUENCY_FREQUENCY_M4:
+      frequency = 4000000;
+      break;
+    default:
+      frequency = 8000000;
+      break;
+  }
+  return (size * 8 * 1000000000ULL) / frequency;
+}
+
+void Spim::Start() {
+  if (registers.ENABLE.value != SPIM_ENABLE_ENABLE_Enabled) {
+    return;
+  }
+  if (busy) {
+    statistics.startsWhileBusy++;
+    return;
+  }
+  // MAXCNT is 8 bits wide on the nRF52832
+  if (registers.TXD.MAXCNT.value > 0xFF || registers.RXD.MAXCNT.value > 0xFF) {
+    statistics.maxCountOverflows++;
+  }
+  busy = true;
+  txPointer = registers.TXD.PTR.value;
+  txCount = registers.TXD.MAXCNT.value & 0xFF;
+  rxPointer = registers.RXD.PTR.value;
+  rxCount = registers.RXD.MAXCNT.value & 0xFF;
+  RaiseEvent(registers.EVENTS_STARTED, 1 << 19);
+  At(Now() + TransferTime(std::max(txCount, rxCount)), [this]() {
+    Complete();
+  });
+}
+
+void Spim::Complete() {
+  const auto selected = SelectedSpiDevices();
+  if (selected.size() > 1) {
+    statistics.busContentions++;
+  }
+  const auto* tx = reinterpret_cast<const uint8_t*>(static_cast<uintptr_t>(txPointer));
+  auto* rx = reinterpret_cast<uint8_t*>(static_cast<uintptr_t>(rxPointer));
+  for (uint32_t i = 0; i < std::max(txCount, rxCount); i++) {
+    const uint8_t mosi = (i < txCount) ? tx[i] : static_cast<uint8_t>(registers.ORC.value);
+    uint8_t miso = 0xFF;
+    for (auto& device : selected) {
+      miso = device.second->Transfer(mosi);
+    }
+    if (i < rxCount) {
+      rx[i] = miso;
+    }
+  }
+
+  registers.TXD.AMOUNT.value = txCount;
+  registers.RXD.AMOUNT.value = rxCount;
+  if (registers.TXD.LIST.value == SPIM_TXD_LIST_LIST_ArrayList) {
+    registers.TXD.PTR.value += txCount;
+  }
+  if (registers.RXD.LIST.value == SPIM_RXD_LIST_LIST_ArrayList) {
+    registers.RXD.PTR.value += rxCount;
+  }
+  statistics.transfers++;
+  statistics.bytes += std::max(txCount, rxCount);
+  busy = false;
+
+  RaiseEvent(registers.EVENTS_ENDTX, 1 << 8);
+  RaiseEvent(registers.EVENTS_ENDRX, 1 << 4);
+  RaiseEvent(registers.EVENTS_END, 1 << 6);
+}
+
+Timer::Timer(NRF_TIMER_Type& registers, int irq) : Peripheral {&registers, sizeof(registers), irq}, registers {registers} {
+}
+
+void Timer::Write(Register& reg, uint32_t value) {
+  if (value == 0 && (&reg == &registers.TASKS_START || &reg == &registers.TASKS_STOP || &reg == &registers.TASKS_COUNT ||
+                     &reg == &registers.TASKS_CLEAR || &reg == &registers.TASKS_SHUTDOWN)) {
+    return;
+  }
+  if (&reg == &registers.TASKS_START) {
+    running = true;
+  } else if (&reg == &registers.TASKS_STOP || &reg == &registers.TASKS_SHUTDOWN) {
+    running = false;
+  } else if (&reg == &registers.TASKS_CLEAR) {
+    counter = 0;
+  } else if (&reg == &registers.TASKS_COUNT) {
+    if (running && registers.MODE.value != TIMER_MODE_MODE_Timer) {
+      const uint32_t mask = (registers.BITMODE.value == TIMER_BITMODE_BITMODE_16Bit) ? 0xFFFF : 0xFFFFFFFF;
+      counter = (counter + 1) & mask;
+      for (size_t i = 0; i < 6; i++) {
+        if (counter == registers.CC[i].value) {
+          RaiseEvent(registers.EVENTS_COMPARE[i], 1 << (16 + i));
+        }
+      }
+    }
+  } else if (&reg == &registers.INTENSET) {
+    inten |= value;
+  } else if (&reg == &registers.INTENCLR) {
+    inten &= ~value;
+  } else {
+    reg.value = value;
+  }
+}
+
+uint32_t Timer::Read(const Register& reg) {
+  if (&reg == &registers.INTENSET || &reg == &registers.INTENCLR) {
+    return inten;
+  }
+  return reg.value;
+}
+
+Ppi::Ppi(NRF_PPI_Type& registers) : Peripheral {&registers, sizeof(registers), -1}, registers {registers} {
+}
+
+void Ppi::Write(Register& reg, uint32_t value) {
+  if (&reg == &registers.CHENSET) {
+    registers.CHEN.value |= value;
+    return;
+  }
+  if (&reg == &registers.CHENCLR) {
+    registers.CHEN.value &= ~value;
+    return;
+  }
+  for (auto& group : registers.TASKS_CHG) {
+    const size_t index = &group - registers.TASKS_CHG;
+    if (&reg == &group.EN && value != 0) {
+      registers.CHEN.value |= registers.CHG[index].value;
+      return;
+    }
+    if (&reg == &group.DIS && value != 0) {
+      registers.CHEN.value &= ~registers.CHG[index].value;
+      return;
+    }
+  }
+  reg.value = value;
+}
+
+uint32_t Ppi::Read(const Register& reg) {
+  if (&reg == &registers.CHENSET || &reg == &registers.CHENCLR) {
+    return registers.CHEN.value;
+  }
+  return reg.value;
+}
+
+void Ppi::OnEvent(const Register& event) {
+  // All the channels listening to the event fire, even if one of their tasks disables another one
+  const uint32_t address = Address(event);
+  std::vector<size_t> channels;
+  for (size_t channel = 0; channel < std::size(registers.CH); channel++) {
+    if ((registers.CHEN.value & (1UL << channel)) != 0 && registers.CH[channel].EEP.value == address) {
+      channels.push_back(channel);
+    }
+  }
+  for (size_t channel : channels) {
+    for (uint32_t task : {registers.CH[channel].TEP.value, registers.FORK[channel].TEP.value}) {
+      if (task != 0) {
+        *reinterpret_cast<Register*>(static_cast<uintptr_t>(task)) = 1;
+      }
+    }
+  }
+}
+
+Dwt::Dwt(DWT_Type& registers) : Peripheral {&registers, sizeof(registers), -1}, registers {registers} {
+}
+
+uint32_t Dwt::Read(const Register& reg) {
+  if (&reg == &registers.CYCCNT) {
+    return static_cast<uint32_t>(Now() * (cpuFrequency / 1000000) / 1000);
+  }
+  return reg.value;
+}
+
+void Pinetime::Host::SetPin(uint32_t pin, bool level) {
+  if (pins[pin] == level) {
+    return;
+  }
+  pins[pin] = level;
+  auto device = SpiDevices().find(pin);
+  if (device != SpiDevices().end()) {
+    if (level) {
+      device->second->Deselect();
+    } else {
+      device->second->Select();
+    }
+  }
+  for (auto& observer : pinObservers) {
+    observer(pin, level);
+  }
+}
+
+bool Pinetime::Host::GetPin(uint32_t pin) {
+  return pins[pin];
+}
+
+void Pinetime::Host::AttachSpiDevice(uint32_t pinCsn, SpiDevice& device) {
+  SpiDevices()[pinCsn] = &device;
+}
+
+std::map<uint32_t, SpiDevice*> Pinetime::Host::SelectedSpiDevices() {
+  std::map<uint32_t, SpiDevice*> selected;
+  for (auto& device : SpiDevices()) {
+    if (!pins[device.first]) {
+      selected.insert(device);
+    }
+  }
+  return selected;
+}
+
+void Pinetime::Host::OnPinChange(std::function<void(uint32_t pin, bool level)> observer) {
+  pinObservers.push_back(std::move(observer));
+}
@@ -0,0 +1,159 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <nrf.h>
+#include "Simulation.h"
+
+namespace Pinetime {
+  namespace Host {
+    // Device on the SPI bus, selected while its chip select pin is low
+    class SpiDevice {
+    public:
+      virtual ~SpiDevice() = default;
+
+      virtual void Select() {
+      }
+
+      // Full duplex: returns the byte sent back while mosi is received
+      virtual uint8_t Transfer(uint8_t mosi) = 0;
+
+      virtual void Deselect() {
+      }
+    };
+
+    // Model of a peripheral, owns the registers of the peripheral
+    class Peripheral {
+    public:
+      Peripheral(void* registers, size_t size, int irq);
+      virtual ~Peripheral();
+      Peripheral(const Peripheral&) = delete;
+      Peripheral& operator=(const Peripheral&) = delete;
+
+      virtual void Write(Register& reg, uint32_t value);
+      virtual uint32_t Read(const Register& reg);
+
+      bool Owns(const Register& reg) const;
+
+    protected:
+      // Sets the event, triggers the PPI channels listening to it and requests the interrupt if it is enabled
+      void RaiseEvent(Register& event, uint32_t intenMask);
+
+      uint32_t inten = 0;
+
+    private:
+      uintptr_t begin;
+      uintptr_t end;
+      int irq;
+    };
+
+    class Spim : public Peripheral {
+    public:
+      struct Statistics {
+        uint32_t transfers = 0;
+        uint64_t bytes = 0;
+        // Errors: START while a transfer is in progress, MAXCNT above 255 (8 bits on the nRF52832),
+        // several devices selected at the same time
+        uint32_t startsWhileBusy = 0;
+        uint32_t maxCountOverflows = 0;
+        uint32_t busContentions = 0;
+      };
+
+      Spim(NRF_SPIM_Type& registers, int irq);
+
+      void Write(Register& reg, uint32_t value) override;
+      uint32_t Read(const Register& reg) override;
+
+      Statistics statistics;
+
+    private:
+      void Start();
+      void Complete();
+      Time TransferTime(size_t size) const;
+
+      NRF_SPIM_Type& registers;
+      bool busy = false;
+      uint32_t txPointer = 0;
+      uint32_t txCount = 0;
+      uint32_t rxPointer = 0;
+      uint32_t rxCount = 0;
+    };
+
+    // Only the counter modes are simulated
+    class Timer : public Peripheral {
+    public:
+      Timer(NRF_TIMER_Type& registers, int irq);
+
+      void Write(Register& reg, uint32_t value) override;
+      uint32_t Read(const Register& reg) override;
+
+    private:
+      NRF_TIMER_Type& registers;
+      bool running = false;
+      uint32_t counter = 0;
+    };
+
+    class Ppi : public Peripheral {
+    public:
+      explicit Ppi(NRF_PPI_Type& registers);
+
+      void Write(Register& reg, uint32_t value) override;
+      uint32_t Read(const Register& reg) override;
+
+      // Triggers the tasks of the enabled channels whose event is event
+      void OnEvent(const Register& event);
+
+    private:
+      NRF_PPI_Type& registers;
+    };
+
+    class Dwt : public Peripheral {
+    public:
+      explicit Dwt(DWT_Type& registers);
+
+      uint32_t Read(const Register& reg) override;
+
+      static constexpr uint64_t cpuFrequency = 64000000;
+
+    private:
+      DWT_Type& registers;
+    };
+
+    extern Spim spim0;
+    extern Timer timer2;
+    extern Timer timer3;
+    extern Ppi ppi;
+
+    // Chip select of a device on the SPI bus
+    void AttachSpiDevice(uint32_t pinCsn, SpiDevice& device);
+    // Devices whose chip select pin is low
+    std::map<uint32_t, SpiDevice*> SelectedSpiDevices();
+    void OnPinChange(std::function<void(uint32_t pin, bool level)> observer);
+
+    // Installs the SPIM0 and TIMER3 interrupt handlers of main.cpp
+    template <class SpiMaster>
+    void ConnectInterrupts(SpiMaster& spiMaster) {
+      SetInterruptHandler(SPIM0_SPIS0_TWIM0_TWIS0_SPI0_TWI0_IRQn, [&spiMaster]() {
+        if (((NRF_SPIM0->INTENSET & (1 << 6)) != 0) && NRF_SPIM0->EVENTS_END == 1) {
+          NRF_SPIM0->EVENTS_END = 0;
+          spiMaster.OnEndEvent();
+        }
+        if (((NRF_SPIM0->INTENSET & (1 << 19)) != 0) && NRF_SPIM0->EVENTS_STARTED == 1) {
+          NRF_SPIM0->EVENTS_STARTED = 0;
+          spiMaster.OnStartedEvent();
+        }
+        if (((NRF_SPIM0->INTENSET & (1 << 1)) != 0) && NRF_SPIM0->EVENTS_STOPPED == 1) {
+          NRF_SPIM0->EVENTS_STOPPED = 0;
+        }
+      });
+      SetInterruptHandler(TIMER3_IRQn, [&spiMaster]() {
+        if (NRF_TIMER3->EVENTS_COMPARE[1] == 1) {
+          NRF_TIMER3->EVENTS_COMPARE[1] = 0;
+          spiMaster.OnListEndEvent();
+        }
+      });
+    }
+  }
+}
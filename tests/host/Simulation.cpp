@@ -0,0 +1,410 @@
+#include "Simulation.h"
+#include <algorithm>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <malloc.h>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <pthread.h>
+#include <set>
+#include <sys/mman.h>
+#include <vector>
+
+namespace Pinetime {
+  namespace Host {
+    enum class States { Ready, Blocked, Finished };
+
+    struct Task {
+      const char* name;
+      unsigned priority;
+      std::function<void()> function;
+      pthread_t thread;
+      std::condition_variable resumed;
+      States state = States::Ready;
+      // Order of the ready tasks of the same priority
+      uint64_t readySequence = 0;
+      // Blocked tasks are woken up at this time, the call that blocked then fails
+      Time wakeTime = forever;
+      bool timedOut = false;
+      Semaphore* waitingSemaphore = nullptr;
+      bool waitingNotification = false;
+      uint32_t notification = 0;
+    };
+
+    struct Semaphore {
+      unsigned count;
+      unsigned maxCount;
+      std::vector<Task*> waiters;
+    };
+  }
+}
+
+using namespace Pinetime::Host;
+
+namespace {
+  constexpr size_t stackSize = 512 * 1024;
+
+  // Hands over the execution between the scheduler (running == nullptr) and the tasks
+  std::mutex handover;
+  std::condition_variable schedulerResumed;
+  Task* running = nullptr;
+
+  std::vector<std::unique_ptr<Task>> tasks;
+  uint64_t readySequence = 0;
+
+  Time now = 0;
+  uint64_t eventSequence = 0;
+  std::map<std::pair<Time, uint64_t>, std::function<void()>> events;
+
+  std::map<int, std::function<void()>> interruptHandlers;
+  std::set<int> enabledInterrupts;
+  std::set<int> pendingInterrupts;
+  std::map<int, uint32_t> servicedInterrupts;
+  bool inInterrupt = false;
+
+  // EasyDMA pointers are 32 bits: keep the heap of every thread in the brk area, next to the globals
+  const bool lowHeap = [] {
+    mallopt(M_MMAP_MAX, 0);
+    mallopt(M_ARENA_MAX, 1);
+    return true;
+  }();
+
+  void MakeReady(Task* task) {
+    task->state = States::Ready;
+    task->readySequence = readySequence++;
+    task->wakeTime = forever;
+  }
+
+  Task* HighestReady() {
+    Task* highest = nullptr;
+    for (auto& task : tasks) {
+      if (task->state == States::Ready &&
+          (highest == nullptr || task->priority > highest->priority ||
+           (task->priority == highest->priority && task->readySequence < highest->readySequence))) {
+        highest = task.get();
+      }
+    }
+    return highest;
+  }
+
+  // Called by the scheduler, returns when the task blocks or returns
+  void Resume(Task* task) {
+    std::unique_lock<std::mutex> lock(handover);
+    running = task;
+    task->resumed.notify_one();
+    schedulerResumed.wait(lock, [] {
+      return running == nullptr;
+    });
+  }
+
+  // Called by the running task, returns when the scheduler resumes it
+  void Suspend(Task* task) {
+    std::unique_lock<std::mutex> lock(handover);
+    running = nullptr;
+    schedulerResumed.notify_one();
+    task->resumed.wait(lock, [task] {
+      return running == task;
+    });
+  }
+
+  void* TaskEntry(void* argument) {
+    auto* task = static_cast<Task*>(argument);
+    {
+      std::unique_lock<std::mutex> lock(handover);
+      task->resumed.wait(lock, [task] {
+        return running == task;
+      });
+    }
+    task->function();
+    std::unique_lock<std::mutex> lock(handover);
+    task->state = States::Finished;
+    running = nullptr;
+    schedulerResumed.notify_one();
+    return nullptr;
+  }
+
+  Time NextWakeTime() {
+    Time next = events.empty() ? forever : events.begin()->first.first;
+    for (auto& task : tasks) {
+      if (task->state == States::Blocked) {
+        next = std::min(next, task->wakeTime);
+      }
+    }
+    return next;
+  }
+
+  // Processes the hardware events and the timeouts up to time
+  void AdvanceTo(Time time) {
+    while (!events.empty() && events.begin()->first.first <= time) {
+      auto event = events.begin();
+      now = std::max(now, event->first.first);
+      auto function = std::move(event->second);
+      events.erase(event);
+      // Like interrupts, hardware events run to completion
+      inInterrupt = true;
+      function();
+      inInterrupt = false;
+      ServiceInterrupts();
+    }
+    now = std::max(now, time);
+    for (auto& task : tasks) {
+      if (task->state == States::Blocked && task->wakeTime <= now) {
+        if (task->waitingSemaphore != nullptr) {
+          auto& waiters = task->waitingSemaphore->waiters;
+          waiters.erase(std::find(waiters.begin(), waiters.end(), task.get()));
+          task->waitingSemaphore = nullptr;
+        }
+        task->waitingNotification = false;
+        task->timedOut = true;
+        MakeReady(task.get());
+      }
+    }
+  }
+
+  // Blocks the running task until it is made ready or until timeout. Returns false on timeout.
+  bool Block(Time timeout) {
+    Task* task = running;
+    if (task == nullptr) {
+      std::fprintf(stderr, "Blocking call outside of a task\n");
+      std::abort();
+    }
+    task->state = States::Blocked;
+    task->timedOut = false;
+    task->wakeTime = (timeout == forever) ? forever : now + timeout;
+    Suspend(task);
+    return !task->timedOut;
+  }
+
+  void Deadlock() {
+    std::fprintf(stderr, "Deadlock at %llu ns, blocked tasks:", static_cast<unsigned long long>(now));
+    for (auto& task : tasks) {
+      if (task->state == States::Blocked) {
+        std::fprintf(stderr, " %s", task->name);
+      }
+    }
+    std::fprintf(stderr, "\n");
+    std::abort();
+  }
+}
+
+Task* Pinetime::Host::Spawn(const char* name, unsigned priority, std::function<void()> function) {
+  auto task = std::make_unique<Task>();
+  task->name = name;
+  task->priority = priority;
+  task->function = std::move(function);
+  MakeReady(task.get());
+
+  void* stack = mmap(nullptr, stackSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_32BIT, -1, 0);
+  if (stack == MAP_FAILED) {
+    std::perror("mmap");
+    std::abort();
+  }
+  pthread_attr_t attributes;
+  pthread_attr_init(&attributes);
+  pthread_attr_setstack(&attributes, stack, stackSize);
+  if (pthread_create(&task->thread, &attributes, TaskEntry, task.get()) != 0) {
+    std::fprintf(stderr, "Can't create task %s\n", name);
+    std::abort();
+  }
+  pthread_attr_destroy(&attributes);
+  tasks.push_back(std::move(task));
+  return tasks.back().get();
+}
+
+void Pinetime::Host::Run() {
+  while (std::any_of(tasks.begin(), tasks.end(), [](auto& task) {
+    return task->state != States::Finished;
+  })) {
+    Task* next = HighestReady();
+    if (next != nullptr) {
+      Resume(next);
+      continue;
+    }
+    const Time wakeTime = NextWakeTime();
+    if (wakeTime == forever) {
+      Deadlock();
+    }
+    AdvanceTo(wakeTime);
+  }
+  for (auto& task : tasks) {
+    pthread_join(task->thread, nullptr);
+  }
+  tasks.clear();
+  events.clear();
+}
+
+Time Pinetime::Host::Now() {
+  return now;
+}
+
+void Pinetime::Host::At(Time time, std::function<void()> event) {
+  events.emplace(std::make_pair(std::max(time, now), eventSequence++), std::move(event));
+}
+
+bool Pinetime::Host::Spin() {
+  if (inInterrupt || events.empty()) {
+    return false;
+  }
+  AdvanceTo(NextWakeTime());
+  Reschedule();
+  return true;
+}
+
+void Pinetime::Host::Busy(Time duration) {
+  const Time end = now + duration;
+  while (NextWakeTime() <= end) {
+    AdvanceTo(NextWakeTime());
+    Reschedule();
+  }
+  AdvanceTo(end);
+}
+
+Task* Pinetime::Host::CurrentTask() {
+  return running;
+}
+
+unsigned Pinetime::Host::Priority(const Task* task) {
+  return task->priority;
+}
+
+bool Pinetime::Host::WaitingForSemaphore(const Task* task) {
+  return task->waitingSemaphore != nullptr;
+}
+
+bool Pinetime::Host::InInterrupt() {
+  return inInterrupt;
+}
+
+void Pinetime::Host::SetInterruptHandler(int irq, std::function<void()> handler) {
+  interruptHandlers[irq] = std::move(handler);
+}
+
+void Pinetime::Host::EnableInterrupt(int irq, bool enable) {
+  if (enable) {
+    enabledInterrupts.insert(irq);
+  } else {
+    enabledInterrupts.erase(irq);
+  }
+}
+
+void Pinetime::Host::RequestInterrupt(int irq) {
+  pendingInterrupts.insert(irq);
+}
+
+void Pinetime::Host::ServiceInterrupts() {
+  if (inInterrupt) {
+    return;
+  }
+  inInterrupt = true;
+  while (!pendingInterrupts.empty()) {
+    const int irq = *pendingInterrupts.begin();
+    pendingInterrupts.erase(pendingInterrupts.begin());
+    auto handler = interruptHandlers.find(irq);
+    if (enabledInterrupts.count(irq) != 0 && handler != interruptHandlers.end()) {
+      servicedInterrupts[irq]++;
+      handler->second();
+    }
+  }
+  inInterrupt = false;
+}
+
+uint32_t Pinetime::Host::InterruptCount(int irq) {
+  return servicedInterrupts[irq];
+}
+
+Semaphore* Pinetime::Host::CreateSemaphore(unsigned initialCount, unsigned maxCount) {
+  return new Semaphore {initialCount, maxCount, {}};
+}
+
+void Pinetime::Host::DeleteSemaphore(Semaphore* semaphore) {
+  delete semaphore;
+}
+
+bool Pinetime::Host::Take(Semaphore* semaphore, Time timeout) {
+  if (semaphore->count > 0) {
+    semaphore->count--;
+    return true;
+  }
+  if (timeout == 0) {
+    return false;
+  }
+  semaphore->waiters.push_back(running);
+  running->waitingSemaphore = semaphore;
+  return Block(timeout);
+}
+
+bool Pinetime::Host::Give(Semaphore* semaphore, Task** woken) {
+  if (woken != nullptr) {
+    *woken = nullptr;
+  }
+  if (semaphore->waiters.empty()) {
+    if (semaphore->count >= semaphore->maxCount) {
+      return false;
+    }
+    semaphore->count++;
+    return true;
+  }
+
+  // The semaphore goes straight to the waiter of the highest priority
+  auto next = std::max_element(semaphore->waiters.begin(), semaphore->waiters.end(), [](const Task* a, const Task* b) {
+    return a->priority < b->priority;
+  });
+  Task* task = *next;
+  semaphore->waiters.erase(next);
+  task->waitingSemaphore = nullptr;
+  MakeReady(task);
+  if (woken != nullptr) {
+    *woken = task;
+  }
+  return true;
+}
+
+void Pinetime::Host::Delay(Time duration) {
+  if (duration == 0) {
+    MakeReady(running);
+    Suspend(running);
+    return;
+  }
+  Block(duration);
+}
+
+uint32_t Pinetime::Host::NotifyTake(bool clear, Time timeout) {
+  if (running->notification == 0 && timeout != 0) {
+    running->waitingNotification = true;
+    Block(timeout);
+  }
+  const uint32_t value = running->notification;
+  if (clear) {
+    running->notification = 0;
+  } else if (value > 0) {
+    running->notification--;
+  }
+  return value;
+}
+
+void Pinetime::Host::NotifyGive(Task* task, Task** woken) {
+  if (woken != nullptr) {
+    *woken = nullptr;
+  }
+  task->notification++;
+  if (task->waitingNotification) {
+    task->waitingNotification = false;
+    MakeReady(task);
+    if (woken != nullptr) {
+      *woken = task;
+    }
+  }
+}
+
+void Pinetime::Host::Reschedule() {
+  if (inInterrupt || running == nullptr) {
+    return;
+  }
+  Task* next = HighestReady();
+  if (next != nullptr && next != running && next->priority > running->priority) {
+    MakeReady(running);
+    Suspend(running);
+  }
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+namespace Pinetime {
+  namespace Host {
+    // Simulated time, in nanoseconds since the start of the program
+    using Time = uint64_t;
+
+    constexpr Time Microseconds(uint64_t us) {
+      return us * 1000;
+    }
+
+    constexpr Time Milliseconds(uint64_t ms) {
+      return ms * 1000 * 1000;
+    }
+
+    struct Task;
+    struct Semaphore;
+
+    /* Deterministic stand-in for the FreeRTOS scheduler. Tasks are threads, but only one of them runs at a time
+     * and firmware code doesn't take any simulated time: time only advances when all tasks are blocked, or when
+     * the running task busy waits on the hardware (see Spin()). Hardware models schedule their events with At(),
+     * the events and the interrupts they raise run before the tasks they wake up.
+     *
+     * The firmware stores buffer addresses in 32 bits EasyDMA registers: task stacks are allocated in the low
+     * 4 GB of the address space, and host executables are linked without PIE so that globals and the heap are too.
+     */
+    Task* Spawn(const char* name, unsigned priority, std::function<void()> function);
+    // Runs the tasks until they have all returned. Aborts if they are all blocked forever.
+    void Run();
+
+    Time Now();
+    // Schedules a hardware event
+    void At(Time time, std::function<void()> event);
+    // Busy wait of the running task until the next hardware event. Returns false if there is nothing to wait for.
+    bool Spin();
+    // Busy wait of the running task for the given time
+    void Busy(Time duration);
+
+    Task* CurrentTask();
+    unsigned Priority(const Task* task);
+    // True while the task is blocked on a semaphore
+    bool WaitingForSemaphore(const Task* task);
+    // True in interrupt handlers and hardware events
+    bool InInterrupt();
+
+    // Interrupts are requested by hardware events and serviced once the event has been processed, or right away
+    // when requested by a register write of the running task
+    void SetInterruptHandler(int irq, std::function<void()> handler);
+    void EnableInterrupt(int irq, bool enable);
+    void RequestInterrupt(int irq);
+    void ServiceInterrupts();
+    // Number of times the handler has been called
+    uint32_t InterruptCount(int irq);
+
+    // FreeRTOS primitives, see the headers in include/
+    Semaphore* CreateSemaphore(unsigned initialCount, unsigned maxCount);
+    void DeleteSemaphore(Semaphore* semaphore);
+    bool Take(Semaphore* semaphore, Time timeout);
+    // Returns false if the semaphore was already full. woken is set to the task that got it, if any.
+    bool Give(Semaphore* semaphore, Task** woken);
+    void Delay(Time duration);
+    uint32_t NotifyTake(bool clear, Time timeout);
+    void NotifyGive(Task* task, Task** woken);
+    // Lets a ready task of a higher priority than the running one run
+    void Reschedule();
+
+    constexpr Time forever = UINT64_MAX;
+  }
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+// Host build: FreeRTOS API on top of the simulated scheduler (see Simulation.h)
+#include <cstdint>
+#include "Simulation.h"
+
+using TickType_t = uint32_t;
+using BaseType_t = long;
+using UBaseType_t = unsigned long;
+using StackType_t = uint32_t;
+
+#define configTICK_RATE_HZ 1024
+#define configMAX_PRIORITIES 3
+
+#define pdFALSE 0
+#define pdTRUE  1
+#define pdPASS  pdTRUE
+#define pdFAIL  pdFALSE
+
+#define portMAX_DELAY    ((TickType_t) 0xffffffffUL)
+#define pdMS_TO_TICKS(x) ((TickType_t) (((TickType_t) (x) * (TickType_t) configTICK_RATE_HZ) / (TickType_t) 1000U))
+
+#define portYIELD_FROM_ISR(x) (void) (x)
+#define portYIELD()           Pinetime::Host::Delay(0)
+
+// Only one task runs at a time and it is never preempted by an interrupt in the middle of a statement
+#define taskENTER_CRITICAL()
+#define taskEXIT_CRITICAL()
+#define taskENTER_CRITICAL_FROM_ISR()  0
+#define taskEXIT_CRITICAL_FROM_ISR(x) (void) (x)
+
+namespace Pinetime {
+  namespace Host {
+    // Start of the tick
+    constexpr Time TickTime(uint64_t tick) {
+      return (tick * 1000000000ULL + configTICK_RATE_HZ - 1) / configTICK_RATE_HZ;
+    }
+
+    inline TickType_t CurrentTick() {
+      return static_cast<TickType_t>(Now() * configTICK_RATE_HZ / 1000000000ULL);
+    }
+
+    // Time until the start of the given number of ticks from now, or forever
+    inline Time Timeout(TickType_t ticks) {
+      if (ticks == portMAX_DELAY) {
+        return forever;
+      }
+      const uint64_t tick = Now() * configTICK_RATE_HZ / 1000000000ULL;
+      return TickTime(tick + ticks) - Now();
+    }
+  }
+}
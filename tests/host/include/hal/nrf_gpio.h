@@ -0,0 +1,41 @@
+#pragma once
+
+#include "nrf.h"
+
+typedef enum { NRF_GPIO_PIN_NOPULL, NRF_GPIO_PIN_PULLDOWN, NRF_GPIO_PIN_PULLUP } nrf_gpio_pin_pull_t;
+
+namespace Pinetime {
+  namespace Host {
+    void SetPin(uint32_t pin, bool level);
+    bool GetPin(uint32_t pin);
+  }
+}
+
+inline void nrf_gpio_pin_set(uint32_t pin) {
+  Pinetime::Host::SetPin(pin, true);
+}
+
+inline void nrf_gpio_pin_clear(uint32_t pin) {
+  Pinetime::Host::SetPin(pin, false);
+}
+
+inline void nrf_gpio_pin_write(uint32_t pin, uint32_t value) {
+  Pinetime::Host::SetPin(pin, value != 0);
+}
+
+inline void nrf_gpio_pin_toggle(uint32_t pin) {
+  Pinetime::Host::SetPin(pin, !Pinetime::Host::GetPin(pin));
+}
+
+inline uint32_t nrf_gpio_pin_read(uint32_t pin) {
+  return Pinetime::Host::GetPin(pin) ? 1 : 0;
+}
+
+inline void nrf_gpio_cfg_output(uint32_t /*pin*/) {
+}
+
+inline void nrf_gpio_cfg_input(uint32_t /*pin*/, nrf_gpio_pin_pull_t /*pull*/) {
+}
+
+inline void nrf_gpio_cfg_default(uint32_t /*pin*/) {
+}
@@ -0,0 +1,11 @@
+#pragma once
+
+#include "Simulation.h"
+
+inline void nrf_delay_us(uint32_t us) {
+  Pinetime::Host::Busy(Pinetime::Host::Microseconds(us));
+}
+
+inline void nrf_delay_ms(uint32_t ms) {
+  Pinetime::Host::Busy(Pinetime::Host::Milliseconds(ms));
+}
@@ -0,0 +1,236 @@
+#pragma once
+
+// Host build: the subset of the LVGL v7 API used by the image decoder, the F: drive and LazyFont, with the configuration
+// of src/libs/lv_conf.h (16 bits colors, bytes swapped). Files go through the registered drivers like in LVGL,
+// and LVGL's built-in decoder is reproduced for raw image files (see Lvgl.cpp).
+#include <cstddef>
+#include <cstdint>
+
+#define LV_COLOR_DEPTH   16
+#define LV_COLOR_16_SWAP 1
+
+using lv_coord_t = int16_t;
+using lv_opa_t = uint8_t;
+
+using lv_res_t = uint8_t;
+
+enum {
+  LV_RES_INV = 0,
+  LV_RES_OK,
+};
+
+typedef union {
+  struct {
+    // LV_COLOR_16_SWAP
+    uint16_t green_h : 3;
+    uint16_t red : 5;
+    uint16_t blue : 5;
+    uint16_t green_l : 3;
+  } ch;
+
+  uint16_t full;
+} lv_color_t;
+
+typedef union {
+  struct {
+    uint8_t blue;
+    uint8_t green;
+    uint8_t red;
+    uint8_t alpha;
+  } ch;
+
+  uint32_t full;
+} lv_color32_t;
+
+lv_color_t lv_color_make(uint8_t r, uint8_t g, uint8_t b);
+
+void* lv_mem_alloc(size_t size);
+void lv_mem_free(const void* data);
+
+namespace Pinetime {
+  namespace Host {
+    // Bytes allocated with lv_mem_alloc() and not freed yet, and their maximum since the last ResetLvglHeapPeak()
+    size_t LvglHeapUsed();
+    size_t LvglHeapPeak();
+    void ResetLvglHeapPeak();
+  }
+}
+
+// File system
+using lv_fs_res_t = uint8_t;
+
+enum {
+  LV_FS_RES_OK = 0,
+  LV_FS_RES_HW_ERR,
+  LV_FS_RES_FS_ERR,
+  LV_FS_RES_NOT_EX,
+  LV_FS_RES_FULL,
+  LV_FS_RES_LOCKED,
+  LV_FS_RES_DENIED,
+  LV_FS_RES_BUSY,
+  LV_FS_RES_TOUT,
+  LV_FS_RES_NOT_IMP,
+  LV_FS_RES_OUT_OF_MEM,
+  LV_FS_RES_INV_PARAM,
+  LV_FS_RES_UNKNOWN,
+};
+
+using lv_fs_mode_t = uint8_t;
+
+enum {
+  LV_FS_MODE_WR = 0x01,
+  LV_FS_MODE_RD = 0x02,
+};
+
+typedef struct _lv_fs_drv_t {
+  char letter;
+  uint16_t file_size;
+  uint16_t rddir_size;
+  bool (*ready_cb)(struct _lv_fs_drv_t* drv);
+  lv_fs_res_t (*open_cb)(struct _lv_fs_drv_t* drv, void* file_p, const char* path, lv_fs_mode_t mode);
+  lv_fs_res_t (*close_cb)(struct _lv_fs_drv_t* drv, void* file_p);
+  lv_fs_res_t (*read_cb)(struct _lv_fs_drv_t* drv, void* file_p, void* buf, uint32_t btr, uint32_t* br);
+  lv_fs_res_t (*write_cb)(struct _lv_fs_drv_t* drv, void* file_p, const void* buf, uint32_t btw, uint32_t* bw);
+  lv_fs_res_t (*seek_cb)(struct _lv_fs_drv_t* drv, void* file_p, uint32_t pos);
+  lv_fs_res_t (*tell_cb)(struct _lv_fs_drv_t* drv, void* file_p, uint32_t* pos_p);
+  lv_fs_res_t (*trunc_cb)(struct _lv_fs_drv_t* drv, void* file_p);
+  lv_fs_res_t (*size_cb)(struct _lv_fs_drv_t* drv, void* file_p, uint32_t* size_p);
+  lv_fs_res_t (*rename_cb)(struct _lv_fs_drv_t* drv, const char* oldname, const char* newname);
+  lv_fs_res_t (*free_space_cb)(struct _lv_fs_drv_t* drv, uint32_t* total_p, uint32_t* free_p);
+  lv_fs_res_t (*dir_open_cb)(struct _lv_fs_drv_t* drv, void* rddir_p, const char* path);
+  lv_fs_res_t (*dir_read_cb)(struct _lv_fs_drv_t* drv, void* rddir_p, char* fn);
+  lv_fs_res_t (*dir_close_cb)(struct _lv_fs_drv_t* drv, void* rddir_p);
+  void* user_data;
+} lv_fs_drv_t;
+
+typedef struct {
+  void* file_d;
+  lv_fs_drv_t* drv;
+} lv_fs_file_t;
+
+typedef struct {
+  void* dir_d;
+  lv_fs_drv_t* drv;
+} lv_fs_dir_t;
+
+void lv_fs_drv_init(lv_fs_drv_t* drv);
+// Keeps a copy of the driver, like LVGL
+void lv_fs_drv_register(lv_fs_drv_t* drv);
+lv_fs_res_t lv_fs_open(lv_fs_file_t* file_p, const char* path, lv_fs_mode_t mode);
+lv_fs_res_t lv_fs_close(lv_fs_file_t* file_p);
+lv_fs_res_t lv_fs_read(lv_fs_file_t* file_p, void* buf, uint32_t btr, uint32_t* br);
+lv_fs_res_t lv_fs_seek(lv_fs_file_t* file_p, uint32_t pos);
+lv_fs_res_t lv_fs_tell(lv_fs_file_t* file_p, uint32_t* pos);
+lv_fs_res_t lv_fs_size(lv_fs_file_t* file_p, uint32_t* size);
+lv_fs_res_t lv_fs_dir_open(lv_fs_dir_t* rddir_p, const char* path);
+lv_fs_res_t lv_fs_dir_read(lv_fs_dir_t* rddir_p, char* fn);
+lv_fs_res_t lv_fs_dir_close(lv_fs_dir_t* rddir_p);
+
+// Images
+using lv_img_cf_t = uint8_t;
+
+enum {
+  LV_IMG_CF_UNKNOWN = 0,
+  LV_IMG_CF_RAW,
+  LV_IMG_CF_RAW_ALPHA,
+  LV_IMG_CF_RAW_CHROMA_KEYED,
+  LV_IMG_CF_TRUE_COLOR,
+  LV_IMG_CF_TRUE_COLOR_ALPHA,
+  LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED,
+  LV_IMG_CF_INDEXED_1BIT,
+  LV_IMG_CF_INDEXED_2BIT,
+  LV_IMG_CF_INDEXED_4BIT,
+  LV_IMG_CF_INDEXED_8BIT,
+  LV_IMG_CF_ALPHA_1BIT,
+  LV_IMG_CF_ALPHA_2BIT,
+  LV_IMG_CF_ALPHA_4BIT,
+  LV_IMG_CF_ALPHA_8BIT,
+  LV_IMG_CF_USER_ENCODED_0 = 24,
+};
+
+#define LV_IMG_PX_SIZE_ALPHA_BYTE 3
+
+typedef struct {
+  uint32_t cf : 5;
+  uint32_t always_zero : 3;
+  uint32_t reserved : 2;
+  uint32_t w : 11;
+  uint32_t h : 11;
+} lv_img_header_t;
+
+using lv_img_src_t = uint8_t;
+
+enum {
+  LV_IMG_SRC_VARIABLE,
+  LV_IMG_SRC_FILE,
+  LV_IMG_SRC_SYMBOL,
+  LV_IMG_SRC_UNKNOWN,
+};
+
+struct _lv_img_decoder;
+struct _lv_img_decoder_dsc;
+
+typedef lv_res_t (*lv_img_decoder_info_f_t)(struct _lv_img_decoder* decoder, const void* src, lv_img_header_t* header);
+typedef lv_res_t (*lv_img_decoder_open_f_t)(struct _lv_img_decoder* decoder, struct _lv_img_decoder_dsc* dsc);
+typedef lv_res_t (*lv_img_decoder_read_line_f_t)(
+  struct _lv_img_decoder* decoder, struct _lv_img_decoder_dsc* dsc, lv_coord_t x, lv_coord_t y, lv_coord_t len, uint8_t* buf);
+typedef void (*lv_img_decoder_close_f_t)(struct _lv_img_decoder* decoder, struct _lv_img_decoder_dsc* dsc);
+
+typedef struct _lv_img_decoder {
+  lv_img_decoder_info_f_t info_cb;
+  lv_img_decoder_open_f_t open_cb;
+  lv_img_decoder_read_line_f_t read_line_cb;
+  lv_img_decoder_close_f_t close_cb;
+  void* user_data;
+} lv_img_decoder_t;
+
+typedef struct _lv_img_decoder_dsc {
+  lv_img_decoder_t* decoder;
+  const void* src;
+  lv_color_t color;
+  lv_img_src_t src_type;
+  lv_img_header_t header;
+  const uint8_t* img_data;
+  uint32_t time_to_open;
+  const char* error_msg;
+  void* user_data;
+} lv_img_decoder_dsc_t;
+
+lv_img_src_t lv_img_src_get_type(const void* src);
+uint8_t lv_img_cf_get_px_size(lv_img_cf_t cf);
+
+// The last registered decoder is tried first, the built-in one last
+lv_img_decoder_t* lv_img_decoder_create();
+void lv_img_decoder_set_info_cb(lv_img_decoder_t* decoder, lv_img_decoder_info_f_t info_cb);
+void lv_img_decoder_set_open_cb(lv_img_decoder_t* decoder, lv_img_decoder_open_f_t open_cb);
+void lv_img_decoder_set_read_line_cb(lv_img_decoder_t* decoder, lv_img_decoder_read_line_f_t read_line_cb);
+void lv_img_decoder_set_close_cb(lv_img_decoder_t* decoder, lv_img_decoder_close_f_t close_cb);
+lv_res_t lv_img_decoder_get_info(const char* src, lv_img_header_t* header);
+lv_res_t lv_img_decoder_open(lv_img_decoder_dsc_t* dsc, const void* src, lv_color_t color);
+lv_res_t lv_img_decoder_read_line(lv_img_decoder_dsc_t* dsc, lv_coord_t x, lv_coord_t y, lv_coord_t len, uint8_t* buf);
+void lv_img_decoder_close(lv_img_decoder_dsc_t* dsc);
+
+// Fonts
+typedef struct {
+  uint16_t adv_w;
+  uint16_t box_w;
+  uint16_t box_h;
+  int16_t ofs_x;
+  int16_t ofs_y;
+  uint8_t bpp;
+} lv_font_glyph_dsc_t;
+
+typedef struct _lv_font_struct {
+  bool (*get_glyph_dsc)(const struct _lv_font_struct* font, lv_font_glyph_dsc_t* dsc, uint32_t letter, uint32_t letter_next);
+  const uint8_t* (*get_glyph_bitmap)(const struct _lv_font_struct* font, uint32_t letter);
+  lv_coord_t line_height;
+  lv_coord_t base_line;
+  uint8_t subpx : 2;
+  int8_t underline_position;
+  int8_t underline_thickness;
+  void* dsc;
+  void* user_data;
+} lv_font_t;
+
+bool lv_font_get_glyph_dsc(const lv_font_t* font_p, lv_font_glyph_dsc_t* dsc_out, uint32_t letter, uint32_t letter_next);
+const uint8_t* lv_font_get_glyph_bitmap(const lv_font_t* font_p, uint32_t letter);
@@ -0,0 +1,191 @@
+#pragma once
+
+// Host build: the registers of the nRF52832 peripherals used by the drivers. Their accesses go through the
+// models in Peripherals.h, which simulate the hardware.
+#include <cassert>
+#include <cstdint>
+
+namespace Pinetime {
+  namespace Host {
+    class Register {
+    public:
+      Register() = default;
+      Register(const Register&) = delete;
+
+      Register& operator=(uint32_t value);
+
+      Register& operator=(const Register& other) {
+        return *this = static_cast<uint32_t>(other);
+      }
+
+      operator uint32_t() const;
+
+      // Raw value, without going through the model
+      uint32_t value = 0;
+    };
+  }
+}
+
+using Pinetime::Host::Register;
+
+typedef struct {
+  Register SCK;
+  Register MOSI;
+  Register MISO;
+} SPIM_PSEL_Type;
+
+typedef struct {
+  Register PTR;
+  Register MAXCNT;
+  Register AMOUNT;
+  Register LIST;
+} SPIM_DMA_Type;
+
+typedef struct {
+  Register TASKS_START;
+  Register TASKS_STOP;
+  Register TASKS_SUSPEND;
+  Register TASKS_RESUME;
+  Register EVENTS_STOPPED;
+  Register EVENTS_ENDRX;
+  Register EVENTS_END;
+  Register EVENTS_ENDTX;
+  Register EVENTS_STARTED;
+  Register SHORTS;
+  Register INTENSET;
+  Register INTENCLR;
+  Register ENABLE;
+  SPIM_PSEL_Type PSEL;
+  SPIM_DMA_Type RXD;
+  SPIM_DMA_Type TXD;
+  Register FREQUENCY;
+  Register CONFIG;
+  Register ORC;
+} NRF_SPIM_Type;
+
+#define PSELSCK  PSEL.SCK
+#define PSELMOSI PSEL.MOSI
+#define PSELMISO PSEL.MISO
+
+typedef struct {
+  Register TASKS_START;
+  Register TASKS_STOP;
+  Register TASKS_COUNT;
+  Register TASKS_CLEAR;
+  Register TASKS_SHUTDOWN;
+  Register TASKS_CAPTURE[6];
+  Register EVENTS_COMPARE[6];
+  Register SHORTS;
+  Register INTENSET;
+  Register INTENCLR;
+  Register MODE;
+  Register BITMODE;
+  Register PRESCALER;
+  Register CC[6];
+} NRF_TIMER_Type;
+
+typedef struct {
+  Register EN;
+  Register DIS;
+} PPI_TASKS_CHG_Type;
+
+typedef struct {
+  Register EEP;
+  Register TEP;
+} PPI_CH_Type;
+
+typedef struct {
+  Register TEP;
+} PPI_FORK_Type;
+
+typedef struct {
+  PPI_TASKS_CHG_Type TASKS_CHG[6];
+  Register CHEN;
+  Register CHENSET;
+  Register CHENCLR;
+  PPI_CH_Type CH[20];
+  Register CHG[6];
+  PPI_FORK_Type FORK[32];
+} NRF_PPI_Type;
+
+typedef struct {
+  Register TASKS_OUT[8];
+  Register EVENTS_IN[8];
+} NRF_GPIOTE_Type;
+
+typedef struct {
+  Register CTRL;
+  Register CYCCNT;
+} DWT_Type;
+
+extern uint32_t SystemCoreClock;
+
+extern NRF_SPIM_Type nrfSpim0;
+extern NRF_SPIM_Type nrfSpim1;
+extern NRF_TIMER_Type nrfTimer2;
+extern NRF_TIMER_Type nrfTimer3;
+extern NRF_PPI_Type nrfPpi;
+extern NRF_GPIOTE_Type nrfGpiote;
+extern DWT_Type dwt;
+
+#define NRF_SPIM0  (&nrfSpim0)
+#define NRF_SPIM1  (&nrfSpim1)
+#define NRF_TIMER2 (&nrfTimer2)
+#define NRF_TIMER3 (&nrfTimer3)
+#define NRF_PPI    (&nrfPpi)
+#define NRF_GPIOTE (&nrfGpiote)
+#define DWT        (&dwt)
+
+typedef enum {
+  SPIM0_SPIS0_TWIM0_TWIS0_SPI0_TWI0_IRQn = 3,
+  SPIM1_SPIS1_TWIM1_TWIS1_SPI1_TWI1_IRQn = 4,
+  TIMER2_IRQn = 10,
+  TIMER3_IRQn = 26,
+} IRQn_Type;
+
+namespace Pinetime {
+  namespace Host {
+    void EnableInterrupt(int irq, bool enable);
+  }
+}
+
+#define NRFX_IRQ_PRIORITY_SET(irq, priority) (void) (priority)
+#define NRFX_IRQ_ENABLE(irq)                 Pinetime::Host::EnableInterrupt(irq, true)
+#define NRFX_IRQ_DISABLE(irq)                Pinetime::Host::EnableInterrupt(irq, false)
+
+#define ASSERT(expression)        assert(expression)
+// Evaluates error even without assertions, like the SDK
+#define APP_ERROR_CHECK(error)                                                                                                             \
+  do {                                                                                                                                     \
+    [[maybe_unused]] const auto appError = (error);                                                                                        \
+    assert(appError == 0);                                                                                                                 \
+  } while (0)
+#define NRF_SUCCESS               0
+
+#define SPIM_ENABLE_ENABLE_Pos      0
+#define SPIM_ENABLE_ENABLE_Disabled 0
+#define SPIM_ENABLE_ENABLE_Enabled  7
+
+#define SPIM_FREQUENCY_FREQUENCY_K125 0x02000000UL
+#define SPIM_FREQUENCY_FREQUENCY_K250 0x04000000UL
+#define SPIM_FREQUENCY_FREQUENCY_K500 0x08000000UL
+#define SPIM_FREQUENCY_FREQUENCY_M1   0x10000000UL
+#define SPIM_FREQUENCY_FREQUENCY_M2   0x20000000UL
+#define SPIM_FREQUENCY_FREQUENCY_M4   0x40000000UL
+#define SPIM_FREQUENCY_FREQUENCY_M8   0x80000000UL
+
+#define SPIM_TXD_LIST_LIST_Pos       0
+#define SPIM_TXD_LIST_LIST_Disabled  0
+#define SPIM_TXD_LIST_LIST_ArrayList 1
+#define SPIM_RXD_LIST_LIST_Pos       0
+#define SPIM_RXD_LIST_LIST_ArrayList 1
+
+#define TIMER_MODE_MODE_Timer           0
+#define TIMER_MODE_MODE_Counter         1
+#define TIMER_MODE_MODE_LowPowerCounter 2
+#define TIMER_BITMODE_BITMODE_16Bit     0
+#define TIMER_BITMODE_BITMODE_32Bit     3
+#define TIMER_INTENSET_COMPARE0_Msk     (1UL << 16)
+#define TIMER_INTENSET_COMPARE1_Msk     (1UL << 17)
+#define TIMER_INTENCLR_COMPARE0_Msk     (1UL << 16)
+#define TIMER_INTENCLR_COMPARE1_Msk     (1UL << 17)
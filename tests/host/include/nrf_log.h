@@ -0,0 +1,6 @@
+#pragma once
+
+#define NRF_LOG_INFO(...)
+#define NRF_LOG_DEBUG(...)
+#define NRF_LOG_WARNING(...)
+#define NRF_LOG_ERROR(...)
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "nrf.h"
+
+typedef enum {
+  NRF_PPI_CHANNEL0 = 0,
+  NRF_PPI_CHANNEL1,
+  NRF_PPI_CHANNEL2,
+  NRF_PPI_CHANNEL3,
+  NRF_PPI_CHANNEL4,
+  NRF_PPI_CHANNEL5,
+  NRF_PPI_CHANNEL6,
+  NRF_PPI_CHANNEL7,
+  NRF_PPI_CHANNEL8,
+  NRF_PPI_CHANNEL9,
+  NRF_PPI_CHANNEL10,
+  NRF_PPI_CHANNEL11,
+  NRF_PPI_CHANNEL12,
+  NRF_PPI_CHANNEL13,
+  NRF_PPI_CHANNEL14,
+  NRF_PPI_CHANNEL15,
+  NRF_PPI_CHANNEL16,
+  NRF_PPI_CHANNEL17,
+  NRF_PPI_CHANNEL18,
+  NRF_PPI_CHANNEL19,
+} nrf_ppi_channel_t;
+
+typedef enum {
+  NRF_PPI_CHANNEL_GROUP0 = 0,
+  NRF_PPI_CHANNEL_GROUP1,
+  NRF_PPI_CHANNEL_GROUP2,
+  NRF_PPI_CHANNEL_GROUP3,
+  NRF_PPI_CHANNEL_GROUP4,
+  NRF_PPI_CHANNEL_GROUP5,
+} nrf_ppi_channel_group_t;
+
+inline void nrf_ppi_channel_enable(nrf_ppi_channel_t channel) {
+  NRF_PPI->CHENSET = 1UL << channel;
+}
+
+inline void nrf_ppi_channel_disable(nrf_ppi_channel_t channel) {
+  NRF_PPI->CHENCLR = 1UL << channel;
+}
+
+inline void nrf_ppi_channel_endpoint_setup(nrf_ppi_channel_t channel, uint32_t eep, uint32_t tep) {
+  NRF_PPI->CH[channel].EEP = eep;
+  NRF_PPI->CH[channel].TEP = tep;
+}
+
+inline void nrf_ppi_fork_endpoint_setup(nrf_ppi_channel_t channel, uint32_t forkTep) {
+  NRF_PPI->FORK[channel].TEP = forkTep;
+}
+
+inline void nrf_ppi_channel_and_fork_endpoint_setup(nrf_ppi_channel_t channel, uint32_t eep, uint32_t tep, uint32_t forkTep) {
+  nrf_ppi_channel_endpoint_setup(channel, eep, tep);
+  nrf_ppi_fork_endpoint_setup(channel, forkTep);
+}
+
+inline void nrf_ppi_channel_include_in_group(nrf_ppi_channel_t channel, nrf_ppi_channel_group_t group) {
+  NRF_PPI->CHG[group] = NRF_PPI->CHG[group] | (1UL << channel);
+}
+
+inline void nrf_ppi_group_enable(nrf_ppi_channel_group_t group) {
+  NRF_PPI->TASKS_CHG[group].EN = 1;
+}
+
+inline void nrf_ppi_group_disable(nrf_ppi_channel_group_t group) {
+  NRF_PPI->TASKS_CHG[group].DIS = 1;
+}
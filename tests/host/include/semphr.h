@@ -0,0 +1,41 @@
+#pragma once
+
+#include "FreeRTOS.h"
+
+using SemaphoreHandle_t = Pinetime::Host::Semaphore*;
+
+inline SemaphoreHandle_t xSemaphoreCreateBinary() {
+  return Pinetime::Host::CreateSemaphore(0, 1);
+}
+
+// No priority inheritance
+inline SemaphoreHandle_t xSemaphoreCreateMutex() {
+  return Pinetime::Host::CreateSemaphore(1, 1);
+}
+
+inline SemaphoreHandle_t xSemaphoreCreateCounting(UBaseType_t maxCount, UBaseType_t initialCount) {
+  return Pinetime::Host::CreateSemaphore(initialCount, maxCount);
+}
+
+inline void vSemaphoreDelete(SemaphoreHandle_t semaphore) {
+  Pinetime::Host::DeleteSemaphore(semaphore);
+}
+
+inline BaseType_t xSemaphoreTake(SemaphoreHandle_t semaphore, TickType_t ticks) {
+  return Pinetime::Host::Take(semaphore, ticks == 0 ? 0 : Pinetime::Host::Timeout(ticks)) ? pdTRUE : pdFALSE;
+}
+
+inline BaseType_t xSemaphoreGive(SemaphoreHandle_t semaphore) {
+  const bool given = Pinetime::Host::Give(semaphore, nullptr);
+  Pinetime::Host::Reschedule();
+  return given ? pdTRUE : pdFALSE;
+}
+
+inline BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t semaphore, BaseType_t* higherPriorityTaskWoken) {
+  Pinetime::Host::Task* woken = nullptr;
+  const bool given = Pinetime::Host::Give(semaphore, &woken);
+  if (woken != nullptr && higherPriorityTaskWoken != nullptr) {
+    *higherPriorityTaskWoken = pdTRUE;
+  }
+  return given ? pdTRUE : pdFALSE;
+}
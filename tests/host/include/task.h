@@ -0,0 +1,57 @@
+#pragma once
+
+#include "FreeRTOS.h"
+
+using TaskHandle_t = Pinetime::Host::Task*;
+using TaskFunction_t = void (*)(void*);
+
+inline BaseType_t xTaskCreate(TaskFunction_t function,
+                              const char* name,
+                              uint16_t /*stackDepth*/,
+                              void* parameters,
+                              UBaseType_t priority,
+                              TaskHandle_t* createdTask) {
+  TaskHandle_t task = Pinetime::Host::Spawn(name, priority, [function, parameters]() {
+    function(parameters);
+  });
+  if (createdTask != nullptr) {
+    *createdTask = task;
+  }
+  return pdPASS;
+}
+
+inline TickType_t xTaskGetTickCount() {
+  return Pinetime::Host::CurrentTick();
+}
+
+inline TickType_t xTaskGetTickCountFromISR() {
+  return Pinetime::Host::CurrentTick();
+}
+
+inline void vTaskDelay(TickType_t ticks) {
+  Pinetime::Host::Delay(ticks == 0 ? 0 : Pinetime::Host::Timeout(ticks));
+}
+
+inline TaskHandle_t xTaskGetCurrentTaskHandle() {
+  return Pinetime::Host::CurrentTask();
+}
+
+inline uint32_t ulTaskNotifyTake(BaseType_t clearCountOnExit, TickType_t ticks) {
+  return Pinetime::Host::NotifyTake(clearCountOnExit != pdFALSE, ticks == 0 ? 0 : Pinetime::Host::Timeout(ticks));
+}
+
+inline BaseType_t xTaskNotifyGive(TaskHandle_t task) {
+  Pinetime::Host::NotifyGive(task, nullptr);
+  Pinetime::Host::Reschedule();
+  return pdPASS;
+}
+
+inline void vTaskNotifyGiveFromISR(TaskHandle_t task, BaseType_t* higherPriorityTaskWoken) {
+  Pinetime::Host::Task* woken = nullptr;
+  Pinetime::Host::NotifyGive(task, &woken);
+  if (woken != nullptr && higherPriorityTaskWoken != nullptr) {
+    *higherPriorityTaskWoken = pdTRUE;
+  }
+}
+
+#define taskYIELD() portYIELD()
@@ -0,0 +1,108 @@
+// Hand end points of the analog watch face: the Q15 table of utility/Trigonometry.h against float sinf()/cosf(),
+// and against the previous code, which truncated radius * _lv_trigo_sin(angle) / 32767. Checks the table against
+// std::sin() and reports the pixel errors and the host CPU time per end point.
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include "Check.h"
+#include "utility/Math.h"
+#include "utility/Trigonometry.h"
+
+using namespace Pinetime::Host;
+using namespace Pinetime::Utility;
+
+namespace {
+  constexpr int32_t radii[] = {60, 90, 110};
+  constexpr int repetitions = 2000;
+
+  struct Point {
+    int32_t x;
+    int32_t y;
+  };
+
+  Point Q15(int32_t radius, int32_t angle) {
+    return {MultiplyQ15(radius, Sine(angle)), MultiplyQ15(radius, Cosine(angle))};
+  }
+
+  // _lv_trigo_sin() is a quarter wave table of sin * 32767 too, the face divided and truncated
+  Point Truncated(int32_t radius, int32_t angle) {
+    return {radius * Sine(angle) / Q15One, radius * Cosine(angle) / Q15One};
+  }
+
+  Point Float(int32_t radius, int32_t angle) {
+    const float radians = static_cast<float>(angle) * std::numbers::pi_v<float> / 180;
+    return {static_cast<int32_t>(std::lround(static_cast<float>(radius) * std::sin(radians))),
+            static_cast<int32_t>(std::lround(static_cast<float>(radius) * std::cos(radians)))};
+  }
+
+  Point Exact(int32_t radius, int32_t angle) {
+    const double radians = angle * std::numbers::pi / 180;
+    return {static_cast<int32_t>(std::lround(radius * std::sin(radians))), static_cast<int32_t>(std::lround(radius * std::cos(radians)))};
+  }
+
+  // Points that differ from the exact rounding, over all the angles of the 3 hands
+  template <class Function>
+  int Errors(Function function) {
+    int errors = 0;
+    for (int32_t radius : radii) {
+      for (int32_t angle = 0; angle < 360; angle++) {
+        const Point point = function(radius, angle);
+        const Point exact = Exact(radius, angle);
+        errors += (point.x != exact.x) + (point.y != exact.y);
+      }
+    }
+    return errors;
+  }
+
+  // Host CPU time per end point, in ns
+  template <class Function>
+  double Time(Function function) {
+    // The angles are read through a volatile so that nothing is computed at compile time
+    volatile int32_t offset = 0;
+    int64_t sum = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < repetitions; i++) {
+      for (int32_t radius : radii) {
+        for (int32_t angle = 0; angle < 360; angle++) {
+          const Point point = function(radius, angle + offset);
+          sum += point.x + point.y;
+        }
+      }
+    }
+    const auto duration = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start);
+    offset = static_cast<int32_t>(sum);
+    return duration.count() / (repetitions * 3 * 360);
+  }
+
+  template <class Function>
+  void Report(const char* name, Function function) {
+    std::printf("%-10s %4d wrong coordinates of 2160, %5.1f ns per end point\n", name, Errors(function), Time(function));
+  }
+}
+
+int main() {
+  // sin(30) * 32767 is halfway between 2 integers, the table rounds it away from zero
+  auto q15 = [](double value) {
+    return static_cast<int32_t>(std::copysign(std::floor((std::abs(value) * Q15One) + 0.5 + 1e-9), value));
+  };
+  for (int32_t angle = -720; angle <= 720; angle++) {
+    const double radians = angle * std::numbers::pi / 180;
+    CHECK_EQUAL(q15(std::sin(radians)), Sine(angle));
+    CHECK_EQUAL(q15(std::cos(radians)), Cosine(angle));
+  }
+  for (int32_t value = -300; value <= 300; value++) {
+    for (int16_t factor : {Q15One, int16_t {16384}, int16_t {-16384}, int16_t {12345}, int16_t {-32767}}) {
+      CHECK_EQUAL(RoundedDiv<int32_t>(value * factor, 32768), MultiplyQ15(value, factor));
+    }
+  }
+  for (double x = -7; x < 7; x += 0.01) {
+    CHECK(std::abs(SineRadians(x) - std::sin(x)) < 1e-12);
+  }
+
+  Report("q15", Q15);
+  Report("truncated", Truncated);
+  Report("float", Float);
+
+  CHECK_EQUAL(0, Errors(Q15));
+  return Failures() != 0;
+}